@@ -0,0 +1,304 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+// Global allocations, counted by the replacement operator new below and
+// reported per operation.
+static std::atomic<long> allocations{0};
+
+void *operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  std::size_t a = static_cast<std::size_t>(alignment);
+  if (void *p = std::aligned_alloc(a, (size + a - 1) / a * a)) return p;
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return operator new(size, alignment);
+}
+
+// Kept out of line so that GCC does not pair an inlined free() with the
+// operator new above and warn about a mismatch.
+__attribute__((noinline)) static void Release(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p) noexcept { Release(p); }
+void operator delete(void *p, std::size_t) noexcept { Release(p); }
+void operator delete(void *p, std::align_val_t) noexcept { Release(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+  Release(p);
+}
+void operator delete[](void *p) noexcept { Release(p); }
+void operator delete[](void *p, std::size_t) noexcept { Release(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { Release(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept {
+  Release(p);
+}
+
+namespace {
+
+constexpr double kBytes = sizeof(double);
+
+// Well-conditioned test matrix: a bounded pattern plus a dominant
+// diagonal, so inverses and determinants stay finite at every size.
+S21Matrix Pattern(int rows, int cols, int seed) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      m(i, j) = ((i * 7 + j * 13 + seed) % 17) / 8.0 - 1.0;
+    }
+    if (i < cols) m(i, i) += cols;
+  }
+  return m;
+}
+
+// Records flop and byte rates and allocations per operation. flops and
+// bytes are per iteration; the rate flag divides them by the time, so the
+// report shows e.g. "bytes=4.2G/s". Construct it right before the timed
+// loop and call Finish right after it: only allocations in between count,
+// not the framework's own when Finish registers the counters.
+class Counters {
+ public:
+  explicit Counters(benchmark::State &state)
+      : state_(state), start_(allocations.load()) {}
+  void Finish(double flops, double bytes) {
+    const long allocs = allocations.load() - start_;
+    using benchmark::Counter;
+    if (flops > 0) {
+      state_.counters["flops"] =
+          Counter(flops, Counter::kIsIterationInvariantRate);
+    }
+    state_.counters["bytes"] =
+        Counter(bytes, Counter::kIsIterationInvariantRate);
+    state_.counters["allocs/op"] =
+        Counter(static_cast<double>(allocs), Counter::kAvgIterations);
+  }
+
+ private:
+  benchmark::State &state_;
+  long start_;
+};
+
+void Construct(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  Counters counters(state);
+  for (auto _ : state) {
+    S21Matrix m(rows, cols);
+    benchmark::DoNotOptimize(m.Data());
+  }
+  counters.Finish(0, kBytes * rows * cols);
+}
+
+void Copy(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  S21Matrix a = Pattern(rows, cols, 1);
+  Counters counters(state);
+  for (auto _ : state) {
+    S21Matrix m(a);
+    benchmark::DoNotOptimize(m.Data());
+  }
+  counters.Finish(0, 2 * kBytes * rows * cols);
+}
+
+void Move(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  S21Matrix a = Pattern(rows, cols, 1);
+  Counters counters(state);
+  for (auto _ : state) {
+    S21Matrix m(std::move(a));
+    a = std::move(m);
+    benchmark::DoNotOptimize(a.Data());
+  }
+  counters.Finish(0, 0);
+}
+
+void SumMatrix(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  S21Matrix a = Pattern(rows, cols, 1), b = Pattern(rows, cols, 2);
+  Counters counters(state);
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::ClobberMemory();
+  }
+  counters.Finish(double(rows) * cols, 3 * kBytes * rows * cols);
+}
+
+void SubMatrix(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  S21Matrix a = Pattern(rows, cols, 1), b = Pattern(rows, cols, 2);
+  Counters counters(state);
+  for (auto _ : state) {
+    a.SubMatrix(b);
+    benchmark::ClobberMemory();
+  }
+  counters.Finish(double(rows) * cols, 3 * kBytes * rows * cols);
+}
+
+void MulNumber(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  S21Matrix a = Pattern(rows, cols, 1);
+  Counters counters(state);
+  for (auto _ : state) {
+    a.MulNumber(1.0);
+    benchmark::ClobberMemory();
+  }
+  counters.Finish(double(rows) * cols, 2 * kBytes * rows * cols);
+}
+
+void EqMatrix(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  S21Matrix a = Pattern(rows, cols, 1), b = a;
+  Counters counters(state);
+  for (auto _ : state) benchmark::DoNotOptimize(a.EqMatrix(b));
+  counters.Finish(0, 2 * kBytes * rows * cols);
+}
+
+void Transpose(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  S21Matrix a = Pattern(rows, cols, 1);
+  Counters counters(state);
+  for (auto _ : state) {
+    S21Matrix t = a.Transpose();
+    benchmark::DoNotOptimize(t.Data());
+  }
+  counters.Finish(0, 2 * kBytes * rows * cols);
+}
+
+void TransposeInPlace(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  S21Matrix a = Pattern(rows, cols, 1);
+  Counters counters(state);
+  for (auto _ : state) {
+    a.TransposeInPlace();
+    benchmark::DoNotOptimize(a.Data());
+  }
+  counters.Finish(0, 2 * kBytes * rows * cols);
+}
+
+// (m x k) * (k x n) with shape (m, k, n).
+void MulMatrix(benchmark::State &state) {
+  const int m = state.range(0), k = state.range(1), n = state.range(2);
+  S21Matrix a = Pattern(m, k, 1), b = Pattern(k, n, 2);
+  Counters counters(state);
+  for (auto _ : state) {
+    S21Matrix c = a;
+    c.MulMatrix(b);
+    benchmark::DoNotOptimize(c.Data());
+  }
+  counters.Finish(2.0 * m * n * k, kBytes * (2.0 * m * k + k * n + m * n));
+}
+
+void Determinant(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Pattern(n, n, 1);
+  Counters counters(state);
+  for (auto _ : state) benchmark::DoNotOptimize(a.Determinant());
+  counters.Finish(2.0 / 3.0 * n * n * n, kBytes * n * n);
+}
+
+void InverseMatrix(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Pattern(n, n, 1);
+  Counters counters(state);
+  for (auto _ : state) {
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.Data());
+  }
+  counters.Finish(2.0 * n * n * n, 2 * kBytes * n * n);
+}
+
+void CalcComplements(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Pattern(n, n, 1);
+  Counters counters(state);
+  for (auto _ : state) {
+    S21Matrix complements = a.CalcComplements();
+    benchmark::DoNotOptimize(complements.Data());
+  }
+  counters.Finish(8.0 / 3.0 * n * n * n, 2 * kBytes * n * n);
+}
+
+// Alternates between n and n + 1 rows (or columns), so every iteration
+// reallocates and copies.
+void SetRows(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Pattern(n, n, 1);
+  bool grow = true;
+  Counters counters(state);
+  for (auto _ : state) {
+    a.SetRows(grow ? n + 1 : n);
+    grow = !grow;
+  }
+  counters.Finish(0, 2 * kBytes * n * n);
+}
+
+void SetCols(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Pattern(n, n, 1);
+  bool grow = true;
+  Counters counters(state);
+  for (auto _ : state) {
+    a.SetCols(grow ? n + 1 : n);
+    grow = !grow;
+  }
+  counters.Finish(0, 2 * kBytes * n * n);
+}
+
+constexpr int kMaxSize = 4096;
+
+// Square sizes 1, 2, 3 and the powers of four up to kMaxSize.
+void SquareSizes(benchmark::internal::Benchmark *b) {
+  b->Arg(1)->Arg(2)->Arg(3);
+  for (int n = 4; n <= kMaxSize; n *= 4) b->Arg(n);
+}
+
+// Square shapes plus 16-row wide and 16-column tall ones, for the
+// element-wise operations and transposes.
+void Shapes(benchmark::internal::Benchmark *b) {
+  for (int n = 1; n <= kMaxSize; n *= 4) b->Args({n, n});
+  for (int n = 64; n <= kMaxSize; n *= 4) b->Args({16, n})->Args({n, 16});
+}
+
+// Square products, outer-product-like (n x 64) * (64 x n) and
+// inner-product-like (64 x n) * (n x 64).
+void ProductShapes(benchmark::internal::Benchmark *b) {
+  for (int n = 1; n <= kMaxSize; n *= 4) b->Args({n, n, n});
+  for (int n = 256; n <= kMaxSize; n *= 4) {
+    b->Args({n, 64, n})->Args({64, n, 64});
+  }
+}
+
+}  // namespace
+
+BENCHMARK(Construct)->Apply(Shapes);
+BENCHMARK(Copy)->Apply(Shapes);
+BENCHMARK(Move)->Apply(Shapes);
+BENCHMARK(SumMatrix)->Apply(Shapes);
+BENCHMARK(SubMatrix)->Apply(Shapes);
+BENCHMARK(MulNumber)->Apply(Shapes);
+BENCHMARK(EqMatrix)->Apply(Shapes);
+BENCHMARK(Transpose)->Apply(Shapes);
+BENCHMARK(TransposeInPlace)->Apply(Shapes);
+BENCHMARK(MulMatrix)->Apply(ProductShapes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Determinant)->Apply(SquareSizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(InverseMatrix)->Apply(SquareSizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(CalcComplements)
+    ->Apply(SquareSizes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(SetRows)->Apply(SquareSizes);
+BENCHMARK(SetCols)->Apply(SquareSizes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""Compares two Google Benchmark JSON files and flags slowdowns.
+
+Usage: bench_compare.py BASELINE CURRENT [--threshold 0.05]
+                        [--metric cpu_time|real_time]
+
+Benchmarks are matched by name; with repetitions the median aggregate is
+used. Prints one line per benchmark and exits with status 1 if any of
+them got slower than the threshold allows.
+"""
+
+import argparse
+import json
+import sys
+
+UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def load(path, metric):
+    with open(path) as f:
+        runs = json.load(f)["benchmarks"]
+    times = {}
+    medians = {}
+    for run in runs:
+        seconds = run[metric] * UNITS[run.get("time_unit", "ns")]
+        if run.get("run_type") == "aggregate":
+            if run.get("aggregate_name") == "median":
+                medians[run["run_name"]] = seconds
+        else:
+            times.setdefault(run.get("run_name", run["name"]), seconds)
+    times.update(medians)
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="allowed relative slowdown (default 0.05)")
+    parser.add_argument("--metric", default="cpu_time",
+                        choices=["cpu_time", "real_time"])
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    current = load(args.current, args.metric)
+    slower = []
+    for name, before in baseline.items():
+        if name not in current:
+            print(f"{name:<50} missing")
+            continue
+        after = current[name]
+        change = after / before - 1.0 if before > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  SLOWER"
+            slower.append(name)
+        print(f"{name:<50} {before:12.4g}s {after:12.4g}s "
+              f"{change:+8.1%}{flag}")
+    for name in sorted(set(current) - set(baseline)):
+        print(f"{name:<50} new")
+
+    if slower:
+        print(f"\n{len(slower)} of {len(baseline)} benchmarks slower than "
+              f"{args.threshold:.0%}", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,90 @@
+#include "s21_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace s21 {
+
+namespace {
+
+char *AlignUp(char *p, std::size_t alignment) {
+  auto address = reinterpret_cast<std::uintptr_t>(p);
+  return p + ((alignment - address % alignment) % alignment);
+}
+
+}  // namespace
+
+Arena::Arena(std::size_t chunk_size, std::pmr::memory_resource *upstream)
+    : upstream_(upstream), chunk_size_(std::max<std::size_t>(chunk_size, 1)) {}
+
+Arena::~Arena() { ReleaseChunks(); }
+
+void Arena::Reset() {
+  if (chunks_.size() > 1) {
+    std::size_t total = 0;
+    for (const Chunk &chunk : chunks_) total += chunk.size;
+    ReleaseChunks();
+    AddChunk(total);
+  }
+  if (!chunks_.empty()) {
+    cursor_ = chunks_.back().data;
+    end_ = cursor_ + chunks_.back().size;
+  }
+  retired_ = 0;
+}
+
+std::size_t Arena::Used() const noexcept {
+  if (chunks_.empty()) return 0;
+  return retired_ + static_cast<std::size_t>(cursor_ - chunks_.back().data);
+}
+
+std::size_t Arena::Capacity() const noexcept {
+  std::size_t total = 0;
+  for (const Chunk &chunk : chunks_) total += chunk.size;
+  return total;
+}
+
+void *Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+  char *p = cursor_ != nullptr ? AlignUp(cursor_, alignment) : nullptr;
+  if (p == nullptr || bytes > static_cast<std::size_t>(end_ - p)) {
+    if (!chunks_.empty()) {
+      retired_ += static_cast<std::size_t>(cursor_ - chunks_.back().data);
+    }
+    std::size_t size = std::max(chunk_size_, bytes + alignment);
+    if (!chunks_.empty()) size = std::max(size, 2 * chunks_.back().size);
+    AddChunk(size);
+    p = AlignUp(cursor_, alignment);
+  }
+  cursor_ = p + bytes;
+  return p;
+}
+
+void Arena::do_deallocate(void *p, std::size_t bytes, std::size_t) {
+  // Only the last block can go back; the rest waits for Reset.
+  char *block = static_cast<char *>(p);
+  if (block + bytes == cursor_) cursor_ = block;
+}
+
+bool Arena::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept {
+  return this == &other;
+}
+
+void Arena::AddChunk(std::size_t size) {
+  chunks_.reserve(chunks_.size() + 1);
+  char *data = static_cast<char *>(upstream_->allocate(size, kChunkAlignment));
+  chunks_.push_back({data, size});
+  cursor_ = data;
+  end_ = data + size;
+}
+
+void Arena::ReleaseChunks() noexcept {
+  for (const Chunk &chunk : chunks_) {
+    upstream_->deallocate(chunk.data, chunk.size, kChunkAlignment);
+  }
+  chunks_.clear();
+  cursor_ = nullptr;
+  end_ = nullptr;
+}
+
+}  // namespace s21
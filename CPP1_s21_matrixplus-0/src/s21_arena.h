@@ -0,0 +1,64 @@
+#ifndef SRC_S21_ARENA_H_
+#define SRC_S21_ARENA_H_
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace s21 {
+
+// Bump-pointer memory resource for short-lived matrices. Allocation moves
+// a cursor through a chunk taken from the upstream resource; deallocation
+// is a no-op except for the most recent block, which is handed back so
+// that temporaries freed in LIFO order are reused at once. Reset releases
+// everything in one step.
+//
+// Reset keeps the memory: if the cycle spilled into several chunks they
+// are merged into one chunk of their combined size, so a loop that
+// allocates the same amount each cycle stops calling upstream after the
+// first one. Not thread-safe; use one arena per thread or per request.
+class Arena : public std::pmr::memory_resource {
+ public:
+  static constexpr std::size_t kDefaultChunkSize = std::size_t(1) << 16;
+
+  explicit Arena(
+      std::size_t chunk_size = kDefaultChunkSize,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+  ~Arena() override;
+
+  // Invalidates every block handed out since the last reset.
+  void Reset();
+  // Bytes handed out since the last reset, alignment padding included.
+  std::size_t Used() const noexcept;
+  // Bytes held from upstream.
+  std::size_t Capacity() const noexcept;
+
+ private:
+  struct Chunk {
+    char *data;
+    std::size_t size;
+  };
+  static constexpr std::size_t kChunkAlignment = 64;
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override;
+  void AddChunk(std::size_t size);
+  void ReleaseChunks() noexcept;
+
+  std::pmr::memory_resource *upstream_;
+  std::size_t chunk_size_;
+  std::vector<Chunk> chunks_;
+  char *cursor_ = nullptr;
+  char *end_ = nullptr;
+  // Bytes used in all chunks but the last.
+  std::size_t retired_ = 0;
+};
+
+}  // namespace s21
+
+#endif
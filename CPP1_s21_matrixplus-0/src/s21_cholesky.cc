@@ -0,0 +1,154 @@
+#include "s21_cholesky.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "s21_gemm.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr int kCholeskyUpdateBlock = 128;
+
+// Unblocked Cholesky of the kb x kb diagonal block at (k0, k0), whose
+// trailing updates from earlier panels are already applied.
+template <class T>
+int FactorDiagonal(int k0, int kb, T *a, std::ptrdiff_t lda) noexcept {
+  for (int j = k0; j < k0 + kb; ++j) {
+    T *row_j = a + j * lda;
+    T d = row_j[j];
+    for (int p = k0; p < j; ++p) d -= row_j[p] * row_j[p];
+    if (!(d > T(0))) return j + 1;
+    d = std::sqrt(d);
+    row_j[j] = d;
+    const T inv = T(1) / d;
+    for (int i = j + 1; i < k0 + kb; ++i) {
+      T *row_i = a + i * lda;
+      T s = row_i[j];
+      for (int p = k0; p < j; ++p) s -= row_i[p] * row_j[p];
+      row_i[j] = s * inv;
+    }
+  }
+  return 0;
+}
+
+// L21 = A21 * L11^-T for the rows [k0 + kb, n) of the panel columns: each
+// row is a forward substitution against the rows of L11, so every inner
+// product runs along two contiguous rows.
+template <class T>
+void SolvePanel(int n, int k0, int kb, T *a, std::ptrdiff_t lda) noexcept {
+  const int k1 = k0 + kb;
+  for (int i = k1; i < n; ++i) {
+    T *row_i = a + i * lda;
+    for (int j = k0; j < k1; ++j) {
+      const T *row_j = a + j * lda;
+      T s = row_i[j];
+      for (int p = k0; p < j; ++p) s -= row_i[p] * row_j[p];
+      row_i[j] = s / row_j[j];
+    }
+  }
+}
+
+// A22 -= L21 * L21^T on the lower triangle only: one Gemm per block
+// column, each from its diagonal block down, so the strict upper blocks
+// are skipped and about half the flops of a full update are spent. The
+// block columns are wider than a panel because the extra work above the
+// diagonal costs less than running Gemm on narrow blocks.
+template <class T>
+void UpdateTrailing(int n, int k0, int kb, T *a, std::ptrdiff_t lda) {
+  for (int j0 = k0 + kb; j0 < n; j0 += kCholeskyUpdateBlock) {
+    const int jb = std::min(kCholeskyUpdateBlock, n - j0);
+    // (L21^T)(p, j) = a[j * lda + p], a transposed operand for Gemm.
+    Gemm(n - j0, jb, kb, -1.0, a + j0 * lda + k0, lda, 1, a + j0 * lda + k0,
+         1, lda, 1.0, a + j0 * lda + j0, lda);
+  }
+}
+
+// Solves L * X = B in place.
+template <class T>
+void SolveLower(int n, int nrhs, const T *l, std::ptrdiff_t lda, T *b,
+                std::ptrdiff_t ldb) {
+  for (int i0 = 0; i0 < n; i0 += kCholeskyBlock) {
+    const int i1 = std::min(n, i0 + kCholeskyBlock);
+    if (i0 > 0) {
+      Gemm(i1 - i0, nrhs, i0, -1.0, l + i0 * lda, lda, b, ldb, 1.0,
+           b + i0 * ldb, ldb);
+    }
+    for (int i = i0; i < i1; ++i) {
+      T *row_i = b + i * ldb;
+      for (int p = i0; p < i; ++p) {
+        const T f = l[i * lda + p];
+        const T *row_p = b + p * ldb;
+        for (int j = 0; j < nrhs; ++j) row_i[j] -= f * row_p[j];
+      }
+      const T inv = T(1) / l[i * lda + i];
+      for (int j = 0; j < nrhs; ++j) row_i[j] *= inv;
+    }
+  }
+}
+
+// Solves L^T * X = B in place; L^T is read through transposed strides.
+template <class T>
+void SolveUpper(int n, int nrhs, const T *l, std::ptrdiff_t lda, T *b,
+                std::ptrdiff_t ldb) {
+  for (int i0 = (n - 1) / kCholeskyBlock * kCholeskyBlock; i0 >= 0;
+       i0 -= kCholeskyBlock) {
+    const int i1 = std::min(n, i0 + kCholeskyBlock);
+    if (i1 < n) {
+      Gemm(i1 - i0, nrhs, n - i1, -1.0, l + i1 * lda + i0, 1, lda,
+           b + i1 * ldb, ldb, 1, 1.0, b + i0 * ldb, ldb);
+    }
+    for (int i = i1 - 1; i >= i0; --i) {
+      T *row_i = b + i * ldb;
+      for (int p = i + 1; p < i1; ++p) {
+        const T f = l[p * lda + i];
+        const T *row_p = b + p * ldb;
+        for (int j = 0; j < nrhs; ++j) row_i[j] -= f * row_p[j];
+      }
+      const T inv = T(1) / l[i * lda + i];
+      for (int j = 0; j < nrhs; ++j) row_i[j] *= inv;
+    }
+  }
+}
+
+}  // namespace
+
+template <class T>
+int CholeskyFactor(int n, T *a, std::ptrdiff_t lda) {
+  for (int k0 = 0; k0 < n; k0 += kCholeskyBlock) {
+    const int kb = std::min(kCholeskyBlock, n - k0);
+    if (int info = FactorDiagonal(k0, kb, a, lda)) return info;
+    if (k0 + kb < n) {
+      SolvePanel(n, k0, kb, a, lda);
+      UpdateTrailing(n, k0, kb, a, lda);
+    }
+  }
+  return 0;
+}
+
+template <class T>
+void CholeskySolve(int n, int nrhs, const T *l, std::ptrdiff_t lda, T *b,
+                   std::ptrdiff_t ldb) {
+  SolveLower(n, nrhs, l, lda, b, ldb);
+  SolveUpper(n, nrhs, l, lda, b, ldb);
+}
+
+template <class T>
+T CholeskyLogDeterminant(int n, const T *l, std::ptrdiff_t lda) noexcept {
+  T sum = T(0);
+  for (int i = 0; i < n; ++i) sum += std::log(l[i * lda + i]);
+  return 2 * sum;
+}
+
+#define S21_INSTANTIATE_CHOLESKY(T)                                        \
+  template int CholeskyFactor<T>(int, T *, std::ptrdiff_t);                \
+  template void CholeskySolve<T>(int, int, const T *, std::ptrdiff_t, T *, \
+                                 std::ptrdiff_t);                          \
+  template T CholeskyLogDeterminant<T>(int, const T *,                     \
+                                       std::ptrdiff_t) noexcept;
+
+S21_INSTANTIATE_CHOLESKY(float)
+S21_INSTANTIATE_CHOLESKY(double)
+
+}  // namespace s21
@@ -0,0 +1,45 @@
+#ifndef SRC_S21_CHOLESKY_H_
+#define SRC_S21_CHOLESKY_H_
+
+#include <cstddef>
+
+#include "s21_scalar_traits.h"
+
+namespace s21 {
+
+// Panel width of the blocked factorization; the trailing update of each
+// panel is a rank-kCholeskyBlock GEMM restricted to the lower triangle.
+constexpr int kCholeskyBlock = 64;
+
+// The routines below are defined for float and double.
+//
+// Factors the symmetric positive definite n x n row-major matrix a
+// (leading dimension lda) in place as A = L * L^T, right-looking: each
+// kCholeskyBlock panel factors its diagonal block, solves the block
+// column below it against that triangle and subtracts its outer product
+// from the trailing lower triangle with Gemm. Only the lower triangle of
+// a is read and L overwrites it; entries above the diagonal near it are
+// clobbered by the block updates.
+//
+// Returns 0 on success, or k + 1 if the pivot at step k is not positive
+// (or not a number): A is then not positive definite, the factorization
+// stops there and nothing is thrown.
+template <class T>
+int CholeskyFactor(int n, T *a, std::ptrdiff_t lda);
+
+// Overwrites the n x nrhs row-major matrix b with A^-1 * b, given the
+// factor produced by CholeskyFactor. The forward solve with L and the
+// backward solve with L^T run in kCholeskyBlock row blocks whose
+// off-diagonal updates go through Gemm.
+template <class T>
+void CholeskySolve(int n, int nrhs, const T *l, std::ptrdiff_t lda, T *b,
+                   std::ptrdiff_t ldb);
+
+// log(det A) = 2 * sum log L(i, i), finite where det A itself would
+// overflow or underflow.
+template <class T>
+T CholeskyLogDeterminant(int n, const T *l, std::ptrdiff_t lda) noexcept;
+
+}  // namespace s21
+
+#endif
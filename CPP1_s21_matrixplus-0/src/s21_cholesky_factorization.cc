@@ -0,0 +1,105 @@
+#include "s21_cholesky_factorization.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "s21_cholesky.h"
+
+template <class T>
+S21BasicCholeskyFactorization<T>::S21BasicCholeskyFactorization(
+    const S21BasicMatrix<T> &a)
+    : S21BasicCholeskyFactorization(a, a.GetResource()) {}
+
+template <class T>
+S21BasicCholeskyFactorization<T>::S21BasicCholeskyFactorization(
+    const S21BasicMatrix<T> &a, std::pmr::memory_resource *resource)
+    : l_(a, resource) {
+  if (a.Data() == nullptr) throw std::runtime_error("Error: matrix is null");
+  if (a.GetRows() != a.GetCols()) {
+    throw std::invalid_argument("Error: matrix is not square");
+  }
+  info_ = s21::CholeskyFactor(Size(), l_.Data(), l_.Stride());
+  if (info_ == 0) {
+    for (int i = 0; i < Size(); i++) {
+      T *row = l_.Data() + i * l_.Stride();
+      std::fill(row + i + 1, row + Size(), T(0));
+    }
+  }
+}
+
+template <class T>
+int S21BasicCholeskyFactorization<T>::Size() const noexcept {
+  return l_.GetRows();
+}
+
+template <class T>
+bool S21BasicCholeskyFactorization<T>::IsPositiveDefinite() const noexcept {
+  return info_ == 0;
+}
+
+template <class T>
+int S21BasicCholeskyFactorization<T>::NonPositivePivot() const noexcept {
+  return info_ - 1;
+}
+
+template <class T>
+T S21BasicCholeskyFactorization<T>::LogDeterminant() const {
+  CheckSolvable(Size());
+  return s21::CholeskyLogDeterminant(Size(), l_.Data(), l_.Stride());
+}
+
+template <class T>
+void S21BasicCholeskyFactorization<T>::CheckSolvable(int rows) const {
+  if (rows != Size()) throw std::runtime_error("Error: sizes are not equal");
+  if (!IsPositiveDefinite()) {
+    throw std::logic_error("Error: matrix is not positive definite");
+  }
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicCholeskyFactorization<T>::Solve(
+    const S21BasicMatrix<T> &b) const {
+  S21BasicMatrix<T> x(b, b.GetResource());
+  SolveInPlace(x);
+  return x;
+}
+
+template <class T>
+void S21BasicCholeskyFactorization<T>::SolveInPlace(
+    S21BasicMatrix<T> &b) const {
+  if (b.Data() == nullptr) throw std::runtime_error("Error: matrix is null");
+  CheckSolvable(b.GetRows());
+  s21::CholeskySolve(Size(), b.GetCols(), l_.Data(), l_.Stride(), b.Data(),
+                     b.Stride());
+}
+
+template <class T>
+std::vector<T> S21BasicCholeskyFactorization<T>::Solve(
+    const std::vector<T> &b) const {
+  std::vector<T> x(b);
+  SolveInPlace(x);
+  return x;
+}
+
+template <class T>
+void S21BasicCholeskyFactorization<T>::SolveInPlace(std::vector<T> &b) const {
+  CheckSolvable(static_cast<int>(b.size()));
+  s21::CholeskySolve(Size(), 1, l_.Data(), l_.Stride(), b.data(), 1);
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicCholeskyFactorization<T>::Inverse() const {
+  S21BasicMatrix<T> inverse(Size(), Size(), l_.GetResource());
+  for (int i = 0; i < Size(); i++) inverse(i, i) = T(1);
+  SolveInPlace(inverse);
+  return inverse;
+}
+
+template <class T>
+const S21BasicMatrix<T> &S21BasicCholeskyFactorization<T>::Factor()
+    const noexcept {
+  return l_;
+}
+
+template class S21BasicCholeskyFactorization<float>;
+template class S21BasicCholeskyFactorization<double>;
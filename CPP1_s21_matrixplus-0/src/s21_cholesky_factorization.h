@@ -0,0 +1,66 @@
+#ifndef SRC_S21_CHOLESKY_FACTORIZATION_H_
+#define SRC_S21_CHOLESKY_FACTORIZATION_H_
+
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Cholesky factorization A = L * L^T of a symmetric positive definite
+// matrix, kept for repeated solves. The blocked factorization (see
+// s21_cholesky.h) costs n^3 / 3 flops, half of LU. Only the lower
+// triangle of A is read: symmetry is assumed, not checked, and whatever
+// lies above the diagonal is ignored. Instantiated for float and double.
+//
+// Construction and the Solve, SolveInPlace and Inverse overloads behave
+// as in S21BasicLuFactorization (s21_lu_factorization.h), except that a
+// matrix that is not positive definite makes them throw
+// std::logic_error. Factoring such a matrix is not an error:
+// IsPositiveDefinite() reports it and NonPositivePivot() says where the
+// factorization stopped.
+template <class T>
+class S21BasicCholeskyFactorization {
+ public:
+  using Scalar = T;
+
+  explicit S21BasicCholeskyFactorization(const S21BasicMatrix<T> &a);
+  S21BasicCholeskyFactorization(const S21BasicMatrix<T> &a,
+                                std::pmr::memory_resource *resource);
+
+  int Size() const noexcept;
+  bool IsPositiveDefinite() const noexcept;
+  // The step k at which A(k, k) minus the squares already in row k of L
+  // was not positive (or not a number), or -1 if A is positive definite.
+  // The leading k x k block of A is positive definite and its factor
+  // fills the first k rows of Factor(); the rest is partly updated.
+  int NonPositivePivot() const noexcept;
+
+  // log(det A) = 2 * sum log L(i, i), which stays finite where det A
+  // would overflow. det A is positive, so there is no sign to return.
+  T LogDeterminant() const;
+
+  // A forward solve with L and a backward one with L^T.
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &b) const;
+  void SolveInPlace(S21BasicMatrix<T> &b) const;
+  std::vector<T> Solve(const std::vector<T> &b) const;
+  void SolveInPlace(std::vector<T> &b) const;
+  // Symmetric like A.
+  S21BasicMatrix<T> Inverse() const;
+
+  // L, lower triangular with zeros above the diagonal; only meaningful
+  // when IsPositiveDefinite().
+  const S21BasicMatrix<T> &Factor() const noexcept;
+
+ private:
+  S21BasicMatrix<T> l_;
+  int info_ = 0;
+  void CheckSolvable(int rows) const;
+};
+
+using S21CholeskyFactorization = S21BasicCholeskyFactorization<double>;
+using S21FloatCholeskyFactorization = S21BasicCholeskyFactorization<float>;
+
+extern template class S21BasicCholeskyFactorization<float>;
+extern template class S21BasicCholeskyFactorization<double>;
+
+#endif
@@ -0,0 +1,398 @@
+#ifndef SRC_S21_FIXED_MATRIX_H_
+#define SRC_S21_FIXED_MATRIX_H_
+
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_oop.h"
+#include "s21_scalar_traits.h"
+
+// Rows x Cols matrix of T stored inline, for the small sizes (1 to 8) of
+// geometry code. Every operation is constexpr and allocation free; the
+// dimensions are checked at compile time, so element access does no
+// bounds checking. Floating determinants and inverses up to 4x4 use
+// unrolled closed forms, larger ones pivoted elimination over
+// fixed-length loops.
+//
+// T is float, double or std::int32_t. Integer determinants use
+// fraction-free elimination in 64-bit arithmetic at every size and stay
+// exact: like S21IntMatrix, Determinant and CalcComplements throw
+// std::overflow_error (a compile error in a constant expression) when a
+// result does not fit in T. Inversion needs a floating type.
+template <class T, int Rows, int Cols>
+class S21FixedMatrix {
+  static_assert(Rows >= 1 && Rows <= 8 && Cols >= 1 && Cols <= 8,
+                "fixed matrices are 1x1 to 8x8");
+  static_assert(std::is_arithmetic<T>::value,
+                "fixed matrices hold float, double or std::int32_t");
+
+ public:
+  using Scalar = T;
+
+  // Zero matrix.
+  constexpr S21FixedMatrix() noexcept : data_{} {}
+  // Row-major values; a wrong count throws (a compile error in a constant
+  // expression).
+  constexpr S21FixedMatrix(std::initializer_list<T> values) : data_{} {
+    if (values.size() != static_cast<std::size_t>(Rows) * Cols) {
+      throw std::invalid_argument("Wrong number of values");
+    }
+    const T *value = values.begin();
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) data_[i][j] = *value++;
+    }
+  }
+  // Copies a Rows x Cols S21BasicMatrix; other shapes throw.
+  explicit S21FixedMatrix(const S21BasicMatrix<T> &m) : data_{} {
+    if (m.GetRows() != Rows || m.GetCols() != Cols) {
+      throw std::runtime_error("Error: sizes are not equal");
+    }
+    for (int i = 0; i < Rows; i++) {
+      std::memcpy(data_[i], m.Data() + i * m.Stride(), sizeof(T) * Cols);
+    }
+  }
+
+  static constexpr S21FixedMatrix Identity() noexcept {
+    static_assert(Rows == Cols, "identity must be square");
+    S21FixedMatrix m;
+    for (int i = 0; i < Rows; i++) m.data_[i][i] = 1;
+    return m;
+  }
+
+  explicit operator S21BasicMatrix<T>() const {
+    S21BasicMatrix<T> m(Rows, Cols);
+    for (int i = 0; i < Rows; i++) {
+      std::memcpy(m.Data() + i * m.Stride(), data_[i], sizeof(T) * Cols);
+    }
+    return m;
+  }
+
+  static constexpr int GetRows() noexcept { return Rows; }
+  static constexpr int GetCols() noexcept { return Cols; }
+
+  constexpr T &operator()(int i, int j) noexcept { return data_[i][j]; }
+  constexpr const T &operator()(int i, int j) const noexcept {
+    return data_[i][j];
+  }
+
+  // Elements equal within s21::ScalarTraits<T>::kTolerance.
+  constexpr bool EqMatrix(const S21FixedMatrix &other) const noexcept {
+    const T tolerance = s21::ScalarTraits<T>::kTolerance;
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) {
+        T diff = data_[i][j] - other.data_[i][j];
+        if (diff > tolerance || -diff > tolerance) return false;
+      }
+    }
+    return true;
+  }
+  constexpr bool operator==(const S21FixedMatrix &other) const noexcept {
+    return EqMatrix(other);
+  }
+  constexpr bool operator!=(const S21FixedMatrix &other) const noexcept {
+    return !EqMatrix(other);
+  }
+
+  constexpr S21FixedMatrix &operator+=(const S21FixedMatrix &o) noexcept {
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) data_[i][j] += o.data_[i][j];
+    }
+    return *this;
+  }
+  constexpr S21FixedMatrix &operator-=(const S21FixedMatrix &o) noexcept {
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) data_[i][j] -= o.data_[i][j];
+    }
+    return *this;
+  }
+  constexpr S21FixedMatrix &operator*=(T value) noexcept {
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) data_[i][j] *= value;
+    }
+    return *this;
+  }
+  constexpr S21FixedMatrix<T, Cols, Rows> Transpose() const noexcept {
+    S21FixedMatrix<T, Cols, Rows> t;
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) t(j, i) = data_[i][j];
+    }
+    return t;
+  }
+
+  constexpr T Determinant() const
+      noexcept(std::is_floating_point<T>::value);
+  constexpr S21FixedMatrix CalcComplements() const
+      noexcept(std::is_floating_point<T>::value);
+  // Throws std::logic_error if the matrix is singular (exactly zero
+  // determinant up to 4x4, a zero pivot above).
+  constexpr S21FixedMatrix InverseMatrix() const;
+
+  // The (Rows - 1) x (Cols - 1) matrix without row p and column q.
+  constexpr S21FixedMatrix<T, Rows - 1, Cols - 1> Minor(int p,
+                                                        int q) const noexcept {
+    S21FixedMatrix<T, Rows - 1, Cols - 1> m;
+    for (int i = 0, r = 0; i < Rows; i++) {
+      if (i == p) continue;
+      for (int j = 0, c = 0; j < Cols; j++) {
+        if (j != q) m(r, c++) = data_[i][j];
+      }
+      r++;
+    }
+    return m;
+  }
+
+ private:
+  T data_[Rows][Cols];
+};
+
+template <int N>
+using S21FixedSquare = S21FixedMatrix<double, N, N>;
+using S21Matrix2 = S21FixedSquare<2>;
+using S21Matrix3 = S21FixedSquare<3>;
+using S21Matrix4 = S21FixedSquare<4>;
+
+namespace s21 {
+namespace fixed {
+
+template <class T>
+constexpr T Abs(T x) noexcept {
+  return x < 0 ? -x : x;
+}
+
+// Determinant by partial pivoting for floating sizes without a closed
+// form. Works on a copy.
+template <class T, int N>
+constexpr T EliminationDeterminant(S21FixedMatrix<T, N, N> a) noexcept {
+  T det = 1;
+  for (int k = 0; k < N; k++) {
+    int pivot = k;
+    for (int i = k + 1; i < N; i++) {
+      if (Abs(a(i, k)) > Abs(a(pivot, k))) pivot = i;
+    }
+    if (a(pivot, k) == 0) return 0;
+    if (pivot != k) {
+      for (int j = 0; j < N; j++) {
+        T t = a(k, j);
+        a(k, j) = a(pivot, j);
+        a(pivot, j) = t;
+      }
+      det = -det;
+    }
+    for (int i = k + 1; i < N; i++) {
+      for (int j = k + 1; j < N; j++) a(i, j) -= a(i, k) / a(k, k) * a(k, j);
+    }
+    det *= a(k, k);
+  }
+  return det;
+}
+
+// Exact integer determinant by Bareiss elimination: every intermediate is
+// a minor of m, kept in long long, with the products taken in __int128.
+// Throws std::overflow_error when an intermediate or the result does not
+// fit.
+template <class T, int N>
+constexpr T ExactDeterminant(const S21FixedMatrix<T, N, N> &m) {
+  constexpr long long kMin = std::numeric_limits<long long>::min();
+  constexpr long long kMax = std::numeric_limits<long long>::max();
+  long long a[N][N] = {};
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) a[i][j] = m(i, j);
+  }
+  int sign = 1;
+  long long previous = 1;
+  for (int k = 0; k < N - 1; k++) {
+    int pivot = k;
+    for (int i = k + 1; i < N; i++) {
+      if (Abs(a[i][k]) > Abs(a[pivot][k])) pivot = i;
+    }
+    if (a[pivot][k] == 0) return 0;
+    if (pivot != k) {
+      for (int j = 0; j < N; j++) {
+        long long t = a[k][j];
+        a[k][j] = a[pivot][j];
+        a[pivot][j] = t;
+      }
+      sign = -sign;
+    }
+    for (int i = k + 1; i < N; i++) {
+      for (int j = k + 1; j < N; j++) {
+        __int128 value = static_cast<__int128>(a[i][j]) * a[k][k] -
+                         static_cast<__int128>(a[i][k]) * a[k][j];
+        value /= previous;
+        if (value < kMin || value > kMax) {
+          throw std::overflow_error("Error: determinant overflows");
+        }
+        a[i][j] = static_cast<long long>(value);
+      }
+    }
+    previous = a[k][k];
+  }
+  const __int128 det = static_cast<__int128>(sign) * a[N - 1][N - 1];
+  if (det < std::numeric_limits<T>::min() ||
+      det > std::numeric_limits<T>::max()) {
+    throw std::overflow_error("Error: determinant overflows");
+  }
+  return static_cast<T>(det);
+}
+
+}  // namespace fixed
+}  // namespace s21
+
+template <class T, int Rows, int Cols>
+constexpr T S21FixedMatrix<T, Rows, Cols>::Determinant() const
+    noexcept(std::is_floating_point<T>::value) {
+  static_assert(Rows == Cols, "determinant needs a square matrix");
+  const auto &a = data_;
+  if constexpr (std::is_integral<T>::value) {
+    // The closed forms below would overflow T silently.
+    return s21::fixed::ExactDeterminant(*this);
+  } else if constexpr (Rows == 1) {
+    return a[0][0];
+  } else if constexpr (Rows == 2) {
+    return a[0][0] * a[1][1] - a[0][1] * a[1][0];
+  } else if constexpr (Rows == 3) {
+    return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+           a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+           a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+  } else if constexpr (Rows == 4) {
+    // Laplace expansion along the first two rows: six 2x2 minors of the
+    // top rows times their complementary minors of the bottom rows.
+    T s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+    T s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+    T s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+    T s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+    T s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+    T s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+    T c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+    T c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+    T c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+    T c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+    T c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+    T c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  } else {
+    return s21::fixed::EliminationDeterminant(*this);
+  }
+}
+
+template <class T, int Rows, int Cols>
+constexpr S21FixedMatrix<T, Rows, Cols>
+S21FixedMatrix<T, Rows, Cols>::CalcComplements() const
+    noexcept(std::is_floating_point<T>::value) {
+  static_assert(Rows == Cols, "complements need a square matrix");
+  S21FixedMatrix c;
+  if constexpr (Rows == 1) {
+    c(0, 0) = 1;
+  } else {
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) {
+        T minor = Minor(i, j).Determinant();
+        if constexpr (std::is_integral<T>::value) {
+          if ((i + j) % 2 && minor == std::numeric_limits<T>::min()) {
+            throw std::overflow_error("Error: determinant overflows");
+          }
+        }
+        c(i, j) = (i + j) % 2 ? -minor : minor;
+      }
+    }
+  }
+  return c;
+}
+
+template <class T, int Rows, int Cols>
+constexpr S21FixedMatrix<T, Rows, Cols>
+S21FixedMatrix<T, Rows, Cols>::InverseMatrix() const {
+  static_assert(Rows == Cols, "inverse needs a square matrix");
+  static_assert(std::is_floating_point<T>::value,
+                "inverse needs a floating-point element type");
+  if constexpr (Rows <= 4) {
+    // Adjugate over determinant, both in closed form.
+    S21FixedMatrix c = CalcComplements();
+    T det = 0;
+    for (int j = 0; j < Cols; j++) det += data_[0][j] * c(0, j);
+    if (det == 0) throw std::logic_error("Determinant is 0");
+    S21FixedMatrix inverse;
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) inverse(i, j) = c(j, i) / det;
+    }
+    return inverse;
+  } else {
+    // Gauss-Jordan with partial pivoting on [A | I].
+    S21FixedMatrix a = *this;
+    S21FixedMatrix inverse = Identity();
+    for (int k = 0; k < Rows; k++) {
+      int pivot = k;
+      for (int i = k + 1; i < Rows; i++) {
+        if (s21::fixed::Abs(a(i, k)) > s21::fixed::Abs(a(pivot, k))) pivot = i;
+      }
+      if (a(pivot, k) == 0) throw std::logic_error("Determinant is 0");
+      for (int j = 0; j < Cols; j++) {
+        T t = a(k, j);
+        a(k, j) = a(pivot, j);
+        a(pivot, j) = t;
+        t = inverse(k, j);
+        inverse(k, j) = inverse(pivot, j);
+        inverse(pivot, j) = t;
+      }
+      const T scale = 1 / a(k, k);
+      for (int j = 0; j < Cols; j++) {
+        a(k, j) *= scale;
+        inverse(k, j) *= scale;
+      }
+      for (int i = 0; i < Rows; i++) {
+        if (i == k) continue;
+        const T factor = a(i, k);
+        for (int j = 0; j < Cols; j++) {
+          a(i, j) -= factor * a(k, j);
+          inverse(i, j) -= factor * inverse(k, j);
+        }
+      }
+    }
+    return inverse;
+  }
+}
+
+template <class T, int Rows, int Cols>
+constexpr S21FixedMatrix<T, Rows, Cols> operator+(
+    S21FixedMatrix<T, Rows, Cols> l,
+    const S21FixedMatrix<T, Rows, Cols> &r) noexcept {
+  return l += r;
+}
+
+template <class T, int Rows, int Cols>
+constexpr S21FixedMatrix<T, Rows, Cols> operator-(
+    S21FixedMatrix<T, Rows, Cols> l,
+    const S21FixedMatrix<T, Rows, Cols> &r) noexcept {
+  return l -= r;
+}
+
+template <class T, int Rows, int Cols>
+constexpr S21FixedMatrix<T, Rows, Cols> operator*(
+    S21FixedMatrix<T, Rows, Cols> m, s21::NonDeduced<T> value) noexcept {
+  return m *= value;
+}
+
+template <class T, int Rows, int Cols>
+constexpr S21FixedMatrix<T, Rows, Cols> operator*(
+    s21::NonDeduced<T> value, S21FixedMatrix<T, Rows, Cols> m) noexcept {
+  return m *= value;
+}
+
+template <class T, int Rows, int Inner, int Cols>
+constexpr S21FixedMatrix<T, Rows, Cols> operator*(
+    const S21FixedMatrix<T, Rows, Inner> &l,
+    const S21FixedMatrix<T, Inner, Cols> &r) noexcept {
+  S21FixedMatrix<T, Rows, Cols> res;
+  for (int i = 0; i < Rows; i++) {
+    for (int k = 0; k < Inner; k++) {
+      const T lik = l(i, k);
+      for (int j = 0; j < Cols; j++) res(i, j) += lik * r(k, j);
+    }
+  }
+  return res;
+}
+
+#endif
@@ -0,0 +1,385 @@
+#include "s21_gemm.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "s21_kernels.h"
+#include "s21_scratch_buffer.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr long kSmallGemm = 32 * 32 * 32;
+
+// Packs an mc x kc block of A into row panels of tile_m rows. Inside a
+// panel the tile_m values of one column are adjacent; short panels are
+// padded with zeros.
+template <class T>
+void PackA(int mc, int kc, const T *a, std::ptrdiff_t a_row,
+           std::ptrdiff_t a_col, int tile_m, T *packed) {
+  for (int ir = 0; ir < mc; ir += tile_m) {
+    int mr = std::min(tile_m, mc - ir);
+    for (int p = 0; p < kc; ++p) {
+      int i = 0;
+      for (; i < mr; ++i) packed[i] = a[(ir + i) * a_row + p * a_col];
+      for (; i < tile_m; ++i) packed[i] = T(0);
+      packed += tile_m;
+    }
+  }
+}
+
+// Packs a kc x nc block of B into column panels of tile_n columns. Inside
+// a panel the tile_n values of one row are adjacent.
+template <class T>
+void PackB(int kc, int nc, const T *b, std::ptrdiff_t b_row,
+           std::ptrdiff_t b_col, int tile_n, T *packed) {
+  for (int jr = 0; jr < nc; jr += tile_n) {
+    int nr = std::min(tile_n, nc - jr);
+    for (int p = 0; p < kc; ++p) {
+      const T *row = b + p * b_row + jr * b_col;
+      int j = 0;
+      if (b_col == 1) {
+        for (; j < nr; ++j) packed[j] = row[j];
+      } else {
+        for (; j < nr; ++j) packed[j] = row[j * b_col];
+      }
+      for (; j < tile_n; ++j) packed[j] = T(0);
+      packed += tile_n;
+    }
+  }
+}
+
+// Runs the micro-kernel over every register tile of a packed mc x nc block.
+// Edge tiles go through a local buffer so the kernel always sees a full
+// register tile.
+template <class T>
+void MacroKernel(const Kernels<T> &kernels, int mc, int nc, int kc, T alpha,
+                 const T *packed_a, const T *packed_b, T *c,
+                 std::ptrdiff_t ldc) {
+  const int tile_m = kernels.gemm_mr;
+  const int tile_n = kernels.gemm_nr;
+  for (int jr = 0; jr < nc; jr += tile_n) {
+    int nr = std::min(tile_n, nc - jr);
+    const T *b_panel = packed_b + static_cast<std::ptrdiff_t>(jr) * kc;
+    for (int ir = 0; ir < mc; ir += tile_m) {
+      int mr = std::min(tile_m, mc - ir);
+      const T *a_panel = packed_a + static_cast<std::ptrdiff_t>(ir) * kc;
+      T *c_tile = c + ir * ldc + jr;
+      if (mr == tile_m && nr == tile_n) {
+        kernels.gemm(kc, a_panel, b_panel, alpha, c_tile, ldc);
+      } else {
+        T edge[kMaxGemmTile] = {};
+        kernels.gemm(kc, a_panel, b_panel, alpha, edge, tile_n);
+        for (int i = 0; i < mr; ++i) {
+          for (int j = 0; j < nr; ++j) {
+            c_tile[i * ldc + j] += edge[i * tile_n + j];
+          }
+        }
+      }
+    }
+  }
+}
+
+template <class T>
+void ScaleC(int m, int n, T beta, T *c, std::ptrdiff_t ldc) {
+  if (beta == T(1)) return;
+  for (int i = 0; i < m; ++i) {
+    T *row = c + i * ldc;
+    if (beta == T(0)) {
+      std::fill(row, row + n, T(0));
+    } else {
+      for (int j = 0; j < n; ++j) row[j] *= beta;
+    }
+  }
+}
+
+// Direct i-k-j loop for tiny products with unit-stride rows of B.
+template <class T>
+void SmallGemm(int m, int n, int k, T alpha, const T *a,
+               std::ptrdiff_t a_row, std::ptrdiff_t a_col, const T *b,
+               std::ptrdiff_t ldb, T *c, std::ptrdiff_t ldc) {
+  for (int i = 0; i < m; ++i) {
+    T *c_row = c + i * ldc;
+    for (int p = 0; p < k; ++p) {
+      T aip = alpha * a[i * a_row + p * a_col];
+      const T *b_row = b + p * ldb;
+      for (int j = 0; j < n; ++j) c_row[j] += aip * b_row[j];
+    }
+  }
+}
+
+struct StrassenSettings {
+  bool enabled = false;
+  int cutoff = kStrassenCutoff;
+};
+
+StrassenSettings &Strassen() noexcept {
+  static StrassenSettings settings;
+  return settings;
+}
+
+// Integer products stay classic: Strassen's intermediate sums can overflow
+// where the plain dot products would not.
+template <class T>
+bool UseStrassen(int m, int n, int k) noexcept {
+  const StrassenSettings &settings = Strassen();
+  return !std::is_integral<T>::value && settings.enabled &&
+         std::min({m, n, k}) > settings.cutoff;
+}
+
+// c = a + b, or a - b if subtract, over rows x cols. a and b have
+// arbitrary strides, c has unit column stride and may alias a or b.
+// Unit-stride rows go through the SIMD add/sub kernels.
+template <class T>
+void Combine(int rows, int cols, const T *a, std::ptrdiff_t a_row,
+             std::ptrdiff_t a_col, const T *b, std::ptrdiff_t b_row,
+             std::ptrdiff_t b_col, bool subtract, T *c, std::ptrdiff_t ldc) {
+  const Kernels<T> &kernels = ActiveKernels<T>();
+  const bool contiguous = a_col == 1 && b_col == 1;
+  long grain = std::max(1L, kParallelMinElements / std::max(1, cols));
+  ParallelFor(rows, grain, [&](long begin, long end) {
+    for (long i = begin; i < end; ++i) {
+      const T *x = a + i * a_row;
+      const T *y = b + i * b_row;
+      T *z = c + i * ldc;
+      if (!contiguous) {
+        for (int j = 0; j < cols; ++j) {
+          z[j] = subtract ? x[j * a_col] - y[j * b_col]
+                          : x[j * a_col] + y[j * b_col];
+        }
+      } else if (z == y) {
+        // z = x - z as -(z - x).
+        if (subtract) kernels.scale(z, T(-1), cols);
+        kernels.add(z, x, cols);
+      } else {
+        if (z != x) std::copy(x, x + cols, z);
+        (subtract ? kernels.sub : kernels.add)(z, y, cols);
+      }
+    }
+  });
+}
+
+// Deepest Strassen level running on this thread; each level keeps its
+// temporaries between calls.
+constexpr int kMaxStrassenDepth = 32;
+thread_local int strassen_depth = 0;
+
+// C += alpha * A * B by one level of the Winograd variant of Strassen's
+// algorithm on the even leading part, with odd trailing rows and columns
+// peeled off into classic updates. The seven half-size products go back
+// through Gemm, which recurses while they stay above the cutoff. Three
+// temporaries per level: X for sums of A blocks, Y for sums of B blocks
+// and P for products that feed more than one block of C.
+template <class T>
+void StrassenGemm(int m, int n, int k, T alpha, const T *a,
+                  std::ptrdiff_t a_row, std::ptrdiff_t a_col, const T *b,
+                  std::ptrdiff_t b_row, std::ptrdiff_t b_col, T *c,
+                  std::ptrdiff_t ldc) {
+  const int hm = m / 2, hn = n / 2, hk = k / 2;
+  const T *a11 = a, *a12 = a + hk * a_col;
+  const T *a21 = a + hm * a_row, *a22 = a21 + hk * a_col;
+  const T *b11 = b, *b12 = b + hn * b_col;
+  const T *b21 = b + hk * b_row, *b22 = b21 + hn * b_col;
+  T *c11 = c, *c12 = c + hn, *c21 = c + hm * ldc, *c22 = c21 + hn;
+  thread_local ScratchBuffer<T> levels[kMaxStrassenDepth];
+  const std::size_t x_size = static_cast<std::size_t>(hm) * hk;
+  const std::size_t y_size = static_cast<std::size_t>(hk) * hn;
+  T *x = levels[strassen_depth].Get(x_size + y_size +
+                                    static_cast<std::size_t>(hm) * hn);
+  T *y = x + x_size;
+  T *p = y + y_size;
+  ++strassen_depth;
+  const T one(1);
+  auto product = [&](const T *l, std::ptrdiff_t l_row, std::ptrdiff_t l_col,
+                     const T *r, std::ptrdiff_t r_row, std::ptrdiff_t r_col) {
+    Gemm<T>(hm, hn, hk, alpha, l, l_row, l_col, r, r_row, r_col, T(0), p, hn);
+  };
+  auto accumulate = [&](T *block) {
+    Combine(hm, hn, block, ldc, 1, p, hn, 1, false, block, ldc);
+  };
+
+  // C11 = M1 + M2, C12 = M1 + M3 + M5 + M6, C21 = M1 - M4 + M6 + M7 and
+  // C22 = M1 + M5 + M6 + M7. P holds alpha * Mi.
+  product(a11, a_row, a_col, b11, b_row, b_col);  // M1 = A11 B11
+  for (T *block : {c11, c12, c21, c22}) accumulate(block);
+  Gemm<T>(hm, hn, hk, alpha, a12, a_row, a_col, b21, b_row, b_col, one, c11,
+          ldc);  // M2 = A12 B21
+  Combine(hm, hk, a21, a_row, a_col, a22, a_row, a_col, false, x, hk);
+  Combine(hk, hn, b12, b_row, b_col, b11, b_row, b_col, true, y, hn);
+  product(x, hk, 1, y, hn, 1);  // M5 = S1 T1 = (A21 + A22)(B12 - B11)
+  accumulate(c12);
+  accumulate(c22);
+  Combine(hm, hk, x, hk, 1, a11, a_row, a_col, true, x, hk);
+  Combine(hk, hn, b22, b_row, b_col, y, hn, 1, true, y, hn);
+  product(x, hk, 1, y, hn, 1);  // M6 = S2 T2 = (S1 - A11)(B22 - T1)
+  for (T *block : {c12, c21, c22}) accumulate(block);
+  Combine(hm, hk, a12, a_row, a_col, x, hk, 1, true, x, hk);
+  Gemm<T>(hm, hn, hk, alpha, x, hk, 1, b22, b_row, b_col, one, c12,
+          ldc);  // M3 = (A12 - S2) B22
+  Combine(hk, hn, y, hn, 1, b21, b_row, b_col, true, y, hn);
+  Gemm<T>(hm, hn, hk, -alpha, a22, a_row, a_col, y, hn, 1, one, c21,
+          ldc);  // M4 = A22 (T2 - B21)
+  Combine(hm, hk, a11, a_row, a_col, a21, a_row, a_col, true, x, hk);
+  Combine(hk, hn, b22, b_row, b_col, b12, b_row, b_col, true, y, hn);
+  product(x, hk, 1, y, hn, 1);  // M7 = (A11 - A21)(B22 - B12)
+  accumulate(c21);
+  accumulate(c22);
+  --strassen_depth;
+
+  // Peeling: the last column of A times the last row of B, then the last
+  // column and row of C.
+  const int em = 2 * hm, en = 2 * hn, ek = 2 * hk;
+  if (k > ek) {
+    Gemm<T>(em, en, 1, alpha, a + ek * a_col, a_row, a_col, b + ek * b_row,
+            b_row, b_col, one, c, ldc);
+  }
+  if (n > en) {
+    Gemm<T>(m, 1, k, alpha, a, a_row, a_col, b + en * b_col, b_row, b_col,
+            one, c + en, ldc);
+  }
+  if (m > em) {
+    Gemm<T>(1, en, k, alpha, a + em * a_row, a_row, a_col, b, b_row, b_col,
+            one, c + em * ldc, ldc);
+  }
+}
+
+}  // namespace
+
+void SetStrassen(bool enabled, int cutoff) noexcept {
+  Strassen().enabled = enabled;
+  Strassen().cutoff = std::max(cutoff, 1);
+}
+
+bool StrassenEnabled() noexcept { return Strassen().enabled; }
+
+template <class T>
+void Gemm(int m, int n, int k, NonDeduced<T> alpha, const T *a,
+          std::ptrdiff_t lda, const T *b, std::ptrdiff_t ldb,
+          NonDeduced<T> beta, T *c, std::ptrdiff_t ldc) {
+  Gemm(m, n, k, alpha, a, lda, 1, b, ldb, 1, beta, c, ldc);
+}
+
+template <class T>
+void Gemm(int m, int n, int k, NonDeduced<T> alpha, const T *a,
+          std::ptrdiff_t a_row, std::ptrdiff_t a_col, const T *b,
+          std::ptrdiff_t b_row, std::ptrdiff_t b_col, NonDeduced<T> beta,
+          T *c, std::ptrdiff_t ldc) {
+  if (m <= 0 || n <= 0) return;
+  ScaleC(m, n, beta, c, ldc);
+  if (k <= 0 || alpha == T(0)) return;
+  if (UseStrassen<T>(m, n, k)) {
+    StrassenGemm<T>(m, n, k, alpha, a, a_row, a_col, b, b_row, b_col, c, ldc);
+    return;
+  }
+  if (b_col == 1 && static_cast<long>(m) * n * k <= kSmallGemm) {
+    SmallGemm(m, n, k, alpha, a, a_row, a_col, b, b_row, c, ldc);
+    return;
+  }
+
+  const Kernels<T> &kernels = ActiveKernels<T>();
+  const int tile_n = kernels.gemm_nr;
+  thread_local ScratchBuffer<T> b_buffer;
+  T *packed_b = b_buffer.Get(static_cast<std::size_t>(kGemmKc) *
+                                  (kGemmNc + tile_n));
+  const bool parallel = static_cast<double>(m) * n * k >= kParallelMinFlops;
+  const long threads = parallel ? ThreadCount() : 1;
+  const long row_blocks = (m + kGemmMc - 1) / kGemmMc;
+
+  for (int jc = 0; jc < n; jc += kGemmNc) {
+    int nc = std::min(kGemmNc, n - jc);
+    // With fewer row blocks than threads, also split the B panel by
+    // columns so short, wide products still spread over the pool.
+    long col_blocks = 1;
+    if (row_blocks < threads) {
+      col_blocks = std::min<long>((threads + row_blocks - 1) / row_blocks,
+                                  (nc + tile_n - 1) / tile_n);
+    }
+    const int col_width =
+        static_cast<int>((nc + col_blocks - 1) / col_blocks + tile_n - 1) /
+        tile_n * tile_n;
+    for (int pc = 0; pc < k; pc += kGemmKc) {
+      int kc = std::min(kGemmKc, k - pc);
+      PackB(kc, nc, b + pc * b_row + jc * b_col, b_row, b_col, tile_n,
+            packed_b);
+      auto task = [&](long begin, long end) {
+        thread_local ScratchBuffer<T> a_buffer;
+        T *packed_a =
+            a_buffer.Get(static_cast<std::size_t>(kGemmMc) * kGemmKc);
+        int packed_ic = -1;
+        for (long t = begin; t < end; ++t) {
+          int ic = static_cast<int>(t / col_blocks) * kGemmMc;
+          int j0 = static_cast<int>(t % col_blocks) * col_width;
+          if (j0 >= nc) continue;
+          int mc = std::min(kGemmMc, m - ic);
+          if (ic != packed_ic) {
+            PackA(mc, kc, a + ic * a_row + pc * a_col, a_row, a_col,
+                  kernels.gemm_mr, packed_a);
+            packed_ic = ic;
+          }
+          MacroKernel(kernels, mc, std::min(col_width, nc - j0), kc, alpha,
+                      packed_a, packed_b + static_cast<std::ptrdiff_t>(j0) * kc,
+                      c + ic * ldc + jc + j0, ldc);
+        }
+      };
+      long tasks = row_blocks * col_blocks;
+      if (parallel) {
+        ParallelFor(tasks, 1, task);
+      } else {
+        task(0, tasks);
+      }
+    }
+  }
+}
+
+template <class T>
+void Gemm(NonDeduced<T> alpha, ConstViewOf<T> a, ConstViewOf<T> b,
+          NonDeduced<T> beta, MatrixView<T> c) {
+  if (a.Empty() || b.Empty() || c.Empty()) {
+    throw std::runtime_error("Error: matrix is null");
+  }
+  if (a.Cols() != b.Rows() || a.Rows() != c.Rows() || b.Cols() != c.Cols()) {
+    throw std::runtime_error("Error: impossible to multiply");
+  }
+  if (c.ColStride() == 1) {
+    Gemm(c.Rows(), c.Cols(), a.Cols(), alpha, a.Data(), a.RowStride(),
+         a.ColStride(), b.Data(), b.RowStride(), b.ColStride(), beta,
+         c.Data(), c.RowStride());
+  } else if (c.RowStride() == 1) {
+    // C^T = B^T * A^T has unit column stride.
+    Gemm<T>(alpha, b.Transposed(), a.Transposed(), beta, c.Transposed());
+  } else {
+    const int m = c.Rows();
+    const int n = c.Cols();
+    std::vector<T> product(static_cast<std::size_t>(m) * n);
+    Gemm(m, n, a.Cols(), alpha, a.Data(), a.RowStride(), a.ColStride(),
+         b.Data(), b.RowStride(), b.ColStride(), T(0), product.data(), n);
+    for (int i = 0; i < m; ++i) {
+      for (int j = 0; j < n; ++j) {
+        T &cij = c.Data()[i * c.RowStride() + j * c.ColStride()];
+        cij = (beta == T(0) ? T(0) : beta * cij) + product[i * n + j];
+      }
+    }
+  }
+}
+
+#define S21_INSTANTIATE_GEMM(T)                                              \
+  template void Gemm<T>(int, int, int, NonDeduced<T>, const T *,             \
+                        std::ptrdiff_t, const T *, std::ptrdiff_t,           \
+                        NonDeduced<T>, T *, std::ptrdiff_t);                 \
+  template void Gemm<T>(int, int, int, NonDeduced<T>, const T *,             \
+                        std::ptrdiff_t, std::ptrdiff_t, const T *,           \
+                        std::ptrdiff_t, std::ptrdiff_t, NonDeduced<T>, T *,  \
+                        std::ptrdiff_t);                                     \
+  template void Gemm<T>(NonDeduced<T>, ConstViewOf<T>, ConstViewOf<T>,       \
+                        NonDeduced<T>, MatrixView<T>);
+
+S21_INSTANTIATE_GEMM(float)
+S21_INSTANTIATE_GEMM(double)
+S21_INSTANTIATE_GEMM(std::int32_t)
+S21_INSTANTIATE_GEMM(std::complex<double>)
+
+}  // namespace s21
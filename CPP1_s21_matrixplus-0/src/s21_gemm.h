@@ -0,0 +1,77 @@
+#ifndef SRC_S21_GEMM_H_
+#define SRC_S21_GEMM_H_
+
+#include <cstddef>
+
+#include "s21_matrix_view.h"
+
+namespace s21 {
+
+// Cache blocking around the register tile of the active micro-kernel (see
+// s21_kernels.h). A kGemmKc-deep panel of B (16-32 KiB) stays in L1, a
+// kGemmMc x kGemmKc block of A (192 KiB) stays in L2, and a kGemmKc x
+// kGemmNc panel of B is shared by every A block that walks over it. kGemmMc
+// is a multiple of every kernel's row tile.
+constexpr int kGemmKc = 256;
+constexpr int kGemmMc = 96;
+constexpr int kGemmNc = 2048;
+
+// C = alpha * A * B + beta * C for row-major operands, where A is m x k with
+// leading dimension lda, B is k x n with ldb and C is m x n with ldc.
+// Defined for every ScalarTraits element type; alpha and beta convert to
+// it.
+//
+// Blocks of A and B are packed into contiguous, zero-padded micro-panels
+// so the micro-kernel streams both operands with unit stride. The target is
+// 80% of one core's double-precision peak on products above 512 x 512,
+// i.e. at 3 GHz about 10 GFLOPS with SSE2, 38 with AVX2 and 77 with
+// AVX-512, and twice that in single precision. The blocking sizes count
+// elements, so float panels use half the cache they were sized for. Tiny
+// products skip packing and use a direct i-k-j loop.
+template <class T>
+void Gemm(int m, int n, int k, NonDeduced<T> alpha, const T *a,
+          std::ptrdiff_t lda, const T *b, std::ptrdiff_t ldb,
+          NonDeduced<T> beta, T *c, std::ptrdiff_t ldc);
+
+// Same with explicit column strides: element (i, p) of A is
+// a[i * a_row + p * a_col], and likewise for B. Packing absorbs the
+// strides, so transposed or column-sliced operands cost no extra copy.
+template <class T>
+void Gemm(int m, int n, int k, NonDeduced<T> alpha, const T *a,
+          std::ptrdiff_t a_row, std::ptrdiff_t a_col, const T *b,
+          std::ptrdiff_t b_row, std::ptrdiff_t b_col, NonDeduced<T> beta,
+          T *c, std::ptrdiff_t ldc);
+
+// C = alpha * A * B + beta * C on views, so the result can land directly
+// in a block of a larger matrix. C must not overlap A or B. Throws
+// std::runtime_error if the shapes do not conform.
+template <class T>
+void Gemm(NonDeduced<T> alpha, ConstViewOf<T> a, ConstViewOf<T> b,
+          NonDeduced<T> beta, MatrixView<T> c);
+
+// Opt-in Strassen-Winograd multiplication. While enabled, every
+// floating-point Gemm whose m, n and k all exceed cutoff is split into
+// seven half-size products and eight block sums per level (odd trailing
+// rows and columns are peeled into classic updates), recursing until the
+// sizes reach the cutoff and the blocked kernel takes over. The products
+// run one after another, each spread over the thread pool; a level holds
+// three half-size temporaries. Integer products stay classic.
+//
+// The speedup is about (8/7)^levels minus the O(n^2) block sums, so it
+// pays off only well above the cutoff. The price is accuracy: classic
+// GEMM satisfies the componentwise bound |C - fl(C)| <= k u |A||B|, while
+// for l levels of Winograd's variant only a normwise bound holds (Higham,
+// Accuracy and Stability of Numerical Algorithms, 2nd ed., sec. 23.2.2):
+//   max|C - fl(C)| <= ((n0^2 + 5 n0) 18^l - 5n) u max|A| max|B|,
+// with n0 = n / 2^l the size where the recursion stops and u the unit
+// roundoff. The error is thus spread relative to the largest entries, and
+// small entries of C can lose all their relative accuracy; do not enable
+// it for badly scaled operands.
+constexpr int kStrassenCutoff = 1024;
+// Not safe to call while other threads run matrix operations.
+void SetStrassen(bool enabled, int cutoff = kStrassenCutoff) noexcept;
+bool StrassenEnabled() noexcept;
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,174 @@
+#include "s21_kernels.h"
+
+#include <complex>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+constexpr int kScalarMr = 4;
+constexpr int kScalarNr = 8;
+
+template <class T>
+T Mul(T a, T b) noexcept {
+  return a * b;
+}
+
+// Textbook complex product. operator* also handles infinities and NaNs
+// (C99 Annex G), which costs a library call per element.
+template <class R>
+std::complex<R> Mul(std::complex<R> a, std::complex<R> b) noexcept {
+  return {a.real() * b.real() - a.imag() * b.imag(),
+          a.real() * b.imag() + a.imag() * b.real()};
+}
+
+template <class T>
+void ScalarGemm(int kc, const T *a, const T *b, T alpha, T *c,
+                std::ptrdiff_t ldc) {
+  T acc[kScalarMr][kScalarNr] = {};
+  for (int p = 0; p < kc; ++p) {
+    for (int i = 0; i < kScalarMr; ++i) {
+      T ai = a[i];
+      for (int j = 0; j < kScalarNr; ++j) acc[i][j] += Mul(ai, b[j]);
+    }
+    a += kScalarMr;
+    b += kScalarNr;
+  }
+  for (int i = 0; i < kScalarMr; ++i) {
+    for (int j = 0; j < kScalarNr; ++j) {
+      c[i * ldc + j] += Mul(alpha, acc[i][j]);
+    }
+  }
+}
+
+template <class T>
+void ScalarAdd(T *a, const T *b, int n) {
+  for (int i = 0; i < n; ++i) a[i] += b[i];
+}
+
+template <class T>
+void ScalarSub(T *a, const T *b, int n) {
+  for (int i = 0; i < n; ++i) a[i] -= b[i];
+}
+
+template <class T>
+void ScalarScale(T *a, T value, int n) {
+  for (int i = 0; i < n; ++i) a[i] = Mul(a[i], value);
+}
+
+template <class T>
+void ScalarTranspose(const T *a, std::ptrdiff_t lda, T *b,
+                     std::ptrdiff_t ldb) {
+  for (int i = 0; i < kTransposeTile; ++i) {
+    for (int j = 0; j < kTransposeTile; ++j) b[j * ldb + i] = a[i * lda + j];
+  }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+bool OsSavesRegisters(unsigned mask) {
+  unsigned eax = 0, edx = 0;
+  __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (eax & mask) == mask;
+}
+#endif
+
+Isa &ActiveIsa() noexcept {
+  static Isa isa = DetectIsa();
+  return isa;
+}
+
+// Types without SIMD kernels use the portable table at every level.
+template <class T>
+const Kernels<T> &KernelsFor(Isa) noexcept {
+  return ScalarKernels<T>();
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+template <>
+const Kernels<double> &KernelsFor<double>(Isa isa) noexcept {
+  switch (isa) {
+    case Isa::kAvx512:
+      return Avx512Kernels<double>();
+    case Isa::kAvx2:
+      return Avx2Kernels<double>();
+    case Isa::kSse2:
+      return Sse2Kernels<double>();
+    default:
+      return ScalarKernels<double>();
+  }
+}
+
+template <>
+const Kernels<float> &KernelsFor<float>(Isa isa) noexcept {
+  switch (isa) {
+    case Isa::kAvx512:
+      return Avx512Kernels<float>();
+    case Isa::kAvx2:
+      return Avx2Kernels<float>();
+    case Isa::kSse2:
+      return Sse2Kernels<float>();
+    default:
+      return ScalarKernels<float>();
+  }
+}
+#endif
+
+}  // namespace
+
+Isa DetectIsa() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return Isa::kScalar;
+  if (!(edx & bit_SSE2)) return Isa::kScalar;
+  bool osxsave = ecx & bit_OSXSAVE;
+  bool fma = ecx & bit_FMA;
+  bool avx = ecx & bit_AVX;
+  if (!osxsave || !avx || !fma || !OsSavesRegisters(0x6)) return Isa::kSse2;
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return Isa::kSse2;
+  if (!(ebx & bit_AVX2)) return Isa::kSse2;
+  // AVX-512 also needs the opmask and upper ZMM state enabled by the OS.
+  if ((ebx & bit_AVX512F) && OsSavesRegisters(0xe6)) return Isa::kAvx512;
+  return Isa::kAvx2;
+#else
+  return Isa::kScalar;
+#endif
+}
+
+template <class T>
+const Kernels<T> &ActiveKernels() noexcept {
+  return KernelsFor<T>(ActiveIsa());
+}
+
+bool SetIsa(Isa isa) noexcept {
+  if (isa > DetectIsa()) return false;
+  ActiveIsa() = isa;
+  return true;
+}
+
+template <class T>
+const Kernels<T> &ScalarKernels() noexcept {
+  static const Kernels<T> kernels = {Isa::kScalar,   kScalarMr,
+                                     kScalarNr,      ScalarGemm<T>,
+                                     ScalarAdd<T>,   ScalarSub<T>,
+                                     ScalarScale<T>, ScalarTranspose<T>};
+  return kernels;
+}
+
+template const Kernels<float> &ActiveKernels<float>() noexcept;
+template const Kernels<double> &ActiveKernels<double>() noexcept;
+template const Kernels<std::int32_t> &ActiveKernels<std::int32_t>() noexcept;
+template const Kernels<std::complex<double>> &
+ActiveKernels<std::complex<double>>() noexcept;
+
+template const Kernels<float> &ScalarKernels<float>() noexcept;
+template const Kernels<double> &ScalarKernels<double>() noexcept;
+template const Kernels<std::int32_t> &ScalarKernels<std::int32_t>() noexcept;
+template const Kernels<std::complex<double>> &
+ScalarKernels<std::complex<double>>() noexcept;
+
+}  // namespace s21
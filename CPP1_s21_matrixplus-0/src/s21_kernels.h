@@ -0,0 +1,82 @@
+#ifndef SRC_S21_KERNELS_H_
+#define SRC_S21_KERNELS_H_
+
+#include <cstddef>
+
+namespace s21 {
+
+// Instruction set levels a kernel table can be built for, in increasing
+// order of capability.
+enum class Isa { kScalar, kSse2, kAvx2, kAvx512 };
+
+// Inner loops of the matrix operations on elements of type T for one
+// instruction set. The GEMM micro-kernel computes
+// C[0:gemm_mr, 0:gemm_nr] += alpha * A * B from panels packed kc deep; the
+// element-wise kernels work on n contiguous values. The transpose kernel
+// writes the transpose of the kTransposeTile x kTransposeTile block at a
+// (rows lda apart) to b (rows ldb apart) through register shuffles.
+template <class T>
+struct Kernels {
+  Isa isa;
+  int gemm_mr;
+  int gemm_nr;
+  void (*gemm)(int kc, const T *a, const T *b, T alpha, T *c,
+               std::ptrdiff_t ldc);
+  void (*add)(T *a, const T *b, int n);
+  void (*sub)(T *a, const T *b, int n);
+  void (*scale)(T *a, T value, int n);
+  void (*transpose)(const T *a, std::ptrdiff_t lda, T *b, std::ptrdiff_t ldb);
+};
+
+// Side of the square block every transpose kernel works on.
+constexpr int kTransposeTile = 8;
+
+// Largest register tile of any kernel table (AVX-512 float), for edge-tile
+// scratch buffers.
+constexpr int kMaxGemmTile = 8 * 32;
+
+// Best instruction set supported by both the CPU and the operating system,
+// probed with cpuid/xgetbv.
+Isa DetectIsa() noexcept;
+
+// Kernel table for T chosen by DetectIsa() on first use. double and float
+// have SIMD tables; other element types always get the portable one.
+template <class T = double>
+const Kernels<T> &ActiveKernels() noexcept;
+
+// Forces the instruction set of every kernel table, e.g. to compare ISA
+// levels in tests or benchmarks. Returns false and keeps the current level
+// if the CPU lacks the ISA. Not safe to call while other threads run matrix
+// operations.
+bool SetIsa(Isa isa) noexcept;
+
+// Portable kernels, defined for float, double, std::int32_t and
+// std::complex<double>.
+template <class T = double>
+const Kernels<T> &ScalarKernels() noexcept;
+
+#if defined(__x86_64__) || defined(__i386__)
+template <class T = double>
+const Kernels<T> &Sse2Kernels() noexcept;
+template <class T = double>
+const Kernels<T> &Avx2Kernels() noexcept;
+template <class T = double>
+const Kernels<T> &Avx512Kernels() noexcept;
+
+template <>
+const Kernels<double> &Sse2Kernels<double>() noexcept;
+template <>
+const Kernels<float> &Sse2Kernels<float>() noexcept;
+template <>
+const Kernels<double> &Avx2Kernels<double>() noexcept;
+template <>
+const Kernels<float> &Avx2Kernels<float>() noexcept;
+template <>
+const Kernels<double> &Avx512Kernels<double>() noexcept;
+template <>
+const Kernels<float> &Avx512Kernels<float>() noexcept;
+#endif
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,193 @@
+#include "s21_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+#define S21_TARGET __attribute__((target("avx2,fma")))
+
+namespace s21 {
+
+namespace {
+
+constexpr int kMr = 6;
+constexpr int kNr = 8;
+constexpr int kFloatNr = 16;
+
+// 6x8 tile held in twelve ymm accumulators, two per row, leaving room for
+// the two B vectors and the A broadcast.
+S21_TARGET void GemmF64(int kc, const double *a, const double *b, double alpha,
+                        double *c, std::ptrdiff_t ldc) {
+  __m256d acc[kMr][2];
+  for (int i = 0; i < kMr; ++i) acc[i][0] = acc[i][1] = _mm256_setzero_pd();
+  for (int p = 0; p < kc; ++p) {
+    __m256d b0 = _mm256_load_pd(b);
+    __m256d b1 = _mm256_load_pd(b + 4);
+#pragma GCC unroll 8
+    for (int i = 0; i < kMr; ++i) {
+      __m256d ai = _mm256_broadcast_sd(a + i);
+      acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+      acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+    }
+    a += kMr;
+    b += kNr;
+  }
+  __m256d va = _mm256_set1_pd(alpha);
+  for (int i = 0; i < kMr; ++i) {
+    double *row = c + i * ldc;
+    _mm256_storeu_pd(row, _mm256_fmadd_pd(va, acc[i][0], _mm256_loadu_pd(row)));
+    _mm256_storeu_pd(row + 4, _mm256_fmadd_pd(va, acc[i][1],
+                                              _mm256_loadu_pd(row + 4)));
+  }
+}
+
+S21_TARGET void AddF64(double *a, const double *b, int n) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(a + i, _mm256_add_pd(_mm256_loadu_pd(a + i),
+                                          _mm256_loadu_pd(b + i)));
+  }
+  for (; i < n; ++i) a[i] += b[i];
+}
+
+S21_TARGET void SubF64(double *a, const double *b, int n) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(a + i, _mm256_sub_pd(_mm256_loadu_pd(a + i),
+                                          _mm256_loadu_pd(b + i)));
+  }
+  for (; i < n; ++i) a[i] -= b[i];
+}
+
+S21_TARGET void ScaleF64(double *a, double value, int n) {
+  __m256d v = _mm256_set1_pd(value);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(a + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), v));
+  }
+  for (; i < n; ++i) a[i] *= value;
+}
+
+// Single precision: 6x16 tile in the same twelve accumulators.
+S21_TARGET void GemmF32(int kc, const float *a, const float *b, float alpha,
+                        float *c, std::ptrdiff_t ldc) {
+  __m256 acc[kMr][2];
+  for (int i = 0; i < kMr; ++i) acc[i][0] = acc[i][1] = _mm256_setzero_ps();
+  for (int p = 0; p < kc; ++p) {
+    __m256 b0 = _mm256_load_ps(b);
+    __m256 b1 = _mm256_load_ps(b + 8);
+#pragma GCC unroll 8
+    for (int i = 0; i < kMr; ++i) {
+      __m256 ai = _mm256_broadcast_ss(a + i);
+      acc[i][0] = _mm256_fmadd_ps(ai, b0, acc[i][0]);
+      acc[i][1] = _mm256_fmadd_ps(ai, b1, acc[i][1]);
+    }
+    a += kMr;
+    b += kFloatNr;
+  }
+  __m256 va = _mm256_set1_ps(alpha);
+  for (int i = 0; i < kMr; ++i) {
+    float *row = c + i * ldc;
+    _mm256_storeu_ps(row, _mm256_fmadd_ps(va, acc[i][0], _mm256_loadu_ps(row)));
+    _mm256_storeu_ps(row + 8, _mm256_fmadd_ps(va, acc[i][1],
+                                              _mm256_loadu_ps(row + 8)));
+  }
+}
+
+S21_TARGET void AddF32(float *a, const float *b, int n) {
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(a + i, _mm256_add_ps(_mm256_loadu_ps(a + i),
+                                          _mm256_loadu_ps(b + i)));
+  }
+  for (; i < n; ++i) a[i] += b[i];
+}
+
+S21_TARGET void SubF32(float *a, const float *b, int n) {
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(a + i, _mm256_sub_ps(_mm256_loadu_ps(a + i),
+                                          _mm256_loadu_ps(b + i)));
+  }
+  for (; i < n; ++i) a[i] -= b[i];
+}
+
+S21_TARGET void ScaleF32(float *a, float value, int n) {
+  __m256 v = _mm256_set1_ps(value);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(a + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), v));
+  }
+  for (; i < n; ++i) a[i] *= value;
+}
+
+// Four 4x4 blocks, each two unpacks and two lane swaps.
+S21_TARGET void TransposeF64(const double *a, std::ptrdiff_t lda, double *b,
+                             std::ptrdiff_t ldb) {
+  for (int i = 0; i < kTransposeTile; i += 4) {
+    for (int j = 0; j < kTransposeTile; j += 4) {
+      const double *src = a + i * lda + j;
+      __m256d r0 = _mm256_loadu_pd(src);
+      __m256d r1 = _mm256_loadu_pd(src + lda);
+      __m256d r2 = _mm256_loadu_pd(src + 2 * lda);
+      __m256d r3 = _mm256_loadu_pd(src + 3 * lda);
+      __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+      __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+      __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+      __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+      double *dst = b + j * ldb + i;
+      _mm256_storeu_pd(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+      _mm256_storeu_pd(dst + ldb, _mm256_permute2f128_pd(t1, t3, 0x20));
+      _mm256_storeu_pd(dst + 2 * ldb, _mm256_permute2f128_pd(t0, t2, 0x31));
+      _mm256_storeu_pd(dst + 3 * ldb, _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+  }
+}
+
+// One 8x8 block: unpacks pair rows, shuffles gather quarter columns and
+// lane swaps join the halves.
+S21_TARGET void TransposeF32(const float *a, std::ptrdiff_t lda, float *b,
+                             std::ptrdiff_t ldb) {
+  __m256 r[8], t[8];
+#pragma GCC unroll 8
+  for (int i = 0; i < 8; ++i) r[i] = _mm256_loadu_ps(a + i * lda);
+#pragma GCC unroll 8
+  for (int i = 0; i < 8; i += 2) {
+    t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+    t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+  }
+#pragma GCC unroll 8
+  for (int i = 0; i < 8; i += 4) {
+    r[i] = _mm256_shuffle_ps(t[i], t[i + 2], 0x44);
+    r[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], 0xee);
+    r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0x44);
+    r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0xee);
+  }
+#pragma GCC unroll 8
+  for (int j = 0; j < 4; ++j) {
+    _mm256_storeu_ps(b + j * ldb, _mm256_permute2f128_ps(r[j], r[j + 4], 0x20));
+    _mm256_storeu_ps(b + (j + 4) * ldb,
+                     _mm256_permute2f128_ps(r[j], r[j + 4], 0x31));
+  }
+}
+
+}  // namespace
+
+template <>
+const Kernels<double> &Avx2Kernels<double>() noexcept {
+  static const Kernels<double> kernels = {
+      Isa::kAvx2, kMr, kNr, GemmF64, AddF64, SubF64, ScaleF64, TransposeF64};
+  return kernels;
+}
+
+template <>
+const Kernels<float> &Avx2Kernels<float>() noexcept {
+  static const Kernels<float> kernels = {
+      Isa::kAvx2, kMr, kFloatNr, GemmF32, AddF32, SubF32, ScaleF32,
+      TransposeF32};
+  return kernels;
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,210 @@
+#include "s21_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+#define S21_TARGET __attribute__((target("avx512f")))
+
+namespace s21 {
+
+namespace {
+
+constexpr int kMr = 8;
+constexpr int kNr = 16;
+constexpr int kFloatNr = 32;
+
+// 8x16 tile held in sixteen zmm accumulators, two per row.
+S21_TARGET void GemmF64(int kc, const double *a, const double *b, double alpha,
+                        double *c, std::ptrdiff_t ldc) {
+  __m512d acc[kMr][2];
+  for (int i = 0; i < kMr; ++i) acc[i][0] = acc[i][1] = _mm512_setzero_pd();
+  for (int p = 0; p < kc; ++p) {
+    __m512d b0 = _mm512_load_pd(b);
+    __m512d b1 = _mm512_load_pd(b + 8);
+#pragma GCC unroll 8
+    for (int i = 0; i < kMr; ++i) {
+      __m512d ai = _mm512_set1_pd(a[i]);
+      acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+      acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+    }
+    a += kMr;
+    b += kNr;
+  }
+  __m512d va = _mm512_set1_pd(alpha);
+  for (int i = 0; i < kMr; ++i) {
+    double *row = c + i * ldc;
+    _mm512_storeu_pd(row, _mm512_fmadd_pd(va, acc[i][0], _mm512_loadu_pd(row)));
+    _mm512_storeu_pd(row + 8, _mm512_fmadd_pd(va, acc[i][1],
+                                              _mm512_loadu_pd(row + 8)));
+  }
+}
+
+// Tails use masked loads and stores instead of a scalar loop.
+S21_TARGET void AddF64(double *a, const double *b, int n) {
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(a + i, _mm512_add_pd(_mm512_loadu_pd(a + i),
+                                          _mm512_loadu_pd(b + i)));
+  }
+  if (i < n) {
+    __mmask8 m = static_cast<__mmask8>((1u << (n - i)) - 1);
+    __m512d va = _mm512_maskz_loadu_pd(m, a + i);
+    __m512d vb = _mm512_maskz_loadu_pd(m, b + i);
+    _mm512_mask_storeu_pd(a + i, m, _mm512_add_pd(va, vb));
+  }
+}
+
+S21_TARGET void SubF64(double *a, const double *b, int n) {
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(a + i, _mm512_sub_pd(_mm512_loadu_pd(a + i),
+                                          _mm512_loadu_pd(b + i)));
+  }
+  if (i < n) {
+    __mmask8 m = static_cast<__mmask8>((1u << (n - i)) - 1);
+    __m512d va = _mm512_maskz_loadu_pd(m, a + i);
+    __m512d vb = _mm512_maskz_loadu_pd(m, b + i);
+    _mm512_mask_storeu_pd(a + i, m, _mm512_sub_pd(va, vb));
+  }
+}
+
+S21_TARGET void ScaleF64(double *a, double value, int n) {
+  __m512d v = _mm512_set1_pd(value);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(a + i, _mm512_mul_pd(_mm512_loadu_pd(a + i), v));
+  }
+  if (i < n) {
+    __mmask8 m = static_cast<__mmask8>((1u << (n - i)) - 1);
+    _mm512_mask_storeu_pd(a + i, m,
+                          _mm512_mul_pd(_mm512_maskz_loadu_pd(m, a + i), v));
+  }
+}
+
+// Single precision: 8x32 tile in the same sixteen accumulators.
+S21_TARGET void GemmF32(int kc, const float *a, const float *b, float alpha,
+                        float *c, std::ptrdiff_t ldc) {
+  __m512 acc[kMr][2];
+  for (int i = 0; i < kMr; ++i) acc[i][0] = acc[i][1] = _mm512_setzero_ps();
+  for (int p = 0; p < kc; ++p) {
+    __m512 b0 = _mm512_load_ps(b);
+    __m512 b1 = _mm512_load_ps(b + 16);
+#pragma GCC unroll 8
+    for (int i = 0; i < kMr; ++i) {
+      __m512 ai = _mm512_set1_ps(a[i]);
+      acc[i][0] = _mm512_fmadd_ps(ai, b0, acc[i][0]);
+      acc[i][1] = _mm512_fmadd_ps(ai, b1, acc[i][1]);
+    }
+    a += kMr;
+    b += kFloatNr;
+  }
+  __m512 va = _mm512_set1_ps(alpha);
+  for (int i = 0; i < kMr; ++i) {
+    float *row = c + i * ldc;
+    _mm512_storeu_ps(row, _mm512_fmadd_ps(va, acc[i][0], _mm512_loadu_ps(row)));
+    _mm512_storeu_ps(row + 16, _mm512_fmadd_ps(va, acc[i][1],
+                                               _mm512_loadu_ps(row + 16)));
+  }
+}
+
+S21_TARGET void AddF32(float *a, const float *b, int n) {
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(a + i, _mm512_add_ps(_mm512_loadu_ps(a + i),
+                                          _mm512_loadu_ps(b + i)));
+  }
+  if (i < n) {
+    __mmask16 m = static_cast<__mmask16>((1u << (n - i)) - 1);
+    __m512 va = _mm512_maskz_loadu_ps(m, a + i);
+    __m512 vb = _mm512_maskz_loadu_ps(m, b + i);
+    _mm512_mask_storeu_ps(a + i, m, _mm512_add_ps(va, vb));
+  }
+}
+
+S21_TARGET void SubF32(float *a, const float *b, int n) {
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(a + i, _mm512_sub_ps(_mm512_loadu_ps(a + i),
+                                          _mm512_loadu_ps(b + i)));
+  }
+  if (i < n) {
+    __mmask16 m = static_cast<__mmask16>((1u << (n - i)) - 1);
+    __m512 va = _mm512_maskz_loadu_ps(m, a + i);
+    __m512 vb = _mm512_maskz_loadu_ps(m, b + i);
+    _mm512_mask_storeu_ps(a + i, m, _mm512_sub_ps(va, vb));
+  }
+}
+
+S21_TARGET void ScaleF32(float *a, float value, int n) {
+  __m512 v = _mm512_set1_ps(value);
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(a + i, _mm512_mul_ps(_mm512_loadu_ps(a + i), v));
+  }
+  if (i < n) {
+    __mmask16 m = static_cast<__mmask16>((1u << (n - i)) - 1);
+    _mm512_mask_storeu_ps(a + i, m,
+                          _mm512_mul_ps(_mm512_maskz_loadu_ps(m, a + i), v));
+  }
+}
+
+// One 8x8 block in three rounds of two-source permutes: pairs of rows,
+// then pairs of 128-bit lanes, then the halves. (The unpack and lane
+// shuffle intrinsics trip -Wuninitialized in GCC 12 headers.)
+S21_TARGET void TransposeF64(const double *a, std::ptrdiff_t lda, double *b,
+                             std::ptrdiff_t ldb) {
+  const __m512i even = _mm512_setr_epi64(0, 8, 2, 10, 4, 12, 6, 14);
+  const __m512i odd = _mm512_setr_epi64(1, 9, 3, 11, 5, 13, 7, 15);
+  const __m512i low = _mm512_setr_epi64(0, 1, 4, 5, 8, 9, 12, 13);
+  const __m512i high = _mm512_setr_epi64(2, 3, 6, 7, 10, 11, 14, 15);
+  __m512d r[8], t[8];
+#pragma GCC unroll 8
+  for (int i = 0; i < 8; ++i) r[i] = _mm512_loadu_pd(a + i * lda);
+#pragma GCC unroll 8
+  for (int i = 0; i < 8; i += 2) {
+    t[i] = _mm512_permutex2var_pd(r[i], even, r[i + 1]);
+    t[i + 1] = _mm512_permutex2var_pd(r[i], odd, r[i + 1]);
+  }
+  // r[q + k]: columns k (lanes 0-1) and k + 4 (lanes 2-3) of rows q to
+  // q + 3, in the order k = 0, 2, 1, 3.
+#pragma GCC unroll 8
+  for (int q = 0; q < 8; q += 4) {
+    r[q] = _mm512_permutex2var_pd(t[q], low, t[q + 2]);
+    r[q + 1] = _mm512_permutex2var_pd(t[q], high, t[q + 2]);
+    r[q + 2] = _mm512_permutex2var_pd(t[q + 1], low, t[q + 3]);
+    r[q + 3] = _mm512_permutex2var_pd(t[q + 1], high, t[q + 3]);
+  }
+  constexpr int kColumn[4] = {0, 2, 1, 3};
+#pragma GCC unroll 8
+  for (int k = 0; k < 4; ++k) {
+    const int j = kColumn[k];
+    _mm512_storeu_pd(b + j * ldb, _mm512_permutex2var_pd(r[k], low, r[k + 4]));
+    _mm512_storeu_pd(b + (j + 4) * ldb,
+                     _mm512_permutex2var_pd(r[k], high, r[k + 4]));
+  }
+}
+
+}  // namespace
+
+template <>
+const Kernels<double> &Avx512Kernels<double>() noexcept {
+  static const Kernels<double> kernels = {
+      Isa::kAvx512, kMr,      kNr,         GemmF64, AddF64,
+      SubF64,       ScaleF64, TransposeF64};
+  return kernels;
+}
+
+template <>
+const Kernels<float> &Avx512Kernels<float>() noexcept {
+  // An 8x8 float block fits ymm registers: the AVX2 transpose is as fast.
+  static const Kernels<float> kernels = {
+      Isa::kAvx512, kMr,      kFloatNr,
+      GemmF32,      AddF32,   SubF32,
+      ScaleF32,     Avx2Kernels<float>().transpose};
+  return kernels;
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,166 @@
+#include "s21_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <emmintrin.h>
+
+#define S21_TARGET __attribute__((target("sse2")))
+
+namespace s21 {
+
+namespace {
+
+constexpr int kMr = 4;
+constexpr int kNr = 4;
+constexpr int kFloatNr = 8;
+
+// 4x4 tile held in eight xmm accumulators, two per row.
+S21_TARGET void GemmF64(int kc, const double *a, const double *b, double alpha,
+                        double *c, std::ptrdiff_t ldc) {
+  __m128d acc[kMr][2];
+  for (int i = 0; i < kMr; ++i) acc[i][0] = acc[i][1] = _mm_setzero_pd();
+  for (int p = 0; p < kc; ++p) {
+    __m128d b0 = _mm_load_pd(b);
+    __m128d b1 = _mm_load_pd(b + 2);
+#pragma GCC unroll 8
+    for (int i = 0; i < kMr; ++i) {
+      __m128d ai = _mm_load1_pd(a + i);
+      acc[i][0] = _mm_add_pd(acc[i][0], _mm_mul_pd(ai, b0));
+      acc[i][1] = _mm_add_pd(acc[i][1], _mm_mul_pd(ai, b1));
+    }
+    a += kMr;
+    b += kNr;
+  }
+  __m128d va = _mm_set1_pd(alpha);
+  for (int i = 0; i < kMr; ++i) {
+    double *row = c + i * ldc;
+    _mm_storeu_pd(row, _mm_add_pd(_mm_loadu_pd(row),
+                                  _mm_mul_pd(va, acc[i][0])));
+    _mm_storeu_pd(row + 2, _mm_add_pd(_mm_loadu_pd(row + 2),
+                                      _mm_mul_pd(va, acc[i][1])));
+  }
+}
+
+S21_TARGET void AddF64(double *a, const double *b, int n) {
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(a + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+  }
+  for (; i < n; ++i) a[i] += b[i];
+}
+
+S21_TARGET void SubF64(double *a, const double *b, int n) {
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(a + i, _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+  }
+  for (; i < n; ++i) a[i] -= b[i];
+}
+
+S21_TARGET void ScaleF64(double *a, double value, int n) {
+  __m128d v = _mm_set1_pd(value);
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(a + i, _mm_mul_pd(_mm_loadu_pd(a + i), v));
+  }
+  for (; i < n; ++i) a[i] *= value;
+}
+
+// Single precision: 4x8 tile, two xmm accumulators per row as above.
+S21_TARGET void GemmF32(int kc, const float *a, const float *b, float alpha,
+                        float *c, std::ptrdiff_t ldc) {
+  __m128 acc[kMr][2];
+  for (int i = 0; i < kMr; ++i) acc[i][0] = acc[i][1] = _mm_setzero_ps();
+  for (int p = 0; p < kc; ++p) {
+    __m128 b0 = _mm_load_ps(b);
+    __m128 b1 = _mm_load_ps(b + 4);
+#pragma GCC unroll 8
+    for (int i = 0; i < kMr; ++i) {
+      __m128 ai = _mm_load1_ps(a + i);
+      acc[i][0] = _mm_add_ps(acc[i][0], _mm_mul_ps(ai, b0));
+      acc[i][1] = _mm_add_ps(acc[i][1], _mm_mul_ps(ai, b1));
+    }
+    a += kMr;
+    b += kFloatNr;
+  }
+  __m128 va = _mm_set1_ps(alpha);
+  for (int i = 0; i < kMr; ++i) {
+    float *row = c + i * ldc;
+    _mm_storeu_ps(row, _mm_add_ps(_mm_loadu_ps(row),
+                                  _mm_mul_ps(va, acc[i][0])));
+    _mm_storeu_ps(row + 4, _mm_add_ps(_mm_loadu_ps(row + 4),
+                                      _mm_mul_ps(va, acc[i][1])));
+  }
+}
+
+S21_TARGET void AddF32(float *a, const float *b, int n) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(a + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+  for (; i < n; ++i) a[i] += b[i];
+}
+
+S21_TARGET void SubF32(float *a, const float *b, int n) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(a + i, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+  for (; i < n; ++i) a[i] -= b[i];
+}
+
+S21_TARGET void ScaleF32(float *a, float value, int n) {
+  __m128 v = _mm_set1_ps(value);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(a + i, _mm_mul_ps(_mm_loadu_ps(a + i), v));
+  }
+  for (; i < n; ++i) a[i] *= value;
+}
+
+// 2x2 blocks: one unpack pair per block.
+S21_TARGET void TransposeF64(const double *a, std::ptrdiff_t lda, double *b,
+                             std::ptrdiff_t ldb) {
+  for (int i = 0; i < kTransposeTile; i += 2) {
+    for (int j = 0; j < kTransposeTile; j += 2) {
+      __m128d r0 = _mm_loadu_pd(a + i * lda + j);
+      __m128d r1 = _mm_loadu_pd(a + (i + 1) * lda + j);
+      _mm_storeu_pd(b + j * ldb + i, _mm_unpacklo_pd(r0, r1));
+      _mm_storeu_pd(b + (j + 1) * ldb + i, _mm_unpackhi_pd(r0, r1));
+    }
+  }
+}
+
+// 4x4 blocks through _MM_TRANSPOSE4_PS.
+S21_TARGET void TransposeF32(const float *a, std::ptrdiff_t lda, float *b,
+                             std::ptrdiff_t ldb) {
+  for (int i = 0; i < kTransposeTile; i += 4) {
+    for (int j = 0; j < kTransposeTile; j += 4) {
+      __m128 r[4];
+      for (int k = 0; k < 4; ++k) r[k] = _mm_loadu_ps(a + (i + k) * lda + j);
+      _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+      for (int k = 0; k < 4; ++k) _mm_storeu_ps(b + (j + k) * ldb + i, r[k]);
+    }
+  }
+}
+
+}  // namespace
+
+template <>
+const Kernels<double> &Sse2Kernels<double>() noexcept {
+  static const Kernels<double> kernels = {
+      Isa::kSse2, kMr, kNr, GemmF64, AddF64, SubF64, ScaleF64, TransposeF64};
+  return kernels;
+}
+
+template <>
+const Kernels<float> &Sse2Kernels<float>() noexcept {
+  static const Kernels<float> kernels = {
+      Isa::kSse2, kMr, kFloatNr, GemmF32, AddF32, SubF32, ScaleF32,
+      TransposeF32};
+  return kernels;
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,217 @@
+#include "s21_lu.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "s21_gemm.h"
+
+namespace s21 {
+
+namespace {
+
+template <class T>
+void SwapRows(T *a, std::ptrdiff_t lda, int n, int r1, int r2) {
+  if (r1 != r2) {
+    std::swap_ranges(a + r1 * lda, a + r1 * lda + n, a + r2 * lda);
+  }
+}
+
+// Unblocked LU of the columns [k0, k0 + kb) over rows [k0, n). Row swaps
+// are applied to whole rows so the rest of the matrix stays consistent.
+template <class T>
+int FactorPanel(int n, int k0, int kb, T *a, std::ptrdiff_t lda,
+                int *pivots) {
+  int info = 0;
+  const int k1 = k0 + kb;
+  for (int j = k0; j < k1; ++j) {
+    int pivot = j;
+    RealOf<T> best = PivotMagnitude(a[j * lda + j]);
+    for (int i = j + 1; i < n; ++i) {
+      RealOf<T> value = PivotMagnitude(a[i * lda + j]);
+      if (value > best) {
+        best = value;
+        pivot = i;
+      }
+    }
+    pivots[j] = pivot;
+    SwapRows(a, lda, n, j, pivot);
+    const T *row_j = a + j * lda;
+    if (row_j[j] == T(0)) {
+      if (info == 0) info = j + 1;
+      continue;
+    }
+    const T inv = T(1) / row_j[j];
+    for (int i = j + 1; i < n; ++i) {
+      T *row_i = a + i * lda;
+      T l = row_i[j] *= inv;
+      for (int p = j + 1; p < k1; ++p) row_i[p] -= l * row_j[p];
+    }
+  }
+  return info;
+}
+
+// U12 = L11^-1 * A12, where L11 is the unit lower kb x kb block at
+// (k0, k0) and A12 spans columns [k0 + kb, n) of the same rows.
+template <class T>
+void SolveUpperPanel(int n, int k0, int kb, T *a, std::ptrdiff_t lda) {
+  const int k1 = k0 + kb;
+  for (int i = k0 + 1; i < k1; ++i) {
+    T *row_i = a + i * lda;
+    for (int p = k0; p < i; ++p) {
+      const T l = row_i[p];
+      const T *row_p = a + p * lda;
+      for (int j = k1; j < n; ++j) row_i[j] -= l * row_p[j];
+    }
+  }
+}
+
+// Solves L * X = B in place for the unit lower triangle of lu.
+template <class T>
+void SolveLower(int n, int nrhs, const T *lu, std::ptrdiff_t lda,
+                T *b, std::ptrdiff_t ldb) {
+  for (int i0 = 0; i0 < n; i0 += kLuBlock) {
+    const int i1 = std::min(n, i0 + kLuBlock);
+    if (i0 > 0) {
+      Gemm(i1 - i0, nrhs, i0, -1.0, lu + i0 * lda, lda, b, ldb, 1.0,
+           b + i0 * ldb, ldb);
+    }
+    for (int i = i0 + 1; i < i1; ++i) {
+      T *row_i = b + i * ldb;
+      for (int p = i0; p < i; ++p) {
+        const T l = lu[i * lda + p];
+        const T *row_p = b + p * ldb;
+        for (int j = 0; j < nrhs; ++j) row_i[j] -= l * row_p[j];
+      }
+    }
+  }
+}
+
+// Solves U * X = B in place for the upper triangle of lu.
+template <class T>
+void SolveUpper(int n, int nrhs, const T *lu, std::ptrdiff_t lda,
+                T *b, std::ptrdiff_t ldb) {
+  for (int i0 = (n - 1) / kLuBlock * kLuBlock; i0 >= 0; i0 -= kLuBlock) {
+    const int i1 = std::min(n, i0 + kLuBlock);
+    if (i1 < n) {
+      Gemm(i1 - i0, nrhs, n - i1, -1.0, lu + i0 * lda + i1, lda, b + i1 * ldb,
+           ldb, 1.0, b + i0 * ldb, ldb);
+    }
+    for (int i = i1 - 1; i >= i0; --i) {
+      T *row_i = b + i * ldb;
+      for (int p = i + 1; p < i1; ++p) {
+        const T u = lu[i * lda + p];
+        const T *row_p = b + p * ldb;
+        for (int j = 0; j < nrhs; ++j) row_i[j] -= u * row_p[j];
+      }
+      const T inv = T(1) / lu[i * lda + i];
+      for (int j = 0; j < nrhs; ++j) row_i[j] *= inv;
+    }
+  }
+}
+
+}  // namespace
+
+template <class T>
+int LuFactor(int n, T *a, std::ptrdiff_t lda, int *pivots) {
+  int info = 0;
+  for (int k0 = 0; k0 < n; k0 += kLuBlock) {
+    const int kb = std::min(kLuBlock, n - k0);
+    const int k1 = k0 + kb;
+    int panel_info = FactorPanel(n, k0, kb, a, lda, pivots);
+    if (info == 0) info = panel_info;
+    if (k1 < n) {
+      SolveUpperPanel(n, k0, kb, a, lda);
+      Gemm(n - k1, n - k1, kb, -1.0, a + k1 * lda + k0, lda,
+           a + k0 * lda + k1, lda, 1.0, a + k1 * lda + k1, lda);
+    }
+  }
+  return info;
+}
+
+template <class T>
+int LuNullity(int n, const T *lu, std::ptrdiff_t lda,
+              int *first) noexcept {
+  using Real = RealOf<T>;
+  Real largest = 0;
+  for (int i = 0; i < n; ++i) {
+    largest = std::max(largest, Real(std::abs(lu[i * lda + i])));
+  }
+  const Real tolerance = n * std::numeric_limits<Real>::epsilon() * largest;
+  int nullity = 0;
+  for (int i = 0; i < n; ++i) {
+    if (std::abs(lu[i * lda + i]) <= tolerance) {
+      if (nullity++ == 0 && first != nullptr) *first = i;
+    }
+  }
+  return nullity;
+}
+
+template <class T>
+bool LuIsSingular(int n, const T *lu, std::ptrdiff_t lda) noexcept {
+  return LuNullity(n, lu, lda) > 0;
+}
+
+template <class T>
+T LuDeterminant(int n, const T *lu, std::ptrdiff_t lda,
+                     const int *pivots) noexcept {
+  T det = T(1);
+  for (int i = 0; i < n; ++i) {
+    det *= lu[i * lda + i];
+    if (pivots[i] != i) det = -det;
+  }
+  return det;
+}
+
+template <class T>
+void LuNullVectors(int n, const T *lu, std::ptrdiff_t lda,
+                   const int *pivots, int k, T *x, T *y) noexcept {
+  // U * x = 0: x(k) = 1, x below k is zero, back substitution above k.
+  std::fill(x, x + n, T(0));
+  x[k] = T(1);
+  for (int i = k - 1; i >= 0; --i) {
+    T sum = T(0);
+    for (int p = i + 1; p <= k; ++p) sum += lu[i * lda + p] * x[p];
+    x[i] = -sum / lu[i * lda + i];
+  }
+  // A^T = U^T * L^T * P, so solve U^T * z = 0 with z(k) = 1, then
+  // L^T * w = z and y = P^T * w.
+  std::fill(y, y + n, T(0));
+  y[k] = T(1);
+  for (int i = k + 1; i < n; ++i) {
+    T sum = T(0);
+    for (int p = k; p < i; ++p) sum += lu[p * lda + i] * y[p];
+    y[i] = -sum / lu[i * lda + i];
+  }
+  for (int i = n - 1; i >= 0; --i) {
+    T sum = T(0);
+    for (int p = i + 1; p < n; ++p) sum += lu[p * lda + i] * y[p];
+    y[i] -= sum;
+  }
+  for (int i = n - 1; i >= 0; --i) std::swap(y[i], y[pivots[i]]);
+}
+
+template <class T>
+void LuSolve(int n, int nrhs, const T *lu, std::ptrdiff_t lda,
+             const int *pivots, T *b, std::ptrdiff_t ldb) {
+  for (int i = 0; i < n; ++i) SwapRows(b, ldb, nrhs, i, pivots[i]);
+  SolveLower(n, nrhs, lu, lda, b, ldb);
+  SolveUpper(n, nrhs, lu, lda, b, ldb);
+}
+
+#define S21_INSTANTIATE_LU(T)                                                \
+  template int LuFactor<T>(int, T *, std::ptrdiff_t, int *);                 \
+  template int LuNullity<T>(int, const T *, std::ptrdiff_t, int *) noexcept; \
+  template bool LuIsSingular<T>(int, const T *, std::ptrdiff_t) noexcept;    \
+  template T LuDeterminant<T>(int, const T *, std::ptrdiff_t,                \
+                              const int *) noexcept;                         \
+  template void LuNullVectors<T>(int, const T *, std::ptrdiff_t,             \
+                                 const int *, int, T *, T *) noexcept;       \
+  template void LuSolve<T>(int, int, const T *, std::ptrdiff_t, const int *, \
+                           T *, std::ptrdiff_t);
+
+S21_INSTANTIATE_LU(float)
+S21_INSTANTIATE_LU(double)
+S21_INSTANTIATE_LU(std::complex<double>)
+
+}  // namespace s21
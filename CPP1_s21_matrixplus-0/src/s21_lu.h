@@ -0,0 +1,61 @@
+#ifndef SRC_S21_LU_H_
+#define SRC_S21_LU_H_
+
+#include <cstddef>
+
+#include "s21_scalar_traits.h"
+
+namespace s21 {
+
+// Panel width of the blocked factorization; the trailing update of each
+// panel is a rank-kLuBlock GEMM.
+constexpr int kLuBlock = 64;
+
+// The routines below are defined for float, double and
+// std::complex<double>; complex pivots are chosen by PivotMagnitude.
+//
+// Factors the n x n row-major matrix a (leading dimension lda) in place as
+// P * A = L * U with partial pivoting. L is unit lower triangular and U is
+// upper triangular; both overwrite a. pivots[i] receives the row swapped
+// with row i at step i.
+//
+// Returns 0 on success, or k + 1 if U(k, k) is exactly zero, in which case
+// the factorization is completed but U is singular.
+template <class T>
+int LuFactor(int n, T *a, std::ptrdiff_t lda, int *pivots);
+
+// Number of pivots that are zero relative to the largest one
+// (|U(k, k)| <= n * eps * max |U(i, i)|), an estimate of the nullity of A
+// at working precision. The index of the first such pivot is stored in
+// *first when first is not null.
+template <class T>
+int LuNullity(int n, const T *lu, std::ptrdiff_t lda,
+              int *first = nullptr) noexcept;
+
+// True if A is singular to working precision, see LuNullity.
+template <class T>
+bool LuIsSingular(int n, const T *lu, std::ptrdiff_t lda) noexcept;
+
+// Product of the pivots times the sign of the row permutation.
+template <class T>
+T LuDeterminant(int n, const T *lu, std::ptrdiff_t lda,
+                     const int *pivots) noexcept;
+
+// For factors with exactly one negligible pivot U(k, k), computes x with
+// A * x = 0 and y with A^T * y = 0 (both scaled so that the entry at k of
+// the triangular solution is 1).
+template <class T>
+void LuNullVectors(int n, const T *lu, std::ptrdiff_t lda,
+                   const int *pivots, int k, T *x, T *y) noexcept;
+
+// Overwrites the n x nrhs row-major matrix b with A^-1 * b, given the
+// factors and pivots produced by LuFactor. The triangular solves run in
+// kLuBlock row blocks whose off-diagonal updates go through Gemm, so all
+// right-hand sides are processed together.
+template <class T>
+void LuSolve(int n, int nrhs, const T *lu, std::ptrdiff_t lda,
+             const int *pivots, T *b, std::ptrdiff_t ldb);
+
+}  // namespace s21
+
+#endif
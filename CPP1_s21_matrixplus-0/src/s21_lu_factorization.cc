@@ -0,0 +1,98 @@
+#include "s21_lu_factorization.h"
+
+#include <stdexcept>
+
+#include "s21_lu.h"
+
+template <class T>
+S21BasicLuFactorization<T>::S21BasicLuFactorization(const S21BasicMatrix<T> &a)
+    : S21BasicLuFactorization(a, a.GetResource()) {}
+
+template <class T>
+S21BasicLuFactorization<T>::S21BasicLuFactorization(
+    const S21BasicMatrix<T> &a, std::pmr::memory_resource *resource)
+    : lu_(a, resource), pivots_(resource) {
+  if (a.Data() == nullptr) throw std::runtime_error("Error: matrix is null");
+  if (a.GetRows() != a.GetCols()) {
+    throw std::invalid_argument("Error: matrix is not square");
+  }
+  pivots_.resize(a.GetRows());
+  s21::LuFactor(Size(), lu_.Data(), lu_.Stride(), pivots_.data());
+}
+
+template <class T>
+int S21BasicLuFactorization<T>::Size() const noexcept {
+  return lu_.GetRows();
+}
+
+template <class T>
+bool S21BasicLuFactorization<T>::IsSingular() const noexcept {
+  return s21::LuIsSingular(Size(), lu_.Data(), lu_.Stride());
+}
+
+template <class T>
+T S21BasicLuFactorization<T>::Determinant() const noexcept {
+  // The pivot product of a singular matrix is rounding noise, not zero.
+  if (IsSingular()) return T(0);
+  return s21::LuDeterminant(Size(), lu_.Data(), lu_.Stride(), pivots_.data());
+}
+
+template <class T>
+void S21BasicLuFactorization<T>::CheckSolvable(int rows) const {
+  if (rows != Size()) throw std::runtime_error("Error: sizes are not equal");
+  if (IsSingular()) throw std::logic_error("Determinant is 0");
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicLuFactorization<T>::Solve(
+    const S21BasicMatrix<T> &b) const {
+  S21BasicMatrix<T> x(b, b.GetResource());
+  SolveInPlace(x);
+  return x;
+}
+
+template <class T>
+void S21BasicLuFactorization<T>::SolveInPlace(S21BasicMatrix<T> &b) const {
+  if (b.Data() == nullptr) throw std::runtime_error("Error: matrix is null");
+  CheckSolvable(b.GetRows());
+  s21::LuSolve(Size(), b.GetCols(), lu_.Data(), lu_.Stride(), pivots_.data(),
+               b.Data(), b.Stride());
+}
+
+template <class T>
+std::vector<T> S21BasicLuFactorization<T>::Solve(
+    const std::vector<T> &b) const {
+  std::vector<T> x(b);
+  SolveInPlace(x);
+  return x;
+}
+
+template <class T>
+void S21BasicLuFactorization<T>::SolveInPlace(std::vector<T> &b) const {
+  CheckSolvable(static_cast<int>(b.size()));
+  s21::LuSolve(Size(), 1, lu_.Data(), lu_.Stride(), pivots_.data(), b.data(),
+               1);
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicLuFactorization<T>::Inverse() const {
+  S21BasicMatrix<T> inverse(Size(), Size(), lu_.GetResource());
+  for (int i = 0; i < Size(); i++) inverse(i, i) = T(1);
+  SolveInPlace(inverse);
+  return inverse;
+}
+
+template <class T>
+const S21BasicMatrix<T> &S21BasicLuFactorization<T>::Factors() const noexcept {
+  return lu_;
+}
+
+template <class T>
+const std::pmr::vector<int> &S21BasicLuFactorization<T>::Pivots()
+    const noexcept {
+  return pivots_;
+}
+
+template class S21BasicLuFactorization<float>;
+template class S21BasicLuFactorization<double>;
+template class S21BasicLuFactorization<std::complex<double>>;
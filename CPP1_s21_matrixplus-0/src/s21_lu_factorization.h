@@ -0,0 +1,71 @@
+#ifndef SRC_S21_LU_FACTORIZATION_H_
+#define SRC_S21_LU_FACTORIZATION_H_
+
+#include <complex>
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// LU factorization with partial pivoting, P * A = L * U, kept for repeated
+// solves: the blocked factorization (see s21_lu.h) costs O(n^3) once, and
+// every solve afterwards O(n^2) per right-hand side. Instantiated for
+// float, double and std::complex<double>.
+//
+// A singular matrix still factors: IsSingular() reports it (a pivot that
+// is zero relative to the largest, see s21::LuNullity), Determinant()
+// returns 0, and Solve and Inverse throw std::logic_error as
+// S21BasicMatrix::InverseMatrix does.
+//
+// The Cholesky and QR factorizations keep the same interface for
+// construction and solving, documented here once: the constructors, the
+// matrix and vector Solve and SolveInPlace, and Inverse.
+template <class T>
+class S21BasicLuFactorization {
+ public:
+  using Scalar = T;
+
+  // Factors a square matrix; throws std::runtime_error if a is null and
+  // std::invalid_argument if it is not square. The factors use a's
+  // resource unless one is given.
+  explicit S21BasicLuFactorization(const S21BasicMatrix<T> &a);
+  S21BasicLuFactorization(const S21BasicMatrix<T> &a,
+                          std::pmr::memory_resource *resource);
+
+  int Size() const noexcept;
+  bool IsSingular() const noexcept;
+  T Determinant() const noexcept;
+
+  // X with A * X = B for the Size() x k matrix B (std::runtime_error if
+  // the rows differ), in B's resource. All columns are solved together,
+  // so the triangular updates run as GEMM.
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &b) const;
+  // Same, overwriting b: nothing is allocated.
+  void SolveInPlace(S21BasicMatrix<T> &b) const;
+  // x with A * x = b for a vector of Size() elements.
+  std::vector<T> Solve(const std::vector<T> &b) const;
+  void SolveInPlace(std::vector<T> &b) const;
+  // A^-1, solved from the identity.
+  S21BasicMatrix<T> Inverse() const;
+
+  // L strictly below the diagonal (its unit diagonal is implied) and U on
+  // and above it; row i was swapped with row Pivots()[i] at step i.
+  const S21BasicMatrix<T> &Factors() const noexcept;
+  const std::pmr::vector<int> &Pivots() const noexcept;
+
+ private:
+  S21BasicMatrix<T> lu_;
+  std::pmr::vector<int> pivots_;
+  void CheckSolvable(int rows) const;
+};
+
+using S21LuFactorization = S21BasicLuFactorization<double>;
+using S21FloatLuFactorization = S21BasicLuFactorization<float>;
+using S21ComplexLuFactorization =
+    S21BasicLuFactorization<std::complex<double>>;
+
+extern template class S21BasicLuFactorization<float>;
+extern template class S21BasicLuFactorization<double>;
+extern template class S21BasicLuFactorization<std::complex<double>>;
+
+#endif
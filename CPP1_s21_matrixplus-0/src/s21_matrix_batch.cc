@@ -0,0 +1,517 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "s21_kernels.h"
+#include "s21_scratch_buffer.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+constexpr std::size_t kPackBytes = 64;
+
+// One element of a pack: kPackBytes of T, element (i, j) of every member.
+template <class T>
+struct Lanes {
+  typedef T Type __attribute__((vector_size(kPackBytes), __may_alias__));
+};
+
+// The pack kernels are written once with GCC vector extensions and
+// compiled for each instruction set by the wrappers further down, which
+// inline them under their own target attribute.
+#define S21_INLINE inline __attribute__((always_inline))
+
+template <class T>
+S21_INLINE void MulPacks(const T *a, const T *b, T *c, int m, int k, int n,
+                         long packs) {
+  using V = typename Lanes<T>::Type;
+  const V *va = reinterpret_cast<const V *>(a);
+  const V *vb = reinterpret_cast<const V *>(b);
+  V *vc = reinterpret_cast<V *>(c);
+  for (long p = 0; p < packs; ++p) {
+    for (int i = 0; i < m; ++i) {
+      const V *row = va + i * k;
+      int j = 0;
+      // Four independent accumulators hide the FMA latency.
+      for (; j + 4 <= n; j += 4) {
+        V acc0 = {}, acc1 = {}, acc2 = {}, acc3 = {};
+        for (int q = 0; q < k; ++q) {
+          const V *col = vb + q * n + j;
+          acc0 += row[q] * col[0];
+          acc1 += row[q] * col[1];
+          acc2 += row[q] * col[2];
+          acc3 += row[q] * col[3];
+        }
+        vc[i * n + j] = acc0;
+        vc[i * n + j + 1] = acc1;
+        vc[i * n + j + 2] = acc2;
+        vc[i * n + j + 3] = acc3;
+      }
+      for (; j < n; ++j) {
+        V acc = {};
+        for (int q = 0; q < k; ++q) acc += row[q] * vb[q * n + j];
+        vc[i * n + j] = acc;
+      }
+    }
+    va += m * k;
+    vb += k * n;
+    vc += m * n;
+  }
+}
+
+// Row of the largest |w(r, k)| for r >= k, per lane.
+template <class V, class M>
+S21_INLINE void FindPivot(const V *w, int stride, int n, int k, M &pivot) {
+  const V zero = {};
+  V x = w[k * stride + k];
+  V best = x < zero ? -x : x;
+  pivot = M{} + k;
+  for (int r = k + 1; r < n; ++r) {
+    x = w[r * stride + k];
+    V magnitude = x < zero ? -x : x;
+    M larger = magnitude > best;
+    best = larger ? magnitude : best;
+    pivot = larger ? M{} + r : pivot;
+  }
+}
+
+// Swaps columns [from, to) of row k with the pivot row in the lanes whose
+// pivot is not k. Rows no lane picked are skipped.
+template <class V, class M>
+S21_INLINE void SwapPivotRows(V *w, int stride, int n, int k, const M &pivot,
+                              int from, int to) {
+  constexpr int kLanes = sizeof(V) / sizeof(w[0][0]);
+  for (int r = k + 1; r < n; ++r) {
+    bool picked = false;
+    for (int l = 0; l < kLanes; ++l) picked |= pivot[l] == r;
+    if (!picked) continue;
+    M take = pivot == (M{} + r);
+    for (int j = from; j < to; ++j) {
+      V x = w[k * stride + j];
+      V y = w[r * stride + j];
+      w[k * stride + j] = take ? y : x;
+      w[r * stride + j] = take ? x : y;
+    }
+  }
+}
+
+// Determinants by elimination with partial pivoting, one lane per member.
+// scratch holds n * n lanes.
+template <class T>
+S21_INLINE void DeterminantPacks(const T *a, T *dets, T *scratch, int n,
+                                 long packs) {
+  using V = typename Lanes<T>::Type;
+  using M = decltype(V{} < V{});
+  const V zero = {};
+  const V one = zero + 1;
+  const V *va = reinterpret_cast<const V *>(a);
+  V *w = reinterpret_cast<V *>(scratch);
+  for (long p = 0; p < packs; ++p, va += n * n) {
+    for (int e = 0; e < n * n; ++e) w[e] = va[e];
+    V det = one;
+    for (int k = 0; k < n; ++k) {
+      M pivot;
+      FindPivot(w, n, n, k, pivot);
+      SwapPivotRows(w, n, n, k, pivot, k, n);
+      V value = w[k * n + k];
+      det = pivot != (M{} + k) ? -det : det;
+      det *= value;
+      // Singular lanes skip the update instead of spreading NaNs.
+      V inverse = value == zero ? zero : one / value;
+      for (int r = k + 1; r < n; ++r) {
+        V factor = w[r * n + k] * inverse;
+        for (int j = k + 1; j < n; ++j) w[r * n + j] -= factor * w[k * n + j];
+      }
+    }
+    std::memcpy(dets + p * sizeof(V) / sizeof(T), &det, sizeof(V));
+  }
+}
+
+// Gauss-Jordan on [A | I] with partial pivoting; dets receives the
+// determinants so the caller can reject singular members. scratch holds
+// n * 2n lanes.
+template <class T>
+S21_INLINE void InversePacks(const T *a, T *inv, T *dets, T *scratch, int n,
+                             long packs) {
+  using V = typename Lanes<T>::Type;
+  using M = decltype(V{} < V{});
+  const V zero = {};
+  const V one = zero + 1;
+  const int stride = 2 * n;
+  const V *va = reinterpret_cast<const V *>(a);
+  V *vi = reinterpret_cast<V *>(inv);
+  V *w = reinterpret_cast<V *>(scratch);
+  for (long p = 0; p < packs; ++p, va += n * n, vi += n * n) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        w[i * stride + j] = va[i * n + j];
+        w[i * stride + n + j] = i == j ? one : zero;
+      }
+    }
+    V det = one;
+    for (int k = 0; k < n; ++k) {
+      M pivot;
+      FindPivot(w, stride, n, k, pivot);
+      SwapPivotRows(w, stride, n, k, pivot, k, stride);
+      V value = w[k * stride + k];
+      det = pivot != (M{} + k) ? -det : det;
+      det *= value;
+      V inverse = value == zero ? zero : one / value;
+      for (int j = k; j < stride; ++j) w[k * stride + j] *= inverse;
+      for (int r = 0; r < n; ++r) {
+        if (r == k) continue;
+        V factor = w[r * stride + k];
+        for (int j = k; j < stride; ++j) {
+          w[r * stride + j] -= factor * w[k * stride + j];
+        }
+      }
+    }
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) vi[i * n + j] = w[i * stride + n + j];
+    }
+    std::memcpy(dets + p * sizeof(V) / sizeof(T), &det, sizeof(V));
+  }
+}
+
+template <class T>
+struct BatchKernels {
+  void (*mul)(const T *a, const T *b, T *c, int m, int k, int n, long packs);
+  void (*determinant)(const T *a, T *dets, T *scratch, int n, long packs);
+  void (*inverse)(const T *a, T *inv, T *dets, T *scratch, int n,
+                  long packs);
+};
+
+#define S21_BATCH_KERNELS(Suffix, ...)                                       \
+  template <class T>                                                         \
+  __VA_ARGS__ void Mul##Suffix(const T *a, const T *b, T *c, int m, int k,   \
+                               int n, long packs) {                          \
+    MulPacks(a, b, c, m, k, n, packs);                                       \
+  }                                                                          \
+  template <class T>                                                         \
+  __VA_ARGS__ void Determinant##Suffix(const T *a, T *dets, T *scratch,      \
+                                       int n, long packs) {                  \
+    DeterminantPacks(a, dets, scratch, n, packs);                            \
+  }                                                                          \
+  template <class T>                                                         \
+  __VA_ARGS__ void Inverse##Suffix(const T *a, T *inv, T *dets, T *scratch, \
+                                   int n, long packs) {                      \
+    InversePacks(a, inv, dets, scratch, n, packs);                           \
+  }                                                                          \
+  template <class T>                                                         \
+  const BatchKernels<T> k##Suffix##Kernels = {                               \
+      Mul##Suffix<T>, Determinant##Suffix<T>, Inverse##Suffix<T>};
+
+S21_BATCH_KERNELS(Generic)
+#if defined(__x86_64__) || defined(__i386__)
+S21_BATCH_KERNELS(Avx2, __attribute__((target("avx2,fma"))))
+S21_BATCH_KERNELS(Avx512, __attribute__((target("avx512f"))))
+#endif
+
+// Follows the level of the element-wise kernels, so s21::SetIsa applies.
+template <class T>
+const BatchKernels<T> &ActiveBatchKernels() noexcept {
+  switch (s21::ActiveKernels<T>().isa) {
+#if defined(__x86_64__) || defined(__i386__)
+    case s21::Isa::kAvx512:
+      return kAvx512Kernels<T>;
+    case s21::Isa::kAvx2:
+      return kAvx2Kernels<T>;
+#endif
+    default:
+      return kGenericKernels<T>;
+  }
+}
+
+// Packs per task so that each task does at least kParallelMinFlops.
+long PackGrain(long work_per_pack) {
+  return std::max(1L, s21::kParallelMinFlops / std::max(1L, work_per_pack));
+}
+
+}  // namespace
+
+template <class T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch() noexcept
+    : count_(0),
+      rows_(0),
+      cols_(0),
+      data_(nullptr),
+      resource_(std::pmr::get_default_resource()) {}
+
+template <class T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(int count, int rows, int cols,
+                                            std::pmr::memory_resource *resource)
+    : count_(count),
+      rows_(rows),
+      cols_(cols),
+      data_(nullptr),
+      resource_(resource) {
+  if (count <= 0 || rows <= 0 || cols <= 0) {
+    throw std::invalid_argument("Count, rows or columns is less or equal 0");
+  }
+  CreateBatch();
+}
+
+template <class T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(const S21BasicMatrixBatch &other)
+    : S21BasicMatrixBatch(other, std::pmr::get_default_resource()) {}
+
+template <class T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(
+    const S21BasicMatrixBatch &other, std::pmr::memory_resource *resource)
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      data_(nullptr),
+      resource_(resource) {
+  if (other.data_ != nullptr) {
+    CreateBatch();
+    std::memcpy(data_, other.data_, sizeof(T) * Size());
+  }
+}
+
+template <class T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(
+    S21BasicMatrixBatch &&other) noexcept
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      data_(other.data_),
+      resource_(other.resource_) {
+  other.count_ = 0;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.data_ = nullptr;
+}
+
+template <class T>
+S21BasicMatrixBatch<T>::~S21BasicMatrixBatch() {
+  FreeBatch();
+}
+
+template <class T>
+S21BasicMatrixBatch<T> &S21BasicMatrixBatch<T>::operator=(
+    const S21BasicMatrixBatch &other) {
+  if (this == &other) return *this;
+  if (data_ != nullptr && count_ == other.count_ && rows_ == other.rows_ &&
+      cols_ == other.cols_) {
+    std::memcpy(data_, other.data_, sizeof(T) * Size());
+  } else {
+    *this = S21BasicMatrixBatch(other, resource_);
+  }
+  return *this;
+}
+
+template <class T>
+S21BasicMatrixBatch<T> &S21BasicMatrixBatch<T>::operator=(
+    S21BasicMatrixBatch &&other) {
+  if (this == &other) return *this;
+  if (*resource_ != *other.resource_) return *this = other;
+  FreeBatch();
+  count_ = other.count_;
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  data_ = other.data_;
+  other.count_ = 0;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.data_ = nullptr;
+  return *this;
+}
+
+template <class T>
+int S21BasicMatrixBatch<T>::Count() const noexcept {
+  return count_;
+}
+
+template <class T>
+int S21BasicMatrixBatch<T>::GetRows() const noexcept {
+  return rows_;
+}
+
+template <class T>
+int S21BasicMatrixBatch<T>::GetCols() const noexcept {
+  return cols_;
+}
+
+template <class T>
+std::pmr::memory_resource *S21BasicMatrixBatch<T>::GetResource()
+    const noexcept {
+  return resource_;
+}
+
+template <class T>
+T &S21BasicMatrixBatch<T>::operator()(int index, int i, int j) {
+  CheckIndex(index, i, j);
+  return data_[((index / kLanes) * static_cast<std::size_t>(rows_) * cols_ +
+                i * cols_ + j) *
+                   kLanes +
+               index % kLanes];
+}
+
+template <class T>
+T S21BasicMatrixBatch<T>::operator()(int index, int i, int j) const {
+  return const_cast<S21BasicMatrixBatch &>(*this)(index, i, j);
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMatrixBatch<T>::Get(int index) const {
+  CheckIndex(index, 0, 0);
+  S21BasicMatrix<T> m(rows_, cols_, resource_);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) m(i, j) = (*this)(index, i, j);
+  }
+  return m;
+}
+
+template <class T>
+void S21BasicMatrixBatch<T>::Set(int index, const S21BasicMatrix<T> &m) {
+  CheckIndex(index, 0, 0);
+  if (m.GetRows() != rows_ || m.GetCols() != cols_) {
+    throw std::runtime_error("Error: sizes are not equal");
+  }
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) (*this)(index, i, j) = m(i, j);
+  }
+}
+
+template <class T>
+void S21BasicMatrixBatch<T>::MulMatrix(const S21BasicMatrixBatch &other) {
+  CheckIndex(0, 0, 0);
+  other.CheckIndex(0, 0, 0);
+  if (count_ != other.count_ || cols_ != other.rows_) {
+    throw std::runtime_error("Error: impossible to multiply");
+  }
+  const BatchKernels<T> &kernels = ActiveBatchKernels<T>();
+  const long a_pack = static_cast<long>(rows_) * cols_ * kLanes;
+  const long b_pack = static_cast<long>(other.rows_) * other.cols_ * kLanes;
+  const long c_pack = static_cast<long>(rows_) * other.cols_ * kLanes;
+  const long grain =
+      PackGrain(static_cast<long>(rows_) * cols_ * other.cols_ * kLanes);
+  if (other.cols_ == cols_) {
+    // Same shape: each pack goes through scratch and back in place.
+    s21::ParallelFor(Packs(), grain, [&](long begin, long end) {
+      thread_local s21::ScratchBuffer<T> scratch;
+      T *c = scratch.Get(c_pack);
+      for (long p = begin; p < end; ++p) {
+        kernels.mul(data_ + p * a_pack, other.data_ + p * b_pack, c, rows_,
+                    cols_, other.cols_, 1);
+        std::memcpy(data_ + p * a_pack, c, sizeof(T) * c_pack);
+      }
+    });
+    return;
+  }
+  S21BasicMatrixBatch res(count_, rows_, other.cols_, resource_);
+  s21::ParallelFor(Packs(), grain, [&](long begin, long end) {
+    kernels.mul(data_ + begin * a_pack, other.data_ + begin * b_pack,
+                res.data_ + begin * c_pack, rows_, cols_, other.cols_,
+                end - begin);
+  });
+  *this = std::move(res);
+}
+
+template <class T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::Transpose() const {
+  CheckIndex(0, 0, 0);
+  S21BasicMatrixBatch res(count_, cols_, rows_, resource_);
+  const long pack = static_cast<long>(rows_) * cols_ * kLanes;
+  // Transposing permutes whole lane vectors; members never mix.
+  s21::ParallelFor(Packs(), PackGrain(pack), [&](long begin, long end) {
+    for (long p = begin; p < end; ++p) {
+      const T *src = data_ + p * pack;
+      T *dst = res.data_ + p * pack;
+      for (int i = 0; i < rows_; i++) {
+        for (int j = 0; j < cols_; j++) {
+          std::memcpy(dst + (j * rows_ + i) * kLanes,
+                      src + (i * cols_ + j) * kLanes, kPackBytes);
+        }
+      }
+    }
+  });
+  return res;
+}
+
+template <class T>
+std::vector<T> S21BasicMatrixBatch<T>::Determinant() const {
+  CheckSquare();
+  std::vector<T> dets(static_cast<std::size_t>(Packs()) * kLanes);
+  const BatchKernels<T> &kernels = ActiveBatchKernels<T>();
+  const long n = rows_;
+  s21::ParallelFor(Packs(), PackGrain(n * n * n * kLanes),
+                   [&](long begin, long end) {
+                     thread_local s21::ScratchBuffer<T> scratch;
+                     kernels.determinant(data_ + begin * n * n * kLanes,
+                                         dets.data() + begin * kLanes,
+                                         scratch.Get(n * n * kLanes), rows_,
+                                         end - begin);
+                   });
+  dets.resize(count_);
+  return dets;
+}
+
+template <class T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::InverseMatrix() const {
+  CheckSquare();
+  S21BasicMatrixBatch res(count_, rows_, cols_, resource_);
+  std::vector<T> dets(static_cast<std::size_t>(Packs()) * kLanes);
+  const BatchKernels<T> &kernels = ActiveBatchKernels<T>();
+  const long n = rows_;
+  s21::ParallelFor(Packs(), PackGrain(2 * n * n * n * kLanes),
+                   [&](long begin, long end) {
+                     thread_local s21::ScratchBuffer<T> scratch;
+                     kernels.inverse(data_ + begin * n * n * kLanes,
+                                     res.data_ + begin * n * n * kLanes,
+                                     dets.data() + begin * kLanes,
+                                     scratch.Get(2 * n * n * kLanes), rows_,
+                                     end - begin);
+                   });
+  for (int b = 0; b < count_; b++) {
+    if (dets[b] == 0) throw std::logic_error("Determinant is 0");
+  }
+  return res;
+}
+
+template <class T>
+long S21BasicMatrixBatch<T>::Packs() const noexcept {
+  return (count_ + kLanes - 1) / kLanes;
+}
+
+template <class T>
+std::size_t S21BasicMatrixBatch<T>::Size() const noexcept {
+  return static_cast<std::size_t>(Packs()) * rows_ * cols_ * kLanes;
+}
+
+template <class T>
+void S21BasicMatrixBatch<T>::CreateBatch() {
+  data_ = static_cast<T *>(resource_->allocate(sizeof(T) * Size(), kPackBytes));
+  std::memset(data_, 0, sizeof(T) * Size());
+}
+
+template <class T>
+void S21BasicMatrixBatch<T>::FreeBatch() noexcept {
+  if (data_ != nullptr) {
+    resource_->deallocate(data_, sizeof(T) * Size(), kPackBytes);
+    data_ = nullptr;
+  }
+}
+
+template <class T>
+void S21BasicMatrixBatch<T>::CheckIndex(int index, int i, int j) const {
+  if (data_ == nullptr) throw std::runtime_error("Error: matrix is null");
+  if (index < 0 || index >= count_ || i < 0 || i >= rows_ || j < 0 ||
+      j >= cols_) {
+    throw std::out_of_range("Incorrect input, index is out of range");
+  }
+}
+
+template <class T>
+void S21BasicMatrixBatch<T>::CheckSquare() const {
+  CheckIndex(0, 0, 0);
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Error: matrix is not square");
+  }
+}
+
+template class S21BasicMatrixBatch<float>;
+template class S21BasicMatrixBatch<double>;
@@ -0,0 +1,75 @@
+#ifndef SRC_S21_MATRIX_BATCH_H_
+#define SRC_S21_MATRIX_BATCH_H_
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// count independent rows x cols matrices of T stored interleaved, for
+// batches of many small matrices. Members are grouped into packs of kLanes;
+// within a pack element (i, j) of all members is one 64-byte vector, so
+// every operation runs across members in SIMD lanes with no shuffles, and
+// packs are split over the thread pool. Instantiated for float and
+// double.
+//
+// Storage comes from a std::pmr::memory_resource with the same rules as
+// S21BasicMatrix.
+template <class T>
+class S21BasicMatrixBatch {
+ public:
+  using Scalar = T;
+  static constexpr int kLanes = static_cast<int>(64 / sizeof(T));
+
+  S21BasicMatrixBatch() noexcept;
+  S21BasicMatrixBatch(
+      int count, int rows, int cols,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+  S21BasicMatrixBatch(const S21BasicMatrixBatch &other);
+  S21BasicMatrixBatch(const S21BasicMatrixBatch &other,
+                      std::pmr::memory_resource *resource);
+  S21BasicMatrixBatch(S21BasicMatrixBatch &&other) noexcept;
+  ~S21BasicMatrixBatch();
+
+  S21BasicMatrixBatch &operator=(const S21BasicMatrixBatch &other);
+  S21BasicMatrixBatch &operator=(S21BasicMatrixBatch &&other);
+
+  int Count() const noexcept;
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  std::pmr::memory_resource *GetResource() const noexcept;
+  // Element (i, j) of member index.
+  T &operator()(int index, int i, int j);
+  T operator()(int index, int i, int j) const;
+  S21BasicMatrix<T> Get(int index) const;
+  void Set(int index, const S21BasicMatrix<T> &m);
+
+  // Member-wise this[b] = this[b] * other[b].
+  void MulMatrix(const S21BasicMatrixBatch &other);
+  S21BasicMatrixBatch Transpose() const;
+  std::vector<T> Determinant() const;
+  // Throws std::logic_error if any member has a zero pivot.
+  S21BasicMatrixBatch InverseMatrix() const;
+
+ private:
+  int count_;
+  int rows_;
+  int cols_;
+  T *data_;
+  std::pmr::memory_resource *resource_;
+  long Packs() const noexcept;
+  std::size_t Size() const noexcept;
+  void CreateBatch();
+  void FreeBatch() noexcept;
+  void CheckIndex(int index, int i, int j) const;
+  void CheckSquare() const;
+};
+
+using S21MatrixBatch = S21BasicMatrixBatch<double>;
+using S21FloatMatrixBatch = S21BasicMatrixBatch<float>;
+
+extern template class S21BasicMatrixBatch<float>;
+extern template class S21BasicMatrixBatch<double>;
+
+#endif
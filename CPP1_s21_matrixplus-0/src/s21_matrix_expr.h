@@ -0,0 +1,304 @@
+#ifndef SRC_S21_MATRIX_EXPR_H_
+#define SRC_S21_MATRIX_EXPR_H_
+
+// Lazy element-wise arithmetic for S21BasicMatrix. Included at the end of
+// s21_matrix_oop.h; do not include directly.
+//
+// A + B - C * 2.0 builds a tree of expression nodes instead of three
+// temporaries. Assigning the tree to a matrix evaluates it row by row in a
+// single pass: each node hands out a row cursor whose operator[] the
+// compiler inlines into one loop over the destination row. Matrix products
+// are not lazy; operator* between matrices still calls the GEMM kernel.
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+template <class E>
+struct MatrixExpr {
+  const E &Self() const noexcept { return static_cast<const E &>(*this); }
+  int Rows() const noexcept { return Self().Rows(); }
+  int Cols() const noexcept { return Self().Cols(); }
+};
+
+// Leaf borrowing an lvalue matrix.
+template <class T>
+class MatrixRef : public MatrixExpr<MatrixRef<T>> {
+ public:
+  using Scalar = T;
+  explicit MatrixRef(const S21BasicMatrix<T> &m) : m_(m) {
+    if (m.Data() == nullptr) throw std::runtime_error("Error: matrix is null");
+  }
+  int Rows() const noexcept { return m_.GetRows(); }
+  int Cols() const noexcept { return m_.GetCols(); }
+  const T *Row(int i) const noexcept {
+    return m_.Data() + static_cast<std::ptrdiff_t>(i) * m_.Stride();
+  }
+
+ private:
+  const S21BasicMatrix<T> &m_;
+};
+
+struct AddOp {
+  template <class T>
+  static T Apply(T a, T b) noexcept {
+    return a + b;
+  }
+};
+
+struct SubOp {
+  template <class T>
+  static T Apply(T a, T b) noexcept {
+    return a - b;
+  }
+};
+
+template <class T, class L, class R, class Op>
+struct BinaryRow {
+  L l;
+  R r;
+  T operator[](int j) const noexcept { return Op::Apply(l[j], r[j]); }
+};
+
+template <class L, class R, class Op>
+class BinaryExpr : public MatrixExpr<BinaryExpr<L, R, Op>> {
+  static_assert(std::is_same<typename L::Scalar, typename R::Scalar>::value,
+                "operands must have the same element type");
+
+ public:
+  using Scalar = typename L::Scalar;
+  BinaryExpr(L l, R r) : l_(std::move(l)), r_(std::move(r)) {
+    if (l_.Rows() != r_.Rows() || l_.Cols() != r_.Cols()) {
+      throw std::runtime_error("Error: sizes are not equal");
+    }
+  }
+  int Rows() const noexcept { return l_.Rows(); }
+  int Cols() const noexcept { return l_.Cols(); }
+  auto Row(int i) const noexcept {
+    return BinaryRow<Scalar, decltype(l_.Row(i)), decltype(r_.Row(i)), Op>{
+        l_.Row(i), r_.Row(i)};
+  }
+
+ private:
+  L l_;
+  R r_;
+};
+
+template <class T, class E>
+struct ScaleRow {
+  E e;
+  T value;
+  T operator[](int j) const noexcept { return e[j] * value; }
+};
+
+template <class E>
+class ScaleExpr : public MatrixExpr<ScaleExpr<E>> {
+ public:
+  using Scalar = typename E::Scalar;
+  ScaleExpr(E e, Scalar value) : e_(std::move(e)), value_(value) {}
+  int Rows() const noexcept { return e_.Rows(); }
+  int Cols() const noexcept { return e_.Cols(); }
+  auto Row(int i) const noexcept {
+    return ScaleRow<Scalar, decltype(e_.Row(i))>{e_.Row(i), value_};
+  }
+
+ private:
+  E e_;
+  Scalar value_;
+};
+
+constexpr int kEvaluateBlock = 8;
+
+// Writes expr into a rows x cols destination with the given stride. The
+// destination may be one of the leaves: every element is read before it is
+// written at the same position.
+template <class E>
+void Evaluate(const MatrixExpr<E> &expr, typename E::Scalar *out,
+              std::ptrdiff_t stride) {
+  using T = typename E::Scalar;
+  const E &e = expr.Self();
+  const int cols = e.Cols();
+  long grain = std::max(1L, kParallelMinElements / std::max(1, cols));
+  ParallelFor(e.Rows(), grain, [&](long begin, long end) {
+    for (long i = begin; i < end; ++i) {
+      auto row = e.Row(static_cast<int>(i));
+      T *dst = out + i * stride;
+      int j = 0;
+      // Fixed-width blocks are vectorized even under -O2's cost model; the
+      // staging array keeps every load of a block ahead of its stores.
+      for (; j + kEvaluateBlock <= cols; j += kEvaluateBlock) {
+        T block[kEvaluateBlock];
+        for (int u = 0; u < kEvaluateBlock; ++u) block[u] = row[j + u];
+        for (int u = 0; u < kEvaluateBlock; ++u) dst[j + u] = block[u];
+      }
+      for (; j < cols; ++j) dst[j] = row[j];
+    }
+  });
+}
+
+template <class T>
+using Bare = std::remove_cv_t<std::remove_reference_t<T>>;
+
+template <class T>
+struct IsExpr : std::is_base_of<MatrixExpr<Bare<T>>, Bare<T>> {};
+
+template <class T>
+struct IsMatrix : std::false_type {};
+
+template <class T>
+struct IsMatrix<S21BasicMatrix<T>> : std::true_type {};
+
+// Lvalue matrices and expressions make lazy nodes. Expiring matrices are
+// left to the overloads in s21_matrix_oop.h, which reuse their storage.
+template <class T>
+constexpr bool kIsOperand =
+    (IsMatrix<Bare<T>>::value && std::is_lvalue_reference<T>::value) ||
+    IsExpr<T>::value;
+
+// Operand to node: matrices are borrowed and expression nodes are copied
+// (they only hold leaves and scalars).
+template <class T>
+MatrixRef<T> AsExpr(const S21BasicMatrix<T> &m) {
+  return MatrixRef<T>(m);
+}
+template <class E>
+E AsExpr(const MatrixExpr<E> &e) {
+  return e.Self();
+}
+
+template <class T>
+using ExprOf = decltype(AsExpr(std::declval<T>()));
+
+template <class T>
+using ScalarOf = typename ExprOf<T>::Scalar;
+
+}  // namespace s21
+
+template <class T>
+template <class E>
+S21BasicMatrix<T>::S21BasicMatrix(const s21::MatrixExpr<E> &expr,
+                                  std::pmr::memory_resource *resource)
+    : S21BasicMatrix(expr.Rows(), expr.Cols(), resource) {
+  static_assert(std::is_same<typename E::Scalar, T>::value,
+                "expression has a different element type");
+  s21::Evaluate(expr, matrix_, stride_);
+}
+
+template <class T>
+template <class E>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(
+    const s21::MatrixExpr<E> &expr) {
+  static_assert(std::is_same<typename E::Scalar, T>::value,
+                "expression has a different element type");
+  if (rows_ == expr.Rows() && cols_ == expr.Cols()) {
+    s21::Evaluate(expr, matrix_, stride_);
+  } else {
+    S21BasicMatrix result(expr, resource_);
+    std::swap(rows_, result.rows_);
+    std::swap(cols_, result.cols_);
+    std::swap(stride_, result.stride_);
+    std::swap(matrix_, result.matrix_);
+    std::swap(capacity_, result.capacity_);
+  }
+  return *this;
+}
+
+template <class T>
+template <class E>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator+=(
+    const s21::MatrixExpr<E> &expr) {
+  return *this = *this + expr.Self();
+}
+
+template <class T>
+template <class E>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator-=(
+    const s21::MatrixExpr<E> &expr) {
+  return *this = *this - expr.Self();
+}
+
+template <class L, class R,
+          class = std::enable_if_t<s21::kIsOperand<L> && s21::kIsOperand<R>>>
+auto operator+(L &&l, R &&r) {
+  return s21::BinaryExpr<s21::ExprOf<L>, s21::ExprOf<R>, s21::AddOp>(
+      s21::AsExpr(std::forward<L>(l)), s21::AsExpr(std::forward<R>(r)));
+}
+
+template <class L, class R,
+          class = std::enable_if_t<s21::kIsOperand<L> && s21::kIsOperand<R>>>
+auto operator-(L &&l, R &&r) {
+  return s21::BinaryExpr<s21::ExprOf<L>, s21::ExprOf<R>, s21::SubOp>(
+      s21::AsExpr(std::forward<L>(l)), s21::AsExpr(std::forward<R>(r)));
+}
+
+template <class M, class = std::enable_if_t<s21::kIsOperand<M>>>
+auto operator*(M &&m, s21::ScalarOf<M> value) {
+  return s21::ScaleExpr<s21::ExprOf<M>>(s21::AsExpr(std::forward<M>(m)),
+                                        value);
+}
+
+template <class M, class = std::enable_if_t<s21::kIsOperand<M>>>
+auto operator*(s21::ScalarOf<M> value, M &&m) {
+  return s21::ScaleExpr<s21::ExprOf<M>>(s21::AsExpr(std::forward<M>(m)),
+                                        value);
+}
+
+// An expression combined with an expiring matrix is evaluated straight
+// into that matrix's buffer.
+template <class E, class T = typename E::Scalar>
+S21BasicMatrix<T> operator+(const s21::MatrixExpr<E> &l,
+                            S21BasicMatrix<T> &&r) {
+  r = l.Self() + r;
+  return std::move(r);
+}
+
+template <class E, class T = typename E::Scalar>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T> &&l,
+                            const s21::MatrixExpr<E> &r) {
+  l = l + r.Self();
+  return std::move(l);
+}
+
+template <class E, class T = typename E::Scalar>
+S21BasicMatrix<T> operator-(const s21::MatrixExpr<E> &l,
+                            S21BasicMatrix<T> &&r) {
+  r = l.Self() - r;
+  return std::move(r);
+}
+
+template <class E, class T = typename E::Scalar>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T> &&l,
+                            const s21::MatrixExpr<E> &r) {
+  l = l - r.Self();
+  return std::move(l);
+}
+
+// Products involving an expression evaluate it first and then run GEMM.
+template <class E, class T = typename E::Scalar>
+S21BasicMatrix<T> operator*(const s21::MatrixExpr<E> &l,
+                            const S21BasicMatrix<T> &r) {
+  return S21BasicMatrix<T>(l, r.GetResource()) * r;
+}
+
+template <class E, class T = typename E::Scalar>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T> &l,
+                            const s21::MatrixExpr<E> &r) {
+  return l * S21BasicMatrix<T>(r, l.GetResource());
+}
+
+template <class E, class T = typename E::Scalar>
+bool operator==(const s21::MatrixExpr<E> &l, const S21BasicMatrix<T> &r) {
+  return S21BasicMatrix<T>(l, r.GetResource()) == r;
+}
+
+template <class E, class T = typename E::Scalar>
+bool operator==(const S21BasicMatrix<T> &l, const s21::MatrixExpr<E> &r) {
+  return l == S21BasicMatrix<T>(r, l.GetResource());
+}
+
+#endif
@@ -0,0 +1,365 @@
+#include "s21_matrix_file.h"
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "s21_gemm.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr std::size_t kHeaderBytes = sizeof(MatrixFileHeader);
+constexpr std::uint32_t kPayloadAlignment = 64;
+// O_DIRECT transfers must be multiples of the device's logical block
+// size, at most 4096 bytes on current hardware.
+constexpr std::size_t kDirectBlock = 4096;
+constexpr std::size_t kDirectBuffer = std::size_t(1) << 22;
+
+template <class T>
+constexpr MatrixDType kDType = MatrixDType::kFloat64;
+template <>
+constexpr MatrixDType kDType<float> = MatrixDType::kFloat32;
+template <>
+constexpr MatrixDType kDType<std::int32_t> = MatrixDType::kInt32;
+template <>
+constexpr MatrixDType kDType<std::complex<double>> = MatrixDType::kComplex128;
+
+std::uint64_t Checksum(const void *data, std::size_t bytes) {
+  constexpr std::uint64_t kBasis = 14695981039346656037ULL;
+  constexpr std::uint64_t kPrime = 1099511628211ULL;
+  const unsigned char *p = static_cast<const unsigned char *>(data);
+  const std::size_t words = bytes / 8;
+  // Four lanes keep four multiplies in flight instead of one chain.
+  std::uint64_t lanes[4] = {kBasis, kBasis, kBasis, kBasis};
+  std::size_t i = 0;
+  for (; i + 4 <= words; i += 4) {
+    for (int l = 0; l < 4; ++l) {
+      std::uint64_t word;
+      std::memcpy(&word, p + (i + l) * 8, 8);
+      lanes[l] = (lanes[l] ^ word) * kPrime;
+    }
+  }
+  for (; i < words; ++i) {
+    std::uint64_t word;
+    std::memcpy(&word, p + i * 8, 8);
+    lanes[i % 4] = (lanes[i % 4] ^ word) * kPrime;
+  }
+  std::uint64_t hash = kBasis;
+  for (std::uint64_t lane : lanes) hash = (hash ^ lane) * kPrime;
+  for (std::size_t b = words * 8; b < bytes; ++b) hash = (hash ^ p[b]) * kPrime;
+  return hash;
+}
+
+void WriteBuffered(const std::string &path, const MatrixFileHeader &header,
+                   const void *payload) {
+  FileDescriptor file(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644));
+  if (file.Get() < 0) ThrowErrno("open", path);
+  iovec parts[2] = {
+      {const_cast<MatrixFileHeader *>(&header), kHeaderBytes},
+      {const_cast<void *>(payload), header.payload_bytes},
+  };
+  iovec *next = parts;
+  int count = 2;
+  // writev may stop short, e.g. at 2 GiB on Linux; resume where it did.
+  while (count > 0) {
+    ssize_t written = ::writev(file.Get(), next, count);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      ThrowErrno("writev", path);
+    }
+    std::size_t done = static_cast<std::size_t>(written);
+    while (count > 0 && done >= next->iov_len) {
+      done -= next->iov_len;
+      ++next;
+      --count;
+    }
+    if (count > 0) {
+      next->iov_base = static_cast<char *>(next->iov_base) + done;
+      next->iov_len -= done;
+    }
+  }
+  if (file.Close() != 0) ThrowErrno("close", path);
+}
+
+// Returns false, having written nothing, if the file system does not
+// support O_DIRECT.
+bool WriteDirect(const std::string &path, const MatrixFileHeader &header,
+                 const void *payload) {
+  FileDescriptor file(
+      ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644));
+  if (file.Get() < 0) {
+    if (errno == EINVAL) return false;
+    ThrowErrno("open", path);
+  }
+  struct Buffer {
+    char *data;
+    ~Buffer() { ::operator delete[](data, std::align_val_t(kDirectBlock)); }
+  } buffer{static_cast<char *>(
+      ::operator new[](kDirectBuffer, std::align_val_t(kDirectBlock)))};
+
+  const std::size_t total = kHeaderBytes + header.payload_bytes;
+  const char *source = static_cast<const char *>(payload);
+  std::size_t offset = 0;
+  while (offset < total) {
+    // Fill the bounce buffer with the next stretch of header + payload,
+    // zero-padding the last one to a whole block.
+    std::size_t chunk = std::min(kDirectBuffer, total - offset);
+    std::size_t filled = 0;
+    if (offset < kHeaderBytes) {
+      filled = kHeaderBytes - offset;
+      std::memcpy(buffer.data, reinterpret_cast<const char *>(&header) + offset,
+                  filled);
+    }
+    std::memcpy(buffer.data + filled, source + (offset + filled - kHeaderBytes),
+                chunk - filled);
+    std::size_t padded =
+        (chunk + kDirectBlock - 1) / kDirectBlock * kDirectBlock;
+    std::memset(buffer.data + chunk, 0, padded - chunk);
+    for (std::size_t done = 0; done < padded;) {
+      ssize_t written = ::pwrite(file.Get(), buffer.data + done, padded - done,
+                                 static_cast<off_t>(offset + done));
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        if (errno == EINVAL && offset == 0 && done == 0) return false;
+        ThrowErrno("write", path);
+      }
+      done += static_cast<std::size_t>(written);
+    }
+    offset += chunk;
+  }
+  // Drop the padding of the last block.
+  if (::ftruncate(file.Get(), static_cast<off_t>(total)) != 0) {
+    ThrowErrno("ftruncate", path);
+  }
+  if (file.Close() != 0) ThrowErrno("close", path);
+  return true;
+}
+
+// Header for a rows x cols matrix of T, checksum still to fill in.
+template <class T>
+MatrixFileHeader MakeHeader(int rows, int cols, int stride) {
+  MatrixFileHeader header = {};
+  std::memcpy(header.magic, MatrixFileHeader::kMagic, sizeof(header.magic));
+  header.version = MatrixFileHeader::kVersion;
+  header.dtype = kDType<T>;
+  header.rows = rows;
+  header.cols = cols;
+  header.stride = stride;
+  header.alignment = kPayloadAlignment;
+  header.payload_bytes = sizeof(T) * static_cast<std::uint64_t>(rows) * stride;
+  return header;
+}
+
+}  // namespace
+
+template <class T>
+void WriteMatrix(const std::string &path, const S21BasicMatrix<T> &m,
+                 WriteMode mode) {
+  if (m.Data() == nullptr) throw std::runtime_error("Error: matrix is null");
+  MatrixFileHeader header =
+      MakeHeader<T>(m.GetRows(), m.GetCols(), m.Stride());
+  header.checksum = Checksum(m.Data(), header.payload_bytes);
+  if (mode == WriteMode::kDirect && WriteDirect(path, header, m.Data())) {
+    return;
+  }
+  WriteBuffered(path, header, m.Data());
+}
+
+template <class T>
+MappedMatrix<T>::MappedMatrix(const std::string &path, bool verify)
+    : file_(path) {
+  if (file_.Size() < kHeaderBytes) {
+    throw std::runtime_error("Not a matrix file: " + path);
+  }
+  const MatrixFileHeader &header =
+      *reinterpret_cast<const MatrixFileHeader *>(file_.Data());
+  const char *problem = nullptr;
+  if (std::memcmp(header.magic, MatrixFileHeader::kMagic, 8) != 0) {
+    problem = "Not a matrix file: ";
+  } else if (header.version != MatrixFileHeader::kVersion) {
+    problem = "Unsupported matrix file version: ";
+  } else if (header.dtype != kDType<T>) {
+    problem = "Matrix file holds another element type: ";
+  } else if (header.rows <= 0 || header.cols <= 0 ||
+             header.stride < header.cols || header.rows > INT32_MAX ||
+             header.stride > INT32_MAX ||
+             header.alignment != kPayloadAlignment ||
+             // rows * stride is below 2^62; bounding it by the elements
+             // the file holds keeps the byte count below from wrapping.
+             static_cast<std::uint64_t>(header.rows) *
+                     static_cast<std::uint64_t>(header.stride) >
+                 (file_.Size() - kHeaderBytes) / sizeof(T) ||
+             header.payload_bytes !=
+                 sizeof(T) * static_cast<std::uint64_t>(header.rows) *
+                     static_cast<std::uint64_t>(header.stride)) {
+    problem = "Corrupt matrix file header: ";
+  } else if (verify &&
+             Checksum(file_.Data() + kHeaderBytes, header.payload_bytes) !=
+                 header.checksum) {
+    problem = "Matrix file checksum mismatch: ";
+  }
+  if (problem != nullptr) throw std::runtime_error(problem + path);
+  rows_ = static_cast<int>(header.rows);
+  cols_ = static_cast<int>(header.cols);
+  stride_ = static_cast<int>(header.stride);
+  data_ = reinterpret_cast<const T *>(file_.Data() + kHeaderBytes);
+}
+
+template <class T>
+MappedMatrix<T>::MappedMatrix(MappedMatrix &&other) noexcept
+    : file_(std::move(other.file_)),
+      data_(std::exchange(other.data_, nullptr)),
+      rows_(std::exchange(other.rows_, 0)),
+      cols_(std::exchange(other.cols_, 0)),
+      stride_(std::exchange(other.stride_, 0)) {}
+
+template <class T>
+MappedMatrix<T> &MappedMatrix<T>::operator=(MappedMatrix &&other) noexcept {
+  if (this != &other) {
+    file_ = std::move(other.file_);
+    std::swap(data_, other.data_);
+    std::swap(rows_, other.rows_);
+    std::swap(cols_, other.cols_);
+    std::swap(stride_, other.stride_);
+  }
+  return *this;
+}
+
+template <class T>
+S21BasicMatrix<T> LoadMatrix(const std::string &path, bool verify,
+                             std::pmr::memory_resource *resource) {
+  MappedMatrix<T> mapped(path, verify);
+  return S21BasicMatrix<T>(mapped.View(), resource);
+}
+
+template <class T>
+void MultiplyMatrixFiles(const std::string &a_path, const std::string &b_path,
+                         const std::string &c_path,
+                         std::size_t memory_budget) {
+  MappedMatrix<T> a(a_path), b(b_path);
+  if (a.GetCols() != b.GetRows()) {
+    throw std::runtime_error("Error: impossible to multiply");
+  }
+  const int m = a.GetRows(), n = b.GetCols(), k = a.GetCols();
+  // Two buffers each of A (tm x tk), B (tk x tn) and C (tm x tn).
+  const std::size_t budget = memory_budget / sizeof(T);
+  const int side = static_cast<int>(std::sqrt(budget / 6.0));
+  if (side < 1) throw std::invalid_argument("Memory budget is too small");
+  const int tm = std::min(m, side), tn = std::min(n, side);
+  const int tk = static_cast<int>(std::min<std::size_t>(
+      k, (budget - 2 * std::size_t(tm) * tn) / (2 * std::size_t(tm + tn))));
+  const int per_line = static_cast<int>(kPayloadAlignment / sizeof(T));
+  const int stride = (n + per_line - 1) / per_line * per_line;
+  MatrixFileHeader header = MakeHeader<T>(m, n, stride);
+  const std::size_t total = kHeaderBytes + header.payload_bytes;
+
+  FileDescriptor file(::open(c_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644));
+  if (file.Get() < 0) ThrowErrno("open", c_path);
+  // Full size up front, the row padding and the header reading as zeros
+  // until the end.
+  if (::ftruncate(file.Get(), static_cast<off_t>(total)) != 0) {
+    ThrowErrno("ftruncate", c_path);
+  }
+
+  struct Tile {
+    int i0, j0, p0;
+    int rows, cols, depth;
+  };
+  std::vector<Tile> steps;
+  for (int i0 = 0; i0 < m; i0 += tm) {
+    for (int j0 = 0; j0 < n; j0 += tn) {
+      for (int p0 = 0; p0 < k; p0 += tk) {
+        steps.push_back({i0, j0, p0, std::min(tm, m - i0), std::min(tn, n - j0),
+                         std::min(tk, k - p0)});
+      }
+    }
+  }
+  std::vector<T> a_tiles[2], b_tiles[2], c_tiles[2];
+  for (int set = 0; set < 2; ++set) {
+    a_tiles[set].resize(std::size_t(tm) * tk);
+    b_tiles[set].resize(std::size_t(tk) * tn);
+    c_tiles[set].resize(std::size_t(tm) * tn);
+  }
+  auto load = [&](const Tile &t, int set) {
+    for (int r = 0; r < t.rows; ++r) {
+      std::memcpy(a_tiles[set].data() + std::size_t(r) * t.depth,
+                  a.Data() + std::size_t(t.i0 + r) * a.Stride() + t.p0,
+                  sizeof(T) * t.depth);
+    }
+    for (int r = 0; r < t.depth; ++r) {
+      std::memcpy(b_tiles[set].data() + std::size_t(r) * t.cols,
+                  b.Data() + std::size_t(t.p0 + r) * b.Stride() + t.j0,
+                  sizeof(T) * t.cols);
+    }
+  };
+  auto store = [&](const Tile &t, int set) {
+    for (int r = 0; r < t.rows; ++r) {
+      std::size_t element = std::size_t(t.i0 + r) * stride + t.j0;
+      WriteAll(file.Get(), c_tiles[set].data() + std::size_t(r) * t.cols,
+               sizeof(T) * t.cols,
+               static_cast<off_t>(kHeaderBytes + sizeof(T) * element), c_path);
+    }
+  };
+
+  // Declared after the buffers, so that on an exception the futures wait
+  // for the helper threads before the buffers go away.
+  std::future<void> loading =
+      std::async(std::launch::async, load, steps[0], 0);
+  std::future<void> storing;
+  int finished = 0;
+  for (std::size_t s = 0; s < steps.size(); ++s) {
+    const Tile &t = steps[s];
+    const int set = static_cast<int>(s % 2), out = finished % 2;
+    loading.get();
+    if (s + 1 < steps.size()) {
+      loading =
+          std::async(std::launch::async, load, steps[s + 1], 1 - set);
+    }
+    Gemm<T>(t.rows, t.cols, t.depth, T(1), a_tiles[set].data(), t.depth,
+            b_tiles[set].data(), t.cols, t.p0 == 0 ? T(0) : T(1),
+            c_tiles[out].data(), t.cols);
+    if (t.p0 + t.depth == k) {
+      // The store in flight reads the other C buffer.
+      if (storing.valid()) storing.get();
+      storing = std::async(std::launch::async, store, t, out);
+      ++finished;
+    }
+  }
+  storing.get();
+
+  MappedFile written(c_path);
+  written.AdviseSequential();
+  header.checksum =
+      Checksum(written.Data() + kHeaderBytes, header.payload_bytes);
+  WriteAll(file.Get(), &header, kHeaderBytes, 0, c_path);
+  if (file.Close() != 0) ThrowErrno("close", c_path);
+}
+
+#define S21_INSTANTIATE_FILE(T)                                                \
+  template void WriteMatrix<T>(const std::string &,                            \
+                               const S21BasicMatrix<T> &, WriteMode);          \
+  template class MappedMatrix<T>;                                              \
+  template S21BasicMatrix<T> LoadMatrix<T>(const std::string &, bool,          \
+                                           std::pmr::memory_resource *);      \
+  template void MultiplyMatrixFiles<T>(const std::string &,                    \
+                                       const std::string &,                    \
+                                       const std::string &, std::size_t);
+
+S21_INSTANTIATE_FILE(float)
+S21_INSTANTIATE_FILE(double)
+S21_INSTANTIATE_FILE(std::int32_t)
+S21_INSTANTIATE_FILE(std::complex<double>)
+
+}  // namespace s21
@@ -0,0 +1,126 @@
+#ifndef SRC_S21_MATRIX_FILE_H_
+#define SRC_S21_MATRIX_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+
+#include "s21_matrix_oop.h"
+#include "s21_posix_file.h"
+
+namespace s21 {
+
+// On-disk matrix: a 64-byte MatrixFileHeader followed at offset 64 by the
+// payload, the matrix buffer exactly as S21BasicMatrix holds it in memory
+// (rows of stride elements, the padding zeroed). Integers are stored in
+// native byte order; a file written on a machine of the other endianness
+// fails the magic check.
+//
+// The payload starts 64 bytes into a page-aligned mapping, so a mapped
+// file is a correctly aligned matrix buffer and loads without a copy.
+enum class MatrixDType : std::uint32_t {
+  kFloat32 = 1,
+  kFloat64 = 2,
+  kInt32 = 3,
+  kComplex128 = 4,
+};
+
+struct MatrixFileHeader {
+  static constexpr char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+  static constexpr std::uint32_t kVersion = 1;
+
+  char magic[8];
+  std::uint32_t version;
+  MatrixDType dtype;
+  std::int64_t rows;
+  std::int64_t cols;
+  // Elements from one row to the next.
+  std::int64_t stride;
+  // Alignment in bytes of the payload and of every row in it.
+  std::uint32_t alignment;
+  std::uint32_t reserved;
+  std::uint64_t payload_bytes;
+  // FNV-1a over the payload's 64-bit words, in four interleaved lanes
+  // whose states are hashed together at the end.
+  std::uint64_t checksum;
+};
+static_assert(sizeof(MatrixFileHeader) == 64, "header must be 64 bytes");
+
+// How WriteMatrix gets the bytes to disk. kBuffered hands header and
+// payload to one writev through the page cache. kDirect opens the file
+// with O_DIRECT and streams it through an aligned bounce buffer, so a
+// large matrix does not evict the page cache; it falls back to kBuffered
+// where the file system refuses O_DIRECT.
+enum class WriteMode { kBuffered, kDirect };
+
+// Writes m to path, replacing the file. Throws std::system_error on I/O
+// failure and std::runtime_error for an empty matrix.
+template <class T>
+void WriteMatrix(const std::string &path, const S21BasicMatrix<T> &m,
+                 WriteMode mode = WriteMode::kBuffered);
+
+// Read-only matrix mapped straight from a file written by WriteMatrix.
+// Opening maps the file and checks the header, so it takes the same time
+// at any size; pages are read on first touch. The payload checksum is only
+// verified on request since that reads the whole file. Instantiated for
+// the element types of S21BasicMatrix.
+template <class T>
+class MappedMatrix {
+ public:
+  MappedMatrix() noexcept = default;
+  // Throws std::system_error if the file cannot be opened or mapped and
+  // std::runtime_error if it is not a valid matrix file of T (or, with
+  // verify, if the checksum does not match).
+  explicit MappedMatrix(const std::string &path, bool verify = false);
+  MappedMatrix(const MappedMatrix &) = delete;
+  MappedMatrix &operator=(const MappedMatrix &) = delete;
+  MappedMatrix(MappedMatrix &&other) noexcept;
+  MappedMatrix &operator=(MappedMatrix &&other) noexcept;
+
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  int Stride() const noexcept { return stride_; }
+  const T *Data() const noexcept { return data_; }
+  MatrixView<const T> View() const noexcept {
+    return MatrixView<const T>(data_, rows_, cols_, stride_);
+  }
+
+ private:
+  MappedFile file_;
+  const T *data_ = nullptr;
+  int rows_ = 0;
+  int cols_ = 0;
+  int stride_ = 0;
+};
+
+// Copies a matrix file into a new matrix allocated from resource.
+template <class T>
+S21BasicMatrix<T> LoadMatrix(
+    const std::string &path, bool verify = false,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+// Out-of-core product: writes the file c_path = a_path * b_path for
+// operands too large for memory, keeping at most memory_budget bytes of
+// tiles resident (the page cache aside). C is computed one tm x tn tile
+// at a time, accumulating over tk-deep tiles of A and B with Gemm. The
+// tile after the current one is copied in from the mapped operands by a
+// second thread while Gemm runs, and each finished C tile is written out
+// behind the computation of the next, so with enough arithmetic per tile
+// the disk time hides under compute. The budget holds two tiles each of
+// A, B and C; tiles are square where the shapes allow, with the leftover
+// budget going into depth (tk), which raises the work per byte read. The
+// header goes in last, after the checksum, so an interrupted run leaves
+// a file that fails to open.
+//
+// Throws std::runtime_error if the shapes do not conform and
+// std::invalid_argument if the budget cannot hold one element per tile.
+template <class T>
+void MultiplyMatrixFiles(const std::string &a_path,
+                         const std::string &b_path,
+                         const std::string &c_path,
+                         std::size_t memory_budget);
+
+}  // namespace s21
+
+#endif
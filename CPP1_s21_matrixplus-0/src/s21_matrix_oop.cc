@@ -1,325 +1,710 @@
 #include "s21_matrix_oop.h"
 
-S21Matrix::S21Matrix() noexcept : rows_(0), cols_(0), matrix_(nullptr) {}
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "s21_gemm.h"
+#include "s21_lu.h"
+#include "s21_lu_factorization.h"
+#include "s21_matrix_text.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+template <class T>
+int FactorLu(const S21BasicMatrix<T> &m, S21BasicMatrix<T> &lu,
+             std::pmr::vector<int> &pivots) {
+  lu = m;
+  pivots.resize(m.GetRows());
+  return s21::LuFactor(m.GetRows(), lu.Data(), lu.Stride(), pivots.data());
+}
+
+S21Matrix ToDouble(const S21IntMatrix &m) {
+  S21Matrix res(m.GetRows(), m.GetCols(), m.GetResource());
+  for (int i = 0; i < m.GetRows(); i++) {
+    for (int j = 0; j < m.GetCols(); j++) res(i, j) = m(i, j);
+  }
+  return res;
+}
+
+// Bareiss fraction-free elimination: every intermediate is a minor of the
+// matrix, so the divisions are exact. Products are formed in 128 bits;
+// a minor that does not fit 64 bits throws std::overflow_error.
+std::int64_t ExactDeterminant(const S21IntMatrix &m) {
+  const int n = m.GetRows();
+  std::pmr::vector<std::int64_t> a(static_cast<std::size_t>(n) * n,
+                                   m.GetResource());
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) a[i * n + j] = m(i, j);
+  }
+  std::int64_t sign = 1;
+  std::int64_t previous = 1;
+  for (int k = 0; k < n - 1; k++) {
+    if (a[k * n + k] == 0) {
+      int pivot = k + 1;
+      while (pivot < n && a[pivot * n + k] == 0) pivot++;
+      if (pivot == n) return 0;
+      std::swap_ranges(a.begin() + k * n, a.begin() + (k + 1) * n,
+                       a.begin() + pivot * n);
+      sign = -sign;
+    }
+    for (int i = k + 1; i < n; i++) {
+      for (int j = k + 1; j < n; j++) {
+        __int128 value = static_cast<__int128>(a[i * n + j]) * a[k * n + k] -
+                         static_cast<__int128>(a[i * n + k]) * a[k * n + j];
+        value /= previous;
+        if (value < std::numeric_limits<std::int64_t>::min() ||
+            value > std::numeric_limits<std::int64_t>::max()) {
+          throw std::overflow_error("Error: determinant overflows");
+        }
+        a[i * n + j] = static_cast<std::int64_t>(value);
+      }
+    }
+    previous = a[k * n + k];
+  }
+  const std::int64_t det = a[(n - 1) * n + n - 1];
+  if (sign < 0 && det == std::numeric_limits<std::int64_t>::min()) {
+    throw std::overflow_error("Error: determinant overflows");
+  }
+  return sign * det;
+}
+
+// Transposes the packed rows x cols array a into cols x rows in place:
+// position d of the result takes element (d % rows, d / rows) of a, and
+// each cycle of that permutation is rotated once.
+template <class T>
+void CycleTranspose(T *a, int rows, int cols,
+                    std::pmr::memory_resource *resource) {
+  const std::size_t count = static_cast<std::size_t>(rows) * cols;
+  std::pmr::vector<bool> done(count, false, resource);
+  auto source = [&](std::size_t d) { return d % rows * cols + d / rows; };
+  // The first and last elements stay where they are.
+  for (std::size_t start = 1; start + 1 < count; start++) {
+    if (done[start]) continue;
+    T first = a[start];
+    std::size_t d = start;
+    for (std::size_t s = source(d); s != start; s = source(d)) {
+      a[d] = a[s];
+      done[d] = true;
+      d = s;
+    }
+    a[d] = first;
+    done[d] = true;
+  }
+}
+
+// a * b in a new matrix from resource; a must not be empty.
+template <class T>
+S21BasicMatrix<T> ViewProduct(s21::MatrixView<const T> a,
+                              s21::MatrixView<const T> b,
+                              std::pmr::memory_resource *resource) {
+  if (b.Empty()) throw std::runtime_error("Error: matrix is null");
+  if (a.Cols() != b.Rows()) {
+    throw std::runtime_error("Error: impossible to multiply");
+  }
+  S21BasicMatrix<T> res(a.Rows(), b.Cols(), resource);
+  s21::Gemm<T>(1, a, b, 0, res.View());
+  return res;
+}
+
+}  // namespace
+
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix() noexcept
+    : S21BasicMatrix(std::pmr::get_default_resource()) {}
 
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(std::pmr::memory_resource *resource) noexcept
+    : rows_(0),
+      cols_(0),
+      stride_(0),
+      matrix_(nullptr),
+      capacity_(0),
+      resource_(resource) {}
+
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols,
+                                  std::pmr::memory_resource *resource)
+    : rows_(rows), cols_(cols), matrix_(nullptr), resource_(resource) {
   if (rows <= 0 || cols <= 0) {
     throw std::invalid_argument("Rows or columns is less or equal 0");
   }
   CreateMatrix();
 }
 
-S21Matrix::S21Matrix(const S21Matrix &other) {
-  rows_ = other.rows_;
-  cols_ = other.cols_;
-  CreateMatrix();
-  for (auto i = 0; i < rows_; ++i) {
-    for (auto j = 0; j < cols_; ++j) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix &other)
+    : S21BasicMatrix(other, std::pmr::get_default_resource()) {}
+
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix &other,
+                                  std::pmr::memory_resource *resource)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(0),
+      matrix_(nullptr),
+      capacity_(0),
+      resource_(resource) {
+  if (other.matrix_ != nullptr) {
+    CreateMatrix();
+    std::memcpy(matrix_, other.matrix_,
+                sizeof(T) * static_cast<std::size_t>(rows_) * stride_);
   }
 }
 
-S21Matrix::S21Matrix(S21Matrix &&other) noexcept
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix &&other) noexcept
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      matrix_(other.matrix_),
+      capacity_(other.capacity_),
+      resource_(other.resource_) {
   other.rows_ = 0;
   other.cols_ = 0;
+  other.stride_ = 0;
   other.matrix_ = nullptr;
+  other.capacity_ = 0;
 }
 
-S21Matrix::~S21Matrix() {
-  if (matrix_ != nullptr) {
-    for (int i = 0; i < rows_; i++) {
-      delete[] matrix_[i];
-    }
-    delete[] matrix_;
-  }
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(s21::MatrixView<const T> view,
+                                  std::pmr::memory_resource *resource)
+    : S21BasicMatrix(view.Rows(), view.Cols(), resource) {
+  s21::Copy<T>(view, View());
 }
 
-void S21Matrix::CreateMatrix() {
-  this->matrix_ = new double *[rows_]();
-  for (int i = 0; i < rows_; i++) {
-    this->matrix_[i] = new double[cols_]();
-  }
+template <class T>
+S21BasicMatrix<T>::~S21BasicMatrix() {
+  FreeMatrix();
 }
 
-void S21Matrix::CheckForEqual(const S21Matrix &other) const {
-  CheckNull();
-  other.CheckNull();
-  if (rows_ != other.rows_ || cols_ != other.cols_) {
-    throw std::runtime_error("Error: sizes are not equal");
+template <class T>
+void S21BasicMatrix<T>::CreateMatrix() {
+  const int per_line = static_cast<int>(kAlignment / sizeof(T));
+  stride_ = (cols_ + per_line - 1) / per_line * per_line;
+  capacity_ = static_cast<std::size_t>(rows_) * stride_;
+  matrix_ = static_cast<T *>(
+      resource_->allocate(sizeof(T) * capacity_, kAlignment));
+  std::memset(static_cast<void *>(matrix_), 0, sizeof(T) * capacity_);
+}
+
+template <class T>
+void S21BasicMatrix<T>::FreeMatrix() noexcept {
+  if (matrix_ != nullptr) {
+    resource_->deallocate(matrix_, sizeof(T) * capacity_, kAlignment);
+    matrix_ = nullptr;
   }
 }
 
-void S21Matrix::CheckNull() const {
+template <class T>
+void S21BasicMatrix<T>::CheckNull() const {
   if (rows_ <= 0 || cols_ <= 0 || matrix_ == nullptr) {
     throw std::runtime_error("Error: matrix is null");
   }
 }
 
-void S21Matrix::CheckSquare() const {
+template <class T>
+void S21BasicMatrix<T>::CheckSquare() const {
   CheckNull();
   if (rows_ != cols_) {
     throw std::invalid_argument("Error: matrix is not square");
   }
 }
 
-void S21Matrix::CheckMul(const S21Matrix &other) const {
-  CheckNull();
-  other.CheckNull();
-  if (rows_ != other.cols_) {
-    throw std::runtime_error("Error: impossible to multiply");
-  }
+template <class T>
+int S21BasicMatrix<T>::GetRows() const noexcept {
+  return rows_;
 }
 
-int S21Matrix::GetRows() const noexcept { return rows_; }
-
-int S21Matrix::GetCols() const noexcept { return cols_; }
+template <class T>
+int S21BasicMatrix<T>::GetCols() const noexcept {
+  return cols_;
+}
 
-double S21Matrix::GetValue(int row_index, int col_index) const {
+template <class T>
+T S21BasicMatrix<T>::GetValue(int row_index, int col_index) const {
   if (row_index < 0 || row_index >= rows_ || col_index < 0 ||
       col_index >= cols_) {
     throw std::out_of_range("Invalid row or column index!");
   }
-  return matrix_[row_index][col_index];
+  return matrix_[row_index * stride_ + col_index];
+}
+
+template <class T>
+T *S21BasicMatrix<T>::Data() noexcept {
+  return matrix_;
+}
+
+template <class T>
+const T *S21BasicMatrix<T>::Data() const noexcept {
+  return matrix_;
+}
+
+template <class T>
+int S21BasicMatrix<T>::Stride() const noexcept {
+  return stride_;
+}
+
+template <class T>
+std::pmr::memory_resource *S21BasicMatrix<T>::GetResource() const noexcept {
+  return resource_;
 }
 
-double **S21Matrix::GetMatrix() const noexcept { return matrix_; }
+template <class T>
+s21::MatrixView<T> S21BasicMatrix<T>::View() noexcept {
+  return s21::MatrixView<T>(matrix_, rows_, cols_, stride_);
+}
+
+template <class T>
+s21::MatrixView<const T> S21BasicMatrix<T>::View() const noexcept {
+  return s21::MatrixView<const T>(matrix_, rows_, cols_, stride_);
+}
 
-void S21Matrix::SetRows(int rows) {
+template <class T>
+void S21BasicMatrix<T>::SetRows(int rows) {
   if (rows <= 0) throw std::invalid_argument("Rows is less or equal 0");
   int tmp = rows < rows_ ? rows : rows_;
-  S21Matrix temp(rows, cols_);
-  for (int i = 0; i < tmp; i++) {
-    for (int j = 0; j < temp.cols_; j++) {
-      temp.matrix_[i][j] = this->matrix_[i][j];
-    }
-  }
-  *this = temp;
+  S21BasicMatrix temp(rows, cols_, resource_);
+  std::memcpy(static_cast<void *>(temp.matrix_), matrix_,
+              sizeof(T) * static_cast<std::size_t>(tmp) * stride_);
+  *this = std::move(temp);
 }
 
-void S21Matrix::SetCols(int cols) {
+template <class T>
+void S21BasicMatrix<T>::SetCols(int cols) {
   if (cols <= 0) throw std::invalid_argument("Columns is less or equal 0");
   int tmp = cols < cols_ ? cols : cols_;
-  S21Matrix temp(rows_, cols);
+  S21BasicMatrix temp(rows_, cols, resource_);
   for (int i = 0; i < temp.rows_; i++) {
-    for (int j = 0; j < tmp; j++) {
-      temp.matrix_[i][j] = this->matrix_[i][j];
-    }
+    std::memcpy(static_cast<void *>(temp.matrix_ + i * temp.stride_),
+                matrix_ + i * stride_, sizeof(T) * tmp);
   }
-  *this = temp;
+  *this = std::move(temp);
 }
 
-void S21Matrix::SetValue(int row_index, int col_index, double value) {
+template <class T>
+void S21BasicMatrix<T>::SetValue(int row_index, int col_index, T value) {
   if (row_index < 0 || row_index >= rows_ || col_index < 0 ||
       col_index >= cols_) {
     throw std::out_of_range("Rows or columns is less or equal 0");
   }
-  matrix_[row_index][col_index] = value;
+  matrix_[row_index * stride_ + col_index] = value;
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix &other) const {
-  CheckNull();
+template <class T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix &other) const {
   other.CheckNull();
-  if (rows_ != other.rows_ || cols_ != other.cols_) {
-    return false;
-  } else {
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        if (fabs(matrix_[i][j] - other.matrix_[i][j]) > 1e-07) {
-          return false;
-        }
-      }
-    }
-    return true;
-  }
+  return EqMatrix(other.View());
 }
 
-void S21Matrix::SumMatrix(const S21Matrix &other) {
+template <class T>
+bool S21BasicMatrix<T>::EqMatrix(s21::MatrixView<const T> other) const {
   CheckNull();
-  other.CheckNull();
-  CheckForEqual(other);
-  for (int i = 0; i < rows_; i++)
-    for (int j = 0; j < cols_; ++j) matrix_[i][j] += other.matrix_[i][j];
+  if (other.Empty()) throw std::runtime_error("Error: matrix is null");
+  return s21::Equal<T>(View(), other, s21::ScalarTraits<T>::kTolerance);
+}
+
+template <class T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix &other) {
+  SumMatrix(other.View());
 }
 
-void S21Matrix::SubMatrix(const S21Matrix &other) {
+template <class T>
+void S21BasicMatrix<T>::SumMatrix(s21::MatrixView<const T> other) {
   CheckNull();
-  other.CheckNull();
-  CheckForEqual(other);
-  for (int i = 0; i < rows_; i++)
-    for (int j = 0; j < cols_; ++j) matrix_[i][j] -= other.matrix_[i][j];
+  s21::Add(View(), other);
 }
 
-void S21Matrix::MulNumber(const double num) {
+template <class T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix &other) {
+  SubMatrix(other.View());
+}
+
+template <class T>
+void S21BasicMatrix<T>::SubMatrix(s21::MatrixView<const T> other) {
   CheckNull();
-  for (int i = 0; i < rows_; i++)
-    for (int j = 0; j < cols_; ++j) matrix_[i][j] *= num;
+  s21::Sub(View(), other);
 }
 
-void S21Matrix::MulMatrix(const S21Matrix &other) {
+template <class T>
+void S21BasicMatrix<T>::MulNumber(const T num) {
   CheckNull();
-  other.CheckNull();
-  CheckMul(other);
-  S21Matrix res(rows_, other.cols_);
-  for (int i = 0; i < res.rows_; i++) {
-    for (int y = 0; y < res.cols_; y++) {
-      for (int k = 0, m = 0; m < cols_ && k < res.cols_; k++) {
-        res.matrix_[i][y] =
-            res.matrix_[i][y] + (matrix_[i][k] * other.matrix_[k][y]);
-      }
-    }
-  }
-  *this = res;
+  s21::Scale(View(), num);
+}
+
+template <class T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix &other) {
+  MulMatrix(other.View());
+}
+
+template <class T>
+void S21BasicMatrix<T>::MulMatrix(s21::MatrixView<const T> other) {
+  *this = Product(other);
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Product(
+    s21::MatrixView<const T> other) const {
+  CheckNull();
+  return ViewProduct(View(), other, resource_);
 }
 
-S21Matrix S21Matrix::Transpose() const {
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() const {
   CheckNull();
-  S21Matrix other(cols_, rows_);
+  S21BasicMatrix other(cols_, rows_, resource_);
+  s21::Transpose<T>(View(), other.View());
+  return other;
+}
+
+template <class T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  CheckNull();
+  if (rows_ == cols_) {
+    s21::TransposeInPlace<T>(View());
+    return;
+  }
+  const int per_line = static_cast<int>(kAlignment / sizeof(T));
+  const int stride = (rows_ + per_line - 1) / per_line * per_line;
+  if (static_cast<std::size_t>(cols_) * stride > capacity_) {
+    *this = Transpose();
+    return;
+  }
+  for (int i = 1; i < rows_; i++) {
+    std::memmove(static_cast<void *>(matrix_ + i * cols_),
+                 matrix_ + i * stride_, sizeof(T) * cols_);
+  }
+  CycleTranspose(matrix_, rows_, cols_, resource_);
+  // Rows move down, so going backwards never overwrites an unmoved row.
+  for (int i = cols_ - 1; i > 0; i--) {
+    std::memmove(static_cast<void *>(matrix_ + i * stride),
+                 matrix_ + i * rows_, sizeof(T) * rows_);
+  }
+  std::swap(rows_, cols_);
+  stride_ = stride;
   for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      other.matrix_[j][i] = matrix_[i][j];
+    std::memset(static_cast<void *>(matrix_ + i * stride_ + cols_), 0,
+                sizeof(T) * (stride_ - cols_));
+  }
+}
+
+template <class T>
+T S21BasicMatrix<T>::Determinant() const {
+  CheckNull();
+  CheckSquare();
+  if constexpr (std::is_integral<T>::value) {
+    // Closed forms in T would overflow, so every size goes through the
+    // wide elimination.
+    const std::int64_t det = ExactDeterminant(*this);
+    if (det < std::numeric_limits<T>::min() ||
+        det > std::numeric_limits<T>::max()) {
+      throw std::overflow_error("Error: determinant overflows");
+    }
+    return static_cast<T>(det);
+  } else {
+    if (rows_ == 1) return matrix_[0];
+    if (rows_ == 2)
+      return matrix_[0] * matrix_[stride_ + 1] - matrix_[1] * matrix_[stride_];
+    if (rows_ == 3) {
+      const T *r0 = matrix_;
+      const T *r1 = matrix_ + stride_;
+      const T *r2 = matrix_ + 2 * stride_;
+      return r0[0] * (r1[1] * r2[2] - r1[2] * r2[1]) -
+             r0[1] * (r1[0] * r2[2] - r1[2] * r2[0]) +
+             r0[2] * (r1[0] * r2[1] - r1[1] * r2[0]);
     }
+    S21BasicMatrix lu(resource_);
+    std::pmr::vector<int> pivots(resource_);
+    if (FactorLu(*this, lu, pivots) != 0) return T(0);
+    return s21::LuDeterminant(rows_, lu.matrix_, lu.stride_, pivots.data());
   }
-  return other;
 }
 
-double S21Matrix::Determinant() const {
+template <class T>
+double S21BasicMatrix<T>::LogDeterminant(int &sign) const {
   CheckNull();
   CheckSquare();
-  double det = 0.0;
-  int sign = 1;
-  if (rows_ == 1) return matrix_[0][0];
-  if (rows_ == 2)
-    return matrix_[0][0] * matrix_[1][1] - matrix_[0][1] * matrix_[1][0];
-  S21Matrix temp(rows_ - 1, rows_ - 1);
-  for (int i = 0; i < rows_; i++) {
-    Minor(*this, temp, 0, i, rows_);
-    det += sign * matrix_[0][i] * temp.Determinant();
-    sign *= -1;
-  }
-  return det;
-}
-
-void S21Matrix::Minor(const S21Matrix &matr, S21Matrix &temp, int p, int q,
-                      int size) const {
-  int out_rows = 0;
-  for (int i = 0; i < size - 1; i++) {
-    if (i == p) out_rows = 1;
-    int out_columns = 0;
-    for (int j = 0; j < size - 1; j++) {
-      if (j == q) out_columns = 1;
-      temp.matrix_[i][j] = matr.matrix_[i + out_rows][j + out_columns];
+  if constexpr (std::is_integral<T>::value) {
+    return ToDouble(*this).LogDeterminant(sign);
+  } else {
+    S21BasicMatrix lu(resource_);
+    std::pmr::vector<int> pivots(resource_);
+    if (FactorLu(*this, lu, pivots) != 0) {
+      sign = 0;
+      return -HUGE_VAL;
     }
+    double log_det = 0.0;
+    sign = 1;
+    for (int i = 0; i < rows_; i++) {
+      T pivot = lu.matrix_[i * lu.stride_ + i];
+      log_det += log(static_cast<double>(std::abs(pivot)));
+      if constexpr (!s21::IsComplex<T>::value) {
+        if ((pivot < 0) != (pivots[i] != i)) sign = -sign;
+      }
+    }
+    return log_det;
+  }
+}
+
+template <class T>
+void S21BasicMatrix<T>::Minor(const S21BasicMatrix &matr, S21BasicMatrix &temp,
+                              int p, int q, int size) const {
+  // The four blocks around row p and column q, copied row by row.
+  s21::MatrixView<const T> src = matr.View().Block(0, 0, size, size);
+  s21::MatrixView<T> dst = temp.View().Block(0, 0, size - 1, size - 1);
+  const int below = size - 1 - p;
+  const int right = size - 1 - q;
+  if (p > 0 && q > 0) {
+    s21::Copy<T>(src.Block(0, 0, p, q), dst.Block(0, 0, p, q));
+  }
+  if (p > 0 && right > 0) {
+    s21::Copy<T>(src.Block(0, q + 1, p, right), dst.Block(0, q, p, right));
+  }
+  if (below > 0 && q > 0) {
+    s21::Copy<T>(src.Block(p + 1, 0, below, q), dst.Block(p, 0, below, q));
+  }
+  if (below > 0 && right > 0) {
+    s21::Copy<T>(src.Block(p + 1, q + 1, below, right),
+                 dst.Block(p, q, below, right));
   }
 }
 
-S21Matrix S21Matrix::CalcComplements() const {
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() const {
   CheckNull();
   CheckSquare();
   if (rows_ == 1) {
-    S21Matrix result(1, 1);
-    result.matrix_[0][0] = 1;
+    S21BasicMatrix result(1, 1, resource_);
+    result.matrix_[0] = 1;
     return result;
   }
-  S21Matrix result(rows_, cols_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; ++j) {
-      S21Matrix temp(rows_ - 1, cols_ - 1);
-      Minor(*this, temp, i, j, rows_);
-      result.matrix_[i][j] = temp.Determinant() * pow(-1, i + j);
+  S21BasicMatrix result(rows_, cols_, resource_);
+  if constexpr (std::is_integral<T>::value) {
+    if (rows_ > 3) {
+      S21Matrix complements = ToDouble(*this).CalcComplements();
+      for (int i = 0; i < rows_; i++) {
+        for (int j = 0; j < cols_; j++) {
+          result.matrix_[i * result.stride_ + j] =
+              static_cast<T>(llround(complements(i, j)));
+        }
+      }
+      return result;
     }
   }
+  if (rows_ <= 3) {
+    S21BasicMatrix temp(rows_ - 1, cols_ - 1, resource_);
+    for (int i = 0; i < rows_; i++) {
+      for (int j = 0; j < cols_; ++j) {
+        Minor(*this, temp, i, j, rows_);
+        result.matrix_[i * result.stride_ + j] =
+            (i + j) % 2 ? -temp.Determinant() : temp.Determinant();
+      }
+    }
+    return result;
+  }
+  if constexpr (!std::is_integral<T>::value) {
+    S21BasicMatrix lu(resource_);
+    std::pmr::vector<int> pivots(resource_);
+    FactorLu(*this, lu, pivots);
+    int k = 0;
+    int nullity = s21::LuNullity(rows_, lu.matrix_, lu.stride_, &k);
+    if (nullity == 0) {
+      // C = det(A) * A^-T.
+      T det = s21::LuDeterminant(rows_, lu.matrix_, lu.stride_, pivots.data());
+      S21BasicMatrix inverse(rows_, cols_, resource_);
+      for (int i = 0; i < rows_; i++) {
+        inverse.matrix_[i * inverse.stride_ + i] = 1;
+      }
+      s21::LuSolve(rows_, cols_, lu.matrix_, lu.stride_, pivots.data(),
+                   inverse.matrix_, inverse.stride_);
+      for (int i = 0; i < rows_; i++) {
+        for (int j = 0; j < cols_; j++) {
+          result.matrix_[i * result.stride_ + j] =
+              det * inverse.matrix_[j * inverse.stride_ + i];
+        }
+      }
+    } else if (nullity == 1) {
+      // Rank n - 1: adj(A) spans the null spaces, so C = s * y * x^T with
+      // A x = 0 and A^T y = 0. The scale comes from the largest cofactor.
+      std::pmr::vector<T> x(rows_, resource_), y(rows_, resource_);
+      s21::LuNullVectors(rows_, lu.matrix_, lu.stride_, pivots.data(), k,
+                         x.data(), y.data());
+      int p = 0, q = 0;
+      for (int i = 1; i < rows_; i++) {
+        if (std::abs(y[i]) > std::abs(y[p])) p = i;
+        if (std::abs(x[i]) > std::abs(x[q])) q = i;
+      }
+      S21BasicMatrix minor(rows_ - 1, cols_ - 1, resource_);
+      Minor(*this, minor, p, q, rows_);
+      T cofactor = (p + q) % 2 ? -minor.Determinant() : minor.Determinant();
+      T scale = cofactor / (y[p] * x[q]);
+      for (int i = 0; i < rows_; i++) {
+        for (int j = 0; j < cols_; j++) {
+          result.matrix_[i * result.stride_ + j] = scale * y[i] * x[j];
+        }
+      }
+    }
+  }
+  // Rank n - 2 or less: every (n - 1) x (n - 1) minor vanishes.
   return result;
 }
 
-S21Matrix S21Matrix::InverseMatrix() const {
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() const {
   CheckSquare();
-  if (fabs(Determinant()) < 1e-06) throw std::logic_error("Determinant is 0");
-  S21Matrix tran = CalcComplements().Transpose();
-  S21Matrix res(rows_, cols_);
-  for (auto i = 0; i < rows_; i++)
-    for (auto j = 0; j < cols_; j++)
-      res.matrix_[i][j] = tran.matrix_[i][j] / Determinant();
-  return res;
+  if constexpr (std::is_integral<T>::value) {
+    // A^-1 = adj(A) / det(A) is an integer matrix only for det(A) = +-1.
+    CheckNull();
+    const std::int64_t det = ExactDeterminant(*this);
+    if (det == 0) throw std::logic_error("Determinant is 0");
+    if (det != 1 && det != -1) {
+      throw std::logic_error("Inverse is not an integer matrix");
+    }
+    S21BasicMatrix res = CalcComplements().Transpose();
+    res.MulNumber(static_cast<T>(det));
+    return res;
+  } else {
+    return S21BasicLuFactorization<T>(*this).Inverse();
+  }
+}
+
+template <class T>
+void S21BasicMatrix<T>::PrintMatrix() const {
+  // One line per row, formatted by to_chars into a reused buffer.
+  std::string line(static_cast<std::size_t>(cols_) * (s21::kMaxScalarChars + 1),
+                   '\0');
+  for (int i = 0; i < rows_; i++) {
+    char *p = &line[0];
+    for (int j = 0; j < cols_; j++) {
+      if (j > 0) *p++ = ' ';
+      p = s21::FormatScalar(p, matrix_[i * stride_ + j]);
+    }
+    *p++ = '\n';
+    std::cout.write(line.data(), p - line.data());
+  }
 }
 
-double &S21Matrix::operator()(int i, int j) {
-  if (i > rows_ || i < 0 || j > cols_ || j < 0)
+template <class T>
+T &S21BasicMatrix<T>::operator()(int i, int j) {
+  if (i >= rows_ || i < 0 || j >= cols_ || j < 0)
     throw std::out_of_range("Incorrect input, index is out of range");
-  return matrix_[i][j];
+  return matrix_[i * stride_ + j];
 }
 
-double S21Matrix::operator()(const int i, const int j) const {
-  if (i > rows_ || i < 0 || j > cols_ || j < 0)
+template <class T>
+T S21BasicMatrix<T>::operator()(const int i, const int j) const {
+  if (i >= rows_ || i < 0 || j >= cols_ || j < 0)
     throw std::out_of_range("Incorrect input, index is out of range");
-  return matrix_[i][j];
+  return matrix_[i * stride_ + j];
 }
 
-S21Matrix &S21Matrix::operator+=(const S21Matrix &o) {
+template <class T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator+=(const S21BasicMatrix &o) {
   SumMatrix(o);
   return *this;
 }
 
-S21Matrix S21Matrix::operator+(const S21Matrix &o) const {
-  S21Matrix res{*this};
-  return res += o;
-}
-
-S21Matrix &S21Matrix::operator-=(const S21Matrix &o) {
+template <class T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator-=(const S21BasicMatrix &o) {
   SubMatrix(o);
   return *this;
 }
 
-S21Matrix S21Matrix::operator-(const S21Matrix &o) const {
-  S21Matrix res{*this};
-  return res -= o;
+template <class T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(const S21BasicMatrix &o) {
+  MulMatrix(o);
+  return *this;
 }
 
-S21Matrix &S21Matrix::operator*=(const S21Matrix &o) {
-  MulMatrix(o);
+template <class T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(
+    s21::TransposedMatrix<T> o) {
+  MulMatrix(o.View());
   return *this;
 }
 
-S21Matrix &S21Matrix::operator*=(const double &value) {
+template <class T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(const T &value) {
   MulNumber(value);
   return *this;
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix &o) const {
-  S21Matrix res{*this};
-  return res *= o;
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(const S21BasicMatrix &o) const {
+  return Product(o.View());
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    s21::TransposedMatrix<T> o) const {
+  return Product(o.View());
+}
+
+template <class T>
+s21::TransposedMatrix<T> S21BasicMatrix<T>::Transposed() const & noexcept {
+  return s21::TransposedMatrix<T>(*this);
+}
+
+template <class T>
+S21BasicMatrix<T> s21::TransposedMatrix<T>::operator*(
+    const S21BasicMatrix<T> &o) const {
+  m_.CheckNull();
+  return ViewProduct(View(), o.View(), m_.resource_);
 }
 
-bool S21Matrix::operator==(const S21Matrix &o) const noexcept {
+template <class T>
+S21BasicMatrix<T> s21::TransposedMatrix<T>::operator*(
+    TransposedMatrix o) const {
+  m_.CheckNull();
+  return ViewProduct(View(), o.View(), m_.resource_);
+}
+
+template <class T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix &o) const noexcept {
   return EqMatrix(o);
 }
 
-S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
-  if (this != &other) {
-    for (int i = 0; i < rows_; ++i) {
-      delete[] matrix_[i];
-    }
-    delete[] matrix_;
-    rows_ = other.rows_;
-    cols_ = other.cols_;
-    matrix_ = new double *[rows_];
-    for (int i = 0; i < rows_; ++i) {
-      matrix_[i] = new double[cols_];
-      for (int j = 0; j < cols_; ++j) {
-        matrix_[i][j] = other.matrix_[i][j];
-      }
-    }
+template <class T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(const S21BasicMatrix &other) {
+  if (this == &other) return *this;
+  if (matrix_ != nullptr && rows_ == other.rows_ && cols_ == other.cols_) {
+    // Same shape means same stride: reuse the buffer.
+    std::memcpy(static_cast<void *>(matrix_), other.matrix_,
+                sizeof(T) * static_cast<std::size_t>(rows_) * stride_);
+  } else {
+    *this = S21BasicMatrix(other, resource_);
   }
   return *this;
 }
 
-S21Matrix &operator*(const double num, S21Matrix &matrix) {
-  matrix.MulNumber(num);
-  return matrix;
+template <class T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(S21BasicMatrix &&other) {
+  if (this == &other) return *this;
+  if (*resource_ != *other.resource_) return *this = other;
+  FreeMatrix();
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  stride_ = other.stride_;
+  matrix_ = other.matrix_;
+  capacity_ = other.capacity_;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.stride_ = 0;
+  other.matrix_ = nullptr;
+  other.capacity_ = 0;
+  return *this;
 }
 
-S21Matrix &operator*(S21Matrix &matrix, const double num) {
-  matrix.MulNumber(num);
-  return matrix;
-}
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<std::int32_t>;
+template class S21BasicMatrix<std::complex<double>>;
+
+template class s21::TransposedMatrix<float>;
+template class s21::TransposedMatrix<double>;
+template class s21::TransposedMatrix<std::int32_t>;
+template class s21::TransposedMatrix<std::complex<double>>;
@@ -3,65 +3,253 @@
 
 #include <math.h>
 
+#include <complex>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <exception>
 #include <iostream>
+#include <memory_resource>
+#include <utility>
+#include <vector>
 
-class S21Matrix {
+#include "s21_matrix_view.h"
+#include "s21_scalar_traits.h"
+
+namespace s21 {
+template <class E>
+struct MatrixExpr;
+template <class T>
+class TransposedMatrix;
+}  // namespace s21
+
+// Dense matrix of T, instantiated for float, double, std::int32_t and
+// std::complex<double> (see s21::ScalarTraits). S21Matrix is the double
+// version.
+//
+// Integer matrices compute Determinant exactly (fraction-free elimination
+// in 64 bits) and throw std::overflow_error when it does not fit the
+// element type; CalcComplements and LogDeterminant run in double
+// precision, and InverseMatrix only succeeds when the determinant is +-1,
+// i.e. when the inverse is an integer matrix too.
+//
+// Storage comes from a std::pmr::memory_resource, the default resource
+// unless one is given. As with the std::pmr containers, a copy uses the
+// default resource, a move keeps the resource, and assignment keeps the
+// target's own. Results computed from a matrix (products, Transpose,
+// CalcComplements, InverseMatrix) and the scratch space of the
+// factorizations use that matrix's resource, so with an s21::Arena a
+// request's temporaries never reach the heap.
+template <class T>
+class S21BasicMatrix {
  public:
-  S21Matrix() noexcept;
-  S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix &other);
-  S21Matrix(S21Matrix &&other) noexcept;
-  ~S21Matrix();
-
-  double &operator()(int i, int j);
-  S21Matrix &operator=(const S21Matrix &other);
-  bool operator==(const S21Matrix &o) const noexcept;
-  double operator()(const int i, const int j) const;
-  S21Matrix &operator+=(const S21Matrix &o);
-  S21Matrix operator+(const S21Matrix &o) const;
-  S21Matrix &operator-=(const S21Matrix &o);
-  S21Matrix operator-(const S21Matrix &o) const;
-  S21Matrix &operator*=(const S21Matrix &o);
-  S21Matrix &operator*=(const double &value);
-  S21Matrix operator*(const S21Matrix &o) const;
-  friend S21Matrix &operator*(const double num, S21Matrix &matrix);
-  friend S21Matrix &operator*(S21Matrix &matrix, const double num);
+  using Scalar = T;
+
+  S21BasicMatrix() noexcept;
+  explicit S21BasicMatrix(std::pmr::memory_resource *resource) noexcept;
+  S21BasicMatrix(
+      int rows, int cols,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+  S21BasicMatrix(const S21BasicMatrix &other);
+  S21BasicMatrix(const S21BasicMatrix &other,
+                 std::pmr::memory_resource *resource);
+  S21BasicMatrix(S21BasicMatrix &&other) noexcept;
+  // Copies the viewed elements into a new matrix.
+  explicit S21BasicMatrix(
+      s21::MatrixView<const T> view,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+  template <class E>
+  S21BasicMatrix(
+      const s21::MatrixExpr<E> &expr,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+  ~S21BasicMatrix();
+
+  T &operator()(int i, int j);
+  S21BasicMatrix &operator=(const S21BasicMatrix &other);
+  // Takes other's buffer when both use equal resources and copies into
+  // this matrix's resource otherwise.
+  S21BasicMatrix &operator=(S21BasicMatrix &&other);
+  template <class E>
+  S21BasicMatrix &operator=(const s21::MatrixExpr<E> &expr);
+  bool operator==(const S21BasicMatrix &o) const noexcept;
+  T operator()(const int i, const int j) const;
+  S21BasicMatrix &operator+=(const S21BasicMatrix &o);
+  S21BasicMatrix &operator-=(const S21BasicMatrix &o);
+  // Evaluated into this matrix's buffer without a temporary.
+  template <class E>
+  S21BasicMatrix &operator+=(const s21::MatrixExpr<E> &expr);
+  template <class E>
+  S21BasicMatrix &operator-=(const s21::MatrixExpr<E> &expr);
+  S21BasicMatrix &operator*=(const S21BasicMatrix &o);
+  S21BasicMatrix &operator*=(s21::TransposedMatrix<T> o);
+  S21BasicMatrix &operator*=(const T &value);
+  S21BasicMatrix operator*(const S21BasicMatrix &o) const;
+  S21BasicMatrix operator*(s21::TransposedMatrix<T> o) const;
 
   int GetRows() const noexcept;
   int GetCols() const noexcept;
-  double **GetMatrix() const noexcept;
-  double GetValue(int row_index, int col_index) const;
+  T *Data() noexcept;
+  const T *Data() const noexcept;
+  int Stride() const noexcept;
+  std::pmr::memory_resource *GetResource() const noexcept;
+  // Views of the whole matrix; Block, Row, Col and Transposed on the
+  // result slice it without copying.
+  s21::MatrixView<T> View() noexcept;
+  s21::MatrixView<const T> View() const noexcept;
+  T GetValue(int row_index, int col_index) const;
   void SetRows(int rows);
   void SetCols(int cols);
-  void SetValue(int row_index, int col_index, double value);
+  void SetValue(int row_index, int col_index, T value);
   void InitMatrix();
   void InitMatrixForMaths();
   void InitOtherMatrix();
 
-  bool EqMatrix(const S21Matrix &other) const;
-  void SumMatrix(const S21Matrix &other);
-  void SubMatrix(const S21Matrix &other);
-  void MulNumber(const double num);
-  void MulMatrix(const S21Matrix &other);
-  S21Matrix Transpose() const;
-  S21Matrix CalcComplements() const;
-  double Determinant() const;
-  S21Matrix InverseMatrix() const;
+  // Elements equal within s21::ScalarTraits<T>::kTolerance.
+  bool EqMatrix(const S21BasicMatrix &other) const;
+  bool EqMatrix(s21::MatrixView<const T> other) const;
+  void SumMatrix(const S21BasicMatrix &other);
+  void SumMatrix(s21::MatrixView<const T> other);
+  void SubMatrix(const S21BasicMatrix &other);
+  void SubMatrix(s21::MatrixView<const T> other);
+  void MulNumber(const T num);
+  void MulMatrix(const S21BasicMatrix &other);
+  void MulMatrix(s21::MatrixView<const T> other);
+  S21BasicMatrix Transpose() const;
+  // This matrix read transposed, without a copy: A.Transposed() * B and
+  // A * B.Transposed() hand strided views to GEMM. Not available on
+  // temporaries, which would be gone before the product runs.
+  s21::TransposedMatrix<T> Transposed() const & noexcept;
+  s21::TransposedMatrix<T> Transposed() const && = delete;
+  // Transposes without a second matrix. Square matrices swap mirrored
+  // blocks; rectangular ones are packed, permuted by following the cycles
+  // of the transposition and padded again within the same buffer (a bit
+  // per element marks visited positions). Only when the new padding does
+  // not fit the buffer is a new one allocated.
+  void TransposeInPlace();
+  S21BasicMatrix CalcComplements() const;
+  T Determinant() const;
+  // log |det|, with the sign of det in sign (0 if singular). Complex
+  // matrices report only 1 or 0 there; the phase is not tracked.
+  double LogDeterminant(int &sign) const;
+  S21BasicMatrix InverseMatrix() const;
   void PrintMatrix() const;
-  void Minor(const S21Matrix &matr, S21Matrix &temp, int p, int q,
+  void Minor(const S21BasicMatrix &matr, S21BasicMatrix &temp, int p, int q,
              int size) const;
 
  private:
+  // Rows are stored back to back in one buffer aligned to kAlignment bytes.
+  // Each row is padded to stride_ elements so every row starts aligned too.
+  static constexpr std::size_t kAlignment = 64;
   int rows_;
   int cols_;
-  double **matrix_;
+  int stride_;
+  T *matrix_;
+  // Elements allocated, at least rows_ * stride_ (TransposeInPlace can
+  // leave a smaller shape in the buffer).
+  std::size_t capacity_;
+  std::pmr::memory_resource *resource_;
   void CreateMatrix();
-  void CheckForEqual(const S21Matrix &other) const;
+  void FreeMatrix() noexcept;
+  S21BasicMatrix Product(s21::MatrixView<const T> other) const;
+  friend class s21::TransposedMatrix<T>;
   void CheckNull() const;
   void CheckSquare() const;
-  void CheckMul(const S21Matrix &other) const;
 };
 
+namespace s21 {
+
+// Transposed operand of a product, made by S21BasicMatrix::Transposed().
+// It only borrows the matrix: GEMM packs the operand straight from the
+// transposed view (the packing absorbs the strides), so the product
+// allocates nothing but its result, which uses the borrowed matrix's
+// resource. Copy to a matrix with S21BasicMatrix(t.View()).
+template <class T>
+class TransposedMatrix {
+ public:
+  explicit TransposedMatrix(const S21BasicMatrix<T> &m) noexcept : m_(m) {}
+
+  int GetRows() const noexcept { return m_.GetCols(); }
+  int GetCols() const noexcept { return m_.GetRows(); }
+  MatrixView<const T> View() const noexcept { return m_.View().Transposed(); }
+  S21BasicMatrix<T> operator*(const S21BasicMatrix<T> &o) const;
+  S21BasicMatrix<T> operator*(TransposedMatrix o) const;
+
+ private:
+  const S21BasicMatrix<T> &m_;
+};
+
+extern template class TransposedMatrix<float>;
+extern template class TransposedMatrix<double>;
+extern template class TransposedMatrix<std::int32_t>;
+extern template class TransposedMatrix<std::complex<double>>;
+
+}  // namespace s21
+
+using S21Matrix = S21BasicMatrix<double>;
+using S21FloatMatrix = S21BasicMatrix<float>;
+using S21IntMatrix = S21BasicMatrix<std::int32_t>;
+using S21ComplexMatrix = S21BasicMatrix<std::complex<double>>;
+
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<std::int32_t>;
+extern template class S21BasicMatrix<std::complex<double>>;
+
+// Operators on an expiring matrix reuse its buffer for the result.
+template <class T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T> &&l,
+                            const S21BasicMatrix<T> &r) {
+  l.SumMatrix(r);
+  return std::move(l);
+}
+
+template <class T>
+S21BasicMatrix<T> operator+(const S21BasicMatrix<T> &l,
+                            S21BasicMatrix<T> &&r) {
+  r.SumMatrix(l);
+  return std::move(r);
+}
+
+template <class T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T> &&l, S21BasicMatrix<T> &&r) {
+  l.SumMatrix(r);
+  return std::move(l);
+}
+
+template <class T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T> &&l,
+                            const S21BasicMatrix<T> &r) {
+  l.SubMatrix(r);
+  return std::move(l);
+}
+
+template <class T>
+S21BasicMatrix<T> operator-(const S21BasicMatrix<T> &l,
+                            S21BasicMatrix<T> &&r) {
+  r = l - r;
+  return std::move(r);
+}
+
+template <class T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T> &&l, S21BasicMatrix<T> &&r) {
+  l.SubMatrix(r);
+  return std::move(l);
+}
+
+template <class T>
+S21BasicMatrix<T> operator*(S21BasicMatrix<T> &&m, s21::NonDeduced<T> value) {
+  m.MulNumber(value);
+  return std::move(m);
+}
+
+template <class T>
+S21BasicMatrix<T> operator*(s21::NonDeduced<T> value, S21BasicMatrix<T> &&m) {
+  m.MulNumber(value);
+  return std::move(m);
+}
+
+// operator+, operator- and scalar operator* on lvalues and expressions
+// build lazy expressions.
+#include "s21_matrix_expr.h"
+
 #endif
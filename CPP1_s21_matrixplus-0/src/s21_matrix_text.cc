@@ -0,0 +1,516 @@
+#include "s21_matrix_text.h"
+
+#include <fcntl.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "s21_posix_file.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+// Inputs below this size per chunk are parsed on fewer threads.
+constexpr std::size_t kMinChunkBytes = std::size_t(1) << 20;
+// Upper bound on the text a writer formats per block.
+constexpr std::size_t kWriteBlockBytes = std::size_t(1) << 22;
+
+[[noreturn]] void ThrowParse(const std::string &path, long line,
+                             const std::string &what) {
+  throw std::runtime_error(path + ":" + std::to_string(line) + ": " + what);
+}
+
+bool IsBlank(char c) { return c == ' ' || c == '\t'; }
+
+// Strips trailing blanks and line breaks.
+const char *TrimEnd(const char *begin, const char *end) {
+  while (end > begin && (IsBlank(end[-1]) || end[-1] == '\n' ||
+                         end[-1] == '\r')) {
+    --end;
+  }
+  return end;
+}
+
+// Skips blanks other than keep, which may be a blank delimiter.
+const char *SkipBlanks(const char *p, const char *end, char keep) {
+  while (p < end && IsBlank(*p) && *p != keep) ++p;
+  return p;
+}
+
+// Parses one number surrounded by optional blanks; nullptr on failure.
+template <class T>
+const char *ParseScalar(const char *p, const char *end, char keep, T &value) {
+  p = SkipBlanks(p, end, keep);
+  if (p < end && *p == '+') ++p;
+  std::from_chars_result result = std::from_chars(p, end, value);
+  if (result.ec != std::errc()) return nullptr;
+  return SkipBlanks(result.ptr, end, keep);
+}
+
+long CountLineBreaks(const char *p, const char *end) {
+  long count = 0;
+  while ((p = static_cast<const char *>(std::memchr(p, '\n', end - p)))) {
+    ++count;
+    ++p;
+  }
+  return count;
+}
+
+// Text cut at line breaks into chunks for the thread pool. Chunk c spans
+// starts[c] .. starts[c + 1] and begins with line first_lines[c].
+struct LineChunks {
+  std::vector<const char *> starts;
+  std::vector<long> first_lines;
+  long lines = 0;
+};
+
+// begin .. end must not end in a line break (see TrimEnd).
+LineChunks SplitLines(const char *begin, const char *end) {
+  LineChunks chunks;
+  if (begin == end) return chunks;
+  const std::size_t size = static_cast<std::size_t>(end - begin);
+  const long parts = std::max<long>(
+      1, std::min<long>(ThreadCount() * 4L, size / kMinChunkBytes));
+  chunks.starts.push_back(begin);
+  for (long p = 1; p < parts; ++p) {
+    const char *cut = begin + size * p / parts;
+    if (cut <= chunks.starts.back()) continue;
+    const char *line_break =
+        static_cast<const char *>(std::memchr(cut, '\n', end - cut));
+    if (line_break == nullptr) break;
+    chunks.starts.push_back(line_break + 1);
+  }
+  chunks.starts.push_back(end);
+  const long count = static_cast<long>(chunks.starts.size()) - 1;
+  chunks.first_lines.resize(count);
+  std::vector<long> breaks(count);
+  ParallelFor(count, 1, [&](long first, long last) {
+    for (long c = first; c < last; ++c) {
+      breaks[c] = CountLineBreaks(chunks.starts[c], chunks.starts[c + 1]);
+    }
+  });
+  // Every chunk but the last ends with its line break.
+  for (long c = 0; c < count; ++c) {
+    chunks.first_lines[c] = chunks.lines;
+    chunks.lines += breaks[c];
+  }
+  ++chunks.lines;
+  return chunks;
+}
+
+// Calls parse(begin, end, index) for every line in parallel, without the
+// line break or a trailing '\r'.
+template <class Parse>
+void ParseLines(const LineChunks &chunks, const Parse &parse) {
+  const long count = static_cast<long>(chunks.first_lines.size());
+  ParallelFor(count, 1, [&](long first, long last) {
+    for (long c = first; c < last; ++c) {
+      const char *p = chunks.starts[c], *stop = chunks.starts[c + 1];
+      for (long line = chunks.first_lines[c]; p < stop; ++line) {
+        const char *line_break =
+            static_cast<const char *>(std::memchr(p, '\n', stop - p));
+        const char *next = line_break != nullptr ? line_break + 1 : stop;
+        const char *line_end = line_break != nullptr ? line_break : stop;
+        if (line_end > p && line_end[-1] == '\r') --line_end;
+        parse(p, line_end, line);
+        p = next;
+      }
+    }
+  });
+}
+
+// Writes header and then the text of blocks 0 .. count - 1 in order;
+// format(block, out) appends the text of one block to out. Groups of
+// blocks are formatted in parallel and written while the buffers are
+// still hot.
+template <class Format>
+void WriteText(const std::string &path, const std::string &header,
+               long count, const Format &format) {
+  FileDescriptor file(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644));
+  if (file.Get() < 0) ThrowErrno("open", path);
+  WriteAll(file.Get(), header.data(), header.size(), 0, path);
+  std::int64_t offset = static_cast<std::int64_t>(header.size());
+  const long group = 2L * ThreadCount();
+  std::vector<std::string> buffers(std::min(group, count));
+  for (long first = 0; first < count; first += group) {
+    const long blocks = std::min(group, count - first);
+    ParallelFor(blocks, 1, [&](long begin, long end) {
+      for (long b = begin; b < end; ++b) {
+        buffers[b].clear();
+        format(first + b, buffers[b]);
+      }
+    });
+    for (long b = 0; b < blocks; ++b) {
+      WriteAll(file.Get(), buffers[b].data(), buffers[b].size(), offset, path);
+      offset += static_cast<std::int64_t>(buffers[b].size());
+    }
+  }
+  if (file.Close() != 0) ThrowErrno("close", path);
+}
+
+// Grows out by room characters and returns where they start; Finish
+// trims out to the characters actually written.
+char *Reserve(std::string &out, std::size_t room) {
+  std::size_t used = out.size();
+  out.resize(used + room);
+  return &out[used];
+}
+
+void Finish(std::string &out, const char *end) {
+  out.resize(static_cast<std::size_t>(end - out.data()));
+}
+
+template <class T>
+const char *FieldName() {
+  return std::is_integral<T>::value ? "integer" : "real";
+}
+
+enum class Symmetry { kGeneral, kSymmetric, kSkew };
+
+// A MatrixMarket file parsed into coordinate entries (0-based, symmetric
+// storage expanded) or column-major array values.
+template <class T>
+struct MarketData {
+  int rows = 0;
+  int cols = 0;
+  bool coordinate = false;
+  Symmetry symmetry = Symmetry::kGeneral;
+  std::vector<Triplet<T>> entries;
+  std::vector<T> values;
+};
+
+std::string Lower(std::string word) {
+  for (char &c : word) c = static_cast<char>(std::tolower(c));
+  return word;
+}
+
+// Splits a header line into blank-separated words.
+std::vector<std::string> Words(const char *p, const char *end) {
+  std::vector<std::string> words;
+  while ((p = SkipBlanks(p, end, 0)) < end) {
+    const char *word = p;
+    while (p < end && !IsBlank(*p)) ++p;
+    words.emplace_back(word, p);
+  }
+  return words;
+}
+
+template <class T>
+MarketData<T> ParseMarket(const std::string &path) {
+  MappedFile file(path);
+  file.AdviseSequential();
+  const char *p = file.Data();
+  const char *end = TrimEnd(p, p + file.Size());
+  long line = 0;
+  // Returns the next line and moves p past it.
+  auto next_line = [&](const char *&line_end) {
+    const char *start = p;
+    const char *line_break =
+        static_cast<const char *>(std::memchr(p, '\n', end - p));
+    line_end = line_break != nullptr ? line_break : end;
+    p = line_break != nullptr ? line_break + 1 : end;
+    ++line;
+    if (line_end > start && line_end[-1] == '\r') --line_end;
+    return start;
+  };
+
+  MarketData<T> data;
+  const char *line_end;
+  const char *start = next_line(line_end);
+  std::vector<std::string> banner = Words(start, line_end);
+  bool pattern = false;
+  if (banner.size() != 5 || Lower(banner[0]) != "%%matrixmarket" ||
+      Lower(banner[1]) != "matrix") {
+    ThrowParse(path, line, "not a MatrixMarket matrix");
+  }
+  const std::string form = Lower(banner[2]), field = Lower(banner[3]);
+  const std::string symmetry = Lower(banner[4]);
+  if (form != "coordinate" && form != "array") {
+    ThrowParse(path, line, "unknown format " + banner[2]);
+  }
+  data.coordinate = form == "coordinate";
+  if (field == "pattern" && data.coordinate) {
+    pattern = true;
+  } else if (field != "real" && field != "double" && field != "integer") {
+    ThrowParse(path, line, "unsupported field " + banner[3]);
+  }
+  if (symmetry == "symmetric" || symmetry == "hermitian") {
+    data.symmetry = Symmetry::kSymmetric;
+  } else if (symmetry == "skew-symmetric") {
+    data.symmetry = Symmetry::kSkew;
+  } else if (symmetry != "general") {
+    ThrowParse(path, line, "unknown symmetry " + banner[4]);
+  }
+
+  // Comments, then the size line.
+  do {
+    if (p >= end) ThrowParse(path, line, "missing size line");
+    start = next_line(line_end);
+    start = SkipBlanks(start, line_end, 0);
+  } while (start == line_end || *start == '%');
+  long nonzeros = 0;
+  const char *q = ParseScalar(start, line_end, 0, data.rows);
+  if (q != nullptr) q = ParseScalar(q, line_end, 0, data.cols);
+  if (q != nullptr && data.coordinate) {
+    q = ParseScalar(q, line_end, 0, nonzeros);
+  }
+  if (q == nullptr || q != line_end || data.rows <= 0 || data.cols <= 0 ||
+      nonzeros < 0) {
+    ThrowParse(path, line, "bad size line");
+  }
+  if (data.symmetry != Symmetry::kGeneral && data.rows != data.cols) {
+    ThrowParse(path, line, "symmetric matrix is not square");
+  }
+  const long n = data.rows;
+  long expected = nonzeros;
+  if (!data.coordinate) {
+    expected = data.symmetry == Symmetry::kGeneral ? n * data.cols
+               : data.symmetry == Symmetry::kSymmetric ? n * (n + 1) / 2
+                                                       : n * (n - 1) / 2;
+  }
+
+  const LineChunks chunks = SplitLines(p, end);
+  if (chunks.lines != expected) {
+    ThrowParse(path, line, "expected " + std::to_string(expected) +
+                               " entries, found " +
+                               std::to_string(chunks.lines));
+  }
+  const long first_line = line + 1;
+  if (data.coordinate) {
+    data.entries.resize(expected);
+    ParseLines(chunks, [&](const char *s, const char *e, long index) {
+      Triplet<T> &entry = data.entries[index];
+      entry.value = T(1);
+      const char *r = ParseScalar(s, e, 0, entry.row);
+      if (r != nullptr) r = ParseScalar(r, e, 0, entry.col);
+      if (r != nullptr && !pattern) r = ParseScalar(r, e, 0, entry.value);
+      if (r == nullptr || r != e) {
+        ThrowParse(path, first_line + index, "bad entry");
+      }
+      if (entry.row < 1 || entry.row > data.rows || entry.col < 1 ||
+          entry.col > data.cols) {
+        ThrowParse(path, first_line + index, "index out of range");
+      }
+      --entry.row;
+      --entry.col;
+    });
+    if (data.symmetry != Symmetry::kGeneral) {
+      const T sign = data.symmetry == Symmetry::kSkew ? T(-1) : T(1);
+      for (long e = 0; e < expected; ++e) {
+        const Triplet<T> entry = data.entries[e];
+        if (entry.row != entry.col) {
+          data.entries.push_back({entry.col, entry.row, sign * entry.value});
+        }
+      }
+    }
+  } else {
+    data.values.resize(expected);
+    ParseLines(chunks, [&](const char *s, const char *e, long index) {
+      if (ParseScalar(s, e, 0, data.values[index]) != e) {
+        ThrowParse(path, first_line + index, "bad entry");
+      }
+    });
+  }
+  return data;
+}
+
+template <class T>
+S21BasicMatrix<T> MarketToDense(const MarketData<T> &data,
+                                std::pmr::memory_resource *resource) {
+  S21BasicMatrix<T> m(data.rows, data.cols, resource);
+  if (data.coordinate) {
+    for (const Triplet<T> &e : data.entries) m(e.row, e.col) += e.value;
+    return m;
+  }
+  // Column-major, only the lower triangle for symmetric storage.
+  std::size_t next = 0;
+  for (int j = 0; j < data.cols; ++j) {
+    const int first = data.symmetry == Symmetry::kGeneral ? 0
+                      : data.symmetry == Symmetry::kSkew  ? j + 1
+                                                          : j;
+    for (int i = first; i < data.rows; ++i) {
+      const T value = data.values[next++];
+      m(i, j) = value;
+      if (data.symmetry == Symmetry::kSymmetric) m(j, i) = value;
+      if (data.symmetry == Symmetry::kSkew) m(j, i) = -value;
+    }
+  }
+  return m;
+}
+
+}  // namespace
+
+template <class T>
+S21BasicMatrix<T> ReadCsv(const std::string &path, char delimiter,
+                          std::pmr::memory_resource *resource) {
+  MappedFile file(path);
+  file.AdviseSequential();
+  const char *begin = file.Data();
+  const char *end = TrimEnd(begin, begin + file.Size());
+  if (begin == end) ThrowParse(path, 1, "no data");
+  const char *first_break =
+      static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+  const int cols =
+      1 + static_cast<int>(std::count(
+              begin, first_break != nullptr ? first_break : end, delimiter));
+  const LineChunks chunks = SplitLines(begin, end);
+  S21BasicMatrix<T> m(static_cast<int>(chunks.lines), cols, resource);
+  T *data = m.Data();
+  const std::ptrdiff_t stride = m.Stride();
+  ParseLines(chunks, [&](const char *p, const char *line_end, long line) {
+    T *row = data + line * stride;
+    for (int j = 0; j < cols; ++j) {
+      p = ParseScalar(p, line_end, delimiter, row[j]);
+      if (p == nullptr) ThrowParse(path, line + 1, "expected a number");
+      if (j + 1 < cols) {
+        if (p == line_end || *p != delimiter) {
+          ThrowParse(path, line + 1, "too few cells");
+        }
+        ++p;
+      }
+    }
+    if (p != line_end) ThrowParse(path, line + 1, "too many cells");
+  });
+  return m;
+}
+
+template <class T>
+void WriteCsv(const std::string &path, const S21BasicMatrix<T> &m,
+              char delimiter) {
+  if (m.Data() == nullptr) throw std::runtime_error("Error: matrix is null");
+  const int rows = m.GetRows(), cols = m.GetCols();
+  const std::size_t row_room = std::size_t(cols) * (kMaxScalarChars + 1);
+  const long per_block =
+      static_cast<long>(std::max<std::size_t>(1, kWriteBlockBytes / row_room));
+  const long blocks = (rows + per_block - 1) / per_block;
+  WriteText(path, "", blocks, [&](long block, std::string &out) {
+    const long first = block * per_block;
+    const long last = std::min<long>(rows, first + per_block);
+    char *p = Reserve(out, (last - first) * row_room);
+    for (long i = first; i < last; ++i) {
+      const T *row = m.Data() + i * m.Stride();
+      for (int j = 0; j < cols; ++j) {
+        if (j > 0) *p++ = delimiter;
+        p = FormatScalar(p, row[j]);
+      }
+      *p++ = '\n';
+    }
+    Finish(out, p);
+  });
+}
+
+template <class T>
+S21BasicMatrix<T> ReadMatrixMarket(const std::string &path,
+                                   std::pmr::memory_resource *resource) {
+  return MarketToDense(ParseMarket<T>(path), resource);
+}
+
+template <class T>
+S21BasicSparseMatrix<T> ReadMatrixMarketSparse(
+    const std::string &path, SparseFormat format,
+    std::pmr::memory_resource *resource) {
+  MarketData<T> data = ParseMarket<T>(path);
+  if (data.coordinate) {
+    return S21BasicSparseMatrix<T>(data.rows, data.cols, data.entries, format,
+                                   resource);
+  }
+  return S21BasicSparseMatrix<T>(
+      MarketToDense(data, std::pmr::get_default_resource()), format,
+      resource);
+}
+
+template <class T>
+void WriteMatrixMarket(const std::string &path, const S21BasicMatrix<T> &m) {
+  if (m.Data() == nullptr) throw std::runtime_error("Error: matrix is null");
+  const int rows = m.GetRows(), cols = m.GetCols();
+  const std::string header = std::string("%%MatrixMarket matrix array ") +
+                             FieldName<T>() + " general\n" +
+                             std::to_string(rows) + " " +
+                             std::to_string(cols) + "\n";
+  const std::size_t col_room = std::size_t(rows) * (kMaxScalarChars + 1);
+  const long per_block =
+      static_cast<long>(std::max<std::size_t>(1, kWriteBlockBytes / col_room));
+  const long blocks = (cols + per_block - 1) / per_block;
+  WriteText(path, header, blocks, [&](long block, std::string &out) {
+    const long first = block * per_block;
+    const long last = std::min<long>(cols, first + per_block);
+    char *p = Reserve(out, (last - first) * col_room);
+    for (long j = first; j < last; ++j) {
+      for (int i = 0; i < rows; ++i) {
+        p = FormatScalar(p, m.Data()[i * m.Stride() + j]);
+        *p++ = '\n';
+      }
+    }
+    Finish(out, p);
+  });
+}
+
+template <class T>
+void WriteMatrixMarket(const std::string &path,
+                       const S21BasicSparseMatrix<T> &m) {
+  if (m.Offsets() == nullptr) {
+    throw std::runtime_error("Error: matrix is null");
+  }
+  const bool csr = m.Format() == SparseFormat::kCsr;
+  const int outer = csr ? m.GetRows() : m.GetCols();
+  const std::string header =
+      std::string("%%MatrixMarket matrix coordinate ") + FieldName<T>() +
+      " general\n" + std::to_string(m.GetRows()) + " " +
+      std::to_string(m.GetCols()) + " " + std::to_string(m.NonZeros()) + "\n";
+  // Two indices of up to 10 digits, two blanks and a line break.
+  const std::size_t entry_room = kMaxScalarChars + 23;
+  const std::int64_t per_block =
+      std::max<std::int64_t>(1, kWriteBlockBytes / entry_room);
+  // Blocks of whole outer indices holding about per_block entries each.
+  std::vector<int> block_starts = {0};
+  for (int o = 0; o < outer; ++o) {
+    if (m.Offsets()[o + 1] - m.Offsets()[block_starts.back()] >= per_block) {
+      block_starts.push_back(o + 1);
+    }
+  }
+  if (block_starts.back() != outer) block_starts.push_back(outer);
+  const long blocks = static_cast<long>(block_starts.size()) - 1;
+  WriteText(path, header, blocks, [&](long block, std::string &out) {
+    const int first = block_starts[block], last = block_starts[block + 1];
+    const std::int64_t entries = m.Offsets()[last] - m.Offsets()[first];
+    char *p = Reserve(out, static_cast<std::size_t>(entries) * entry_room);
+    for (int o = first; o < last; ++o) {
+      for (std::int64_t e = m.Offsets()[o]; e < m.Offsets()[o + 1]; ++e) {
+        const int inner = m.Indices()[e];
+        p = FormatScalar(p, (csr ? o : inner) + 1);
+        *p++ = ' ';
+        p = FormatScalar(p, (csr ? inner : o) + 1);
+        *p++ = ' ';
+        p = FormatScalar(p, m.Values()[e]);
+        *p++ = '\n';
+      }
+    }
+    Finish(out, p);
+  });
+}
+
+#define S21_INSTANTIATE_TEXT(T)                                                \
+  template S21BasicMatrix<T> ReadCsv<T>(const std::string &, char,             \
+                                        std::pmr::memory_resource *);          \
+  template void WriteCsv<T>(const std::string &, const S21BasicMatrix<T> &,    \
+                            char);                                             \
+  template S21BasicMatrix<T> ReadMatrixMarket<T>(const std::string &,          \
+                                                 std::pmr::memory_resource *); \
+  template S21BasicSparseMatrix<T> ReadMatrixMarketSparse<T>(                  \
+      const std::string &, SparseFormat, std::pmr::memory_resource *);         \
+  template void WriteMatrixMarket<T>(const std::string &,                      \
+                                     const S21BasicMatrix<T> &);               \
+  template void WriteMatrixMarket<T>(const std::string &,                      \
+                                     const S21BasicSparseMatrix<T> &);
+
+S21_INSTANTIATE_TEXT(float)
+S21_INSTANTIATE_TEXT(double)
+S21_INSTANTIATE_TEXT(std::int32_t)
+
+}  // namespace s21
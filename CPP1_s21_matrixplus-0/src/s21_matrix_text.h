@@ -0,0 +1,80 @@
+#ifndef SRC_S21_MATRIX_TEXT_H_
+#define SRC_S21_MATRIX_TEXT_H_
+
+#include <charconv>
+#include <complex>
+#include <memory_resource>
+#include <string>
+
+#include "s21_matrix_oop.h"
+#include "s21_sparse_matrix.h"
+
+namespace s21 {
+
+// Longest text FormatScalar produces for any element type.
+constexpr int kMaxScalarChars = 64;
+
+// Writes the shortest text that reads back to exactly value (std::to_chars
+// without a format), complex numbers as "(re,im)". first needs room for
+// kMaxScalarChars characters; returns the end of the text.
+template <class T>
+char *FormatScalar(char *first, T value) {
+  return std::to_chars(first, first + kMaxScalarChars, value).ptr;
+}
+
+inline char *FormatScalar(char *first, std::complex<double> value) {
+  *first++ = '(';
+  first = FormatScalar(first, value.real());
+  *first++ = ',';
+  first = FormatScalar(first, value.imag());
+  *first++ = ')';
+  return first;
+}
+
+// Text import and export for float, double and std::int32_t matrices.
+//
+// Readers map the file, cut it into chunks at line breaks and parse the
+// chunks on the thread pool with std::from_chars: one pass counts lines so
+// each chunk knows its first row, a second parses straight into the
+// result. Blanks around numbers, a leading '+', CRLF line ends and
+// trailing empty lines are accepted. Malformed input throws
+// std::runtime_error naming the file and line; I/O failures throw
+// std::system_error.
+//
+// Writers format blocks of rows in parallel with FormatScalar (so values
+// round-trip exactly) and write the blocks in order, a few MiB at a time.
+
+// One matrix row per line, cells separated by delimiter; every line must
+// have the same number of cells.
+template <class T>
+S21BasicMatrix<T> ReadCsv(
+    const std::string &path, char delimiter = ',',
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+template <class T>
+void WriteCsv(const std::string &path, const S21BasicMatrix<T> &m,
+              char delimiter = ',');
+
+// MatrixMarket exchange format, "matrix" objects in "array" or
+// "coordinate" form with "real", "double", "integer" or "pattern" fields
+// and "general", "symmetric" or "skew-symmetric" symmetry (complex fields
+// are not supported). Symmetric storage is expanded; coordinate entries
+// given twice are summed.
+template <class T>
+S21BasicMatrix<T> ReadMatrixMarket(
+    const std::string &path,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+template <class T>
+S21BasicSparseMatrix<T> ReadMatrixMarketSparse(
+    const std::string &path, SparseFormat format = SparseFormat::kCsr,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+// Dense matrices are written in array form, sparse ones in coordinate
+// form, both general.
+template <class T>
+void WriteMatrixMarket(const std::string &path, const S21BasicMatrix<T> &m);
+template <class T>
+void WriteMatrixMarket(const std::string &path,
+                       const S21BasicSparseMatrix<T> &m);
+
+}  // namespace s21
+
+#endif
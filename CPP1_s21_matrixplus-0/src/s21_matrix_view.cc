@@ -0,0 +1,309 @@
+#include "s21_matrix_view.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#include "s21_kernels.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+// Rows per task so that each task covers at least kParallelMinElements
+// values; smaller matrices stay single-threaded.
+long RowGrain(int cols) {
+  return std::max(1L, kParallelMinElements / std::max(1, cols));
+}
+
+template <class T>
+void CheckShapes(MatrixView<const T> a, MatrixView<const T> b) {
+  if (a.Empty() || b.Empty()) throw std::runtime_error("Error: matrix is null");
+  if (a.Rows() != b.Rows() || a.Cols() != b.Cols()) {
+    throw std::runtime_error("Error: sizes are not equal");
+  }
+}
+
+// Applies a row kernel kernel(a_row, b_row, n) when both rows are
+// contiguous and op(a_ij, b_ij) element by element otherwise.
+template <class T, class RowKernel, class Op>
+void ForEachPair(MatrixView<T> a, MatrixView<const T> b, RowKernel kernel,
+                 Op op) {
+  CheckShapes<T>(a, b);
+  const int cols = a.Cols();
+  const bool contiguous = a.ColStride() == 1 && b.ColStride() == 1;
+  ParallelFor(a.Rows(), RowGrain(cols), [&](long begin, long end) {
+    for (long i = begin; i < end; ++i) {
+      T *x = a.Data() + i * a.RowStride();
+      const T *y = b.Data() + i * b.RowStride();
+      if (contiguous) {
+        kernel(x, y, cols);
+      } else {
+        for (int j = 0; j < cols; ++j) {
+          op(x[j * a.ColStride()], y[j * b.ColStride()]);
+        }
+      }
+    }
+  });
+}
+
+// Blocks at most this many elements on a side are transposed tile by
+// tile; larger ones are halved first, so every level of the cache sees
+// blocks that fit it.
+constexpr int kTransposeLeaf = 32;
+// Rows or columns per parallel panel of a transpose.
+constexpr int kTransposePanel = 64;
+
+// Half of n rounded down to whole tiles; n > kTransposeLeaf.
+int SplitPoint(int n) { return n / 2 / kTransposeTile * kTransposeTile; }
+
+// b = a^T for a rows x cols block a and a cols x rows block b.
+template <class T>
+void TransposeBlock(const Kernels<T> &kernels, const T *a, std::ptrdiff_t lda,
+                    T *b, std::ptrdiff_t ldb, int rows, int cols) {
+  if (rows > kTransposeLeaf && rows >= cols) {
+    const int h = SplitPoint(rows);
+    TransposeBlock(kernels, a, lda, b, ldb, h, cols);
+    TransposeBlock(kernels, a + h * lda, lda, b + h, ldb, rows - h, cols);
+    return;
+  }
+  if (cols > kTransposeLeaf) {
+    const int h = SplitPoint(cols);
+    TransposeBlock(kernels, a, lda, b, ldb, rows, h);
+    TransposeBlock(kernels, a + h, lda, b + h * ldb, ldb, rows, cols - h);
+    return;
+  }
+  const int full_rows = rows / kTransposeTile * kTransposeTile;
+  const int full_cols = cols / kTransposeTile * kTransposeTile;
+  for (int i = 0; i < full_rows; i += kTransposeTile) {
+    for (int j = 0; j < full_cols; j += kTransposeTile) {
+      kernels.transpose(a + i * lda + j, lda, b + j * ldb + i, ldb);
+    }
+  }
+  for (int i = 0; i < rows; ++i) {
+    for (int j = i < full_rows ? full_cols : 0; j < cols; ++j) {
+      b[j * ldb + i] = a[i * lda + j];
+    }
+  }
+}
+
+// Exchanges the rows x cols block a with the transpose of the cols x rows
+// block b; the blocks do not overlap.
+template <class T>
+void SwapTransposed(const Kernels<T> &kernels, T *a, T *b, std::ptrdiff_t ld,
+                    int rows, int cols) {
+  if (rows > kTransposeLeaf && rows >= cols) {
+    const int h = SplitPoint(rows);
+    SwapTransposed(kernels, a, b, ld, h, cols);
+    SwapTransposed(kernels, a + h * ld, b + h, ld, rows - h, cols);
+    return;
+  }
+  if (cols > kTransposeLeaf) {
+    const int h = SplitPoint(cols);
+    SwapTransposed(kernels, a, b, ld, rows, h);
+    SwapTransposed(kernels, a + h, b + h * ld, ld, rows, cols - h);
+    return;
+  }
+  const int full_rows = rows / kTransposeTile * kTransposeTile;
+  const int full_cols = cols / kTransposeTile * kTransposeTile;
+  constexpr int kTile = kTransposeTile;
+  T a_tile[kTile * kTile], b_tile[kTile * kTile];
+  for (int i = 0; i < full_rows; i += kTile) {
+    for (int j = 0; j < full_cols; j += kTile) {
+      T *x = a + i * ld + j, *y = b + j * ld + i;
+      kernels.transpose(x, ld, b_tile, kTile);
+      kernels.transpose(y, ld, a_tile, kTile);
+      for (int k = 0; k < kTile; ++k) {
+        std::memcpy(x + k * ld, a_tile + k * kTile, sizeof(T) * kTile);
+        std::memcpy(y + k * ld, b_tile + k * kTile, sizeof(T) * kTile);
+      }
+    }
+  }
+  for (int i = 0; i < rows; ++i) {
+    for (int j = i < full_rows ? full_cols : 0; j < cols; ++j) {
+      std::swap(a[i * ld + j], b[j * ld + i]);
+    }
+  }
+}
+
+// Transposes the n x n block at a in place.
+template <class T>
+void TransposeDiagonal(const Kernels<T> &kernels, T *a, std::ptrdiff_t ld,
+                       int n) {
+  if (n > kTransposeLeaf) {
+    const int h = SplitPoint(n);
+    TransposeDiagonal(kernels, a, ld, h);
+    TransposeDiagonal(kernels, a + h * ld + h, ld, n - h);
+    SwapTransposed(kernels, a + h, a + h * ld, ld, h, n - h);
+    return;
+  }
+  const int full = n / kTransposeTile * kTransposeTile;
+  constexpr int kTile = kTransposeTile;
+  T tile[kTile * kTile];
+  for (int i = 0; i < full; i += kTile) {
+    T *x = a + i * ld + i;
+    kernels.transpose(x, ld, tile, kTile);
+    for (int k = 0; k < kTile; ++k) {
+      std::memcpy(x + k * ld, tile + k * kTile, sizeof(T) * kTile);
+    }
+    if (i + kTile < n) {
+      SwapTransposed(kernels, x + kTile, x + kTile * ld, ld, kTile,
+                     n - i - kTile);
+    }
+  }
+  for (int i = full; i < n; ++i) {
+    for (int j = i + 1; j < n; ++j) std::swap(a[i * ld + j], a[j * ld + i]);
+  }
+}
+
+}  // namespace
+
+template <class T>
+void Add(MatrixView<T> a, ConstViewOf<T> b) {
+  ForEachPair(a, b, ActiveKernels<T>().add, [](T &x, T y) { x += y; });
+}
+
+template <class T>
+void Sub(MatrixView<T> a, ConstViewOf<T> b) {
+  ForEachPair(a, b, ActiveKernels<T>().sub, [](T &x, T y) { x -= y; });
+}
+
+template <class T>
+void Scale(MatrixView<T> a, NonDeduced<T> value) {
+  if (a.Empty()) throw std::runtime_error("Error: matrix is null");
+  const Kernels<T> &kernels = ActiveKernels<T>();
+  const int cols = a.Cols();
+  ParallelFor(a.Rows(), RowGrain(cols), [&](long begin, long end) {
+    for (long i = begin; i < end; ++i) {
+      T *x = a.Data() + i * a.RowStride();
+      if (a.ColStride() == 1) {
+        kernels.scale(x, value, cols);
+      } else {
+        for (int j = 0; j < cols; ++j) x[j * a.ColStride()] *= value;
+      }
+    }
+  });
+}
+
+template <class T>
+void Copy(ConstViewOf<T> src, MatrixView<T> dst) {
+  if (src.RowStride() == 1 && src.ColStride() != 1 && dst.ColStride() == 1) {
+    Transpose<T>(src.Transposed(), dst);
+    return;
+  }
+  ForEachPair(
+      dst, src,
+      [](T *x, const T *y, int n) { std::memcpy(x, y, sizeof(T) * n); },
+      [](T &x, T y) { x = y; });
+}
+
+template <class T>
+void Transpose(ConstViewOf<T> src, MatrixView<T> dst) {
+  CheckShapes<T>(src.Transposed(), dst);
+  if (src.ColStride() != 1 || dst.ColStride() != 1) {
+    ForEachPair(
+        dst, src.Transposed(),
+        [](T *x, const T *y, int n) { std::memcpy(x, y, sizeof(T) * n); },
+        [](T &x, T y) { x = y; });
+    return;
+  }
+  const Kernels<T> &kernels = ActiveKernels<T>();
+  const int rows = src.Rows(), cols = src.Cols();
+  // Panels along the longer side, so a wide or a tall matrix both split.
+  const bool by_rows = rows >= cols;
+  const int length = by_rows ? rows : cols;
+  const long panels = (length + kTransposePanel - 1) / kTransposePanel;
+  const long grain = std::max(
+      1L, kParallelMinElements / (static_cast<long>(kTransposePanel) *
+                                  (by_rows ? cols : rows)));
+  ParallelFor(panels, grain, [&](long begin, long end) {
+    const int first = static_cast<int>(begin * kTransposePanel);
+    const int last =
+        static_cast<int>(std::min<long>(length, end * kTransposePanel));
+    if (by_rows) {
+      TransposeBlock(kernels, src.Data() + first * src.RowStride(),
+                     src.RowStride(), dst.Data() + first, dst.RowStride(),
+                     last - first, cols);
+    } else {
+      TransposeBlock(kernels, src.Data() + first, src.RowStride(),
+                     dst.Data() + first * dst.RowStride(), dst.RowStride(),
+                     rows, last - first);
+    }
+  });
+}
+
+template <class T>
+void TransposeInPlace(MatrixView<T> a) {
+  if (a.Empty()) throw std::runtime_error("Error: matrix is null");
+  if (a.Rows() != a.Cols()) {
+    throw std::runtime_error("Error: matrix is not square");
+  }
+  const int n = a.Rows();
+  if (a.ColStride() != 1 && a.RowStride() == 1) {
+    TransposeInPlace(a.Transposed());
+    return;
+  }
+  if (a.ColStride() != 1) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = i + 1; j < n; ++j) std::swap(a(i, j), a(j, i));
+    }
+    return;
+  }
+  const Kernels<T> &kernels = ActiveKernels<T>();
+  const std::ptrdiff_t ld = a.RowStride();
+  // Panel p transposes its diagonal block and swaps the strip right of it
+  // with the strip below; later panels have less to do.
+  const long panels = (n + kTransposePanel - 1) / kTransposePanel;
+  const long grain = std::max(
+      1L, kParallelMinElements / (static_cast<long>(kTransposePanel) * n));
+  ParallelFor(panels, grain, [&](long begin, long end) {
+    for (long p = begin; p < end; ++p) {
+      const int first = static_cast<int>(p * kTransposePanel);
+      const int last = std::min(n, first + kTransposePanel);
+      T *diagonal = a.Data() + first * ld + first;
+      TransposeDiagonal(kernels, diagonal, ld, last - first);
+      if (last < n) {
+        SwapTransposed(kernels, diagonal + (last - first),
+                       diagonal + (last - first) * ld, ld, last - first,
+                       n - last);
+      }
+    }
+  });
+}
+
+template <class T>
+bool Equal(ConstViewOf<T> a, ConstViewOf<T> b, RealOf<T> tolerance) noexcept {
+  if (a.Rows() != b.Rows() || a.Cols() != b.Cols()) return false;
+  for (int i = 0; i < a.Rows(); ++i) {
+    const T *x = a.Data() + i * a.RowStride();
+    const T *y = b.Data() + i * b.RowStride();
+    for (int j = 0; j < a.Cols(); ++j) {
+      T xj = x[j * a.ColStride()];
+      T yj = y[j * b.ColStride()];
+      if constexpr (std::is_integral<T>::value) {
+        if (xj != yj) return false;
+      } else if (std::abs(xj - yj) > tolerance) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+#define S21_INSTANTIATE_VIEW_OPS(T)                                      \
+  template void Add<T>(MatrixView<T>, ConstViewOf<T>);                   \
+  template void Sub<T>(MatrixView<T>, ConstViewOf<T>);                   \
+  template void Scale<T>(MatrixView<T>, NonDeduced<T>);                  \
+  template void Copy<T>(ConstViewOf<T>, MatrixView<T>);                  \
+  template void Transpose<T>(ConstViewOf<T>, MatrixView<T>);             \
+  template void TransposeInPlace<T>(MatrixView<T>);                      \
+  template bool Equal<T>(ConstViewOf<T>, ConstViewOf<T>, RealOf<T>) noexcept;
+
+S21_INSTANTIATE_VIEW_OPS(float)
+S21_INSTANTIATE_VIEW_OPS(double)
+S21_INSTANTIATE_VIEW_OPS(std::int32_t)
+S21_INSTANTIATE_VIEW_OPS(std::complex<double>)
+
+}  // namespace s21
@@ -0,0 +1,112 @@
+#ifndef SRC_S21_MATRIX_VIEW_H_
+#define SRC_S21_MATRIX_VIEW_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_scalar_traits.h"
+
+namespace s21 {
+
+// Non-owning window onto matrix storage: element (i, j) lives at
+// data[i * row_stride + j * col_stride]. Blocks, rows, columns and the
+// transpose are all views of the same buffer, so slicing never copies.
+// T is the element type for a writable view and const T for a read-only
+// one.
+template <class T>
+class MatrixView {
+ public:
+  MatrixView() noexcept = default;
+  MatrixView(T *data, int rows, int cols, std::ptrdiff_t row_stride,
+             std::ptrdiff_t col_stride = 1) noexcept
+      : data_(data),
+        rows_(rows),
+        cols_(cols),
+        row_stride_(row_stride),
+        col_stride_(col_stride) {}
+  // A writable view converts to a read-only one.
+  template <class U,
+            class = std::enable_if_t<std::is_convertible<U *, T *>::value>>
+  MatrixView(const MatrixView<U> &other) noexcept
+      : MatrixView(other.Data(), other.Rows(), other.Cols(),
+                   other.RowStride(), other.ColStride()) {}
+
+  T *Data() const noexcept { return data_; }
+  int Rows() const noexcept { return rows_; }
+  int Cols() const noexcept { return cols_; }
+  std::ptrdiff_t RowStride() const noexcept { return row_stride_; }
+  std::ptrdiff_t ColStride() const noexcept { return col_stride_; }
+  bool Empty() const noexcept {
+    return data_ == nullptr || rows_ <= 0 || cols_ <= 0;
+  }
+
+  T &operator()(int i, int j) const {
+    if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+      throw std::out_of_range("Incorrect input, index is out of range");
+    }
+    return data_[i * row_stride_ + j * col_stride_];
+  }
+
+  // rows x cols block whose top-left corner is (row, col).
+  MatrixView Block(int row, int col, int rows, int cols) const {
+    if (row < 0 || col < 0 || rows < 0 || cols < 0 || row + rows > rows_ ||
+        col + cols > cols_) {
+      throw std::out_of_range("Block is out of range");
+    }
+    return MatrixView(data_ + row * row_stride_ + col * col_stride_, rows,
+                      cols, row_stride_, col_stride_);
+  }
+  MatrixView Row(int i) const { return Block(i, 0, 1, cols_); }
+  MatrixView Col(int j) const { return Block(0, j, rows_, 1); }
+  MatrixView Transposed() const noexcept {
+    return MatrixView(data_, cols_, rows_, col_stride_, row_stride_);
+  }
+
+ private:
+  T *data_ = nullptr;
+  int rows_ = 0;
+  int cols_ = 0;
+  std::ptrdiff_t row_stride_ = 0;
+  std::ptrdiff_t col_stride_ = 1;
+};
+
+using ConstView = MatrixView<const double>;
+using MutableView = MatrixView<double>;
+
+// Read-only view of T that does not take part in template argument
+// deduction, so writable views convert to it implicitly.
+template <class T>
+using ConstViewOf = NonDeduced<MatrixView<const T>>;
+
+// Element-wise kernels on views, defined for every ScalarTraits type.
+// Contiguous rows go through the active kernels, other strides through
+// plain loops; both are split over the thread pool by rows. The operands
+// must have the same shape (else std::runtime_error) and must not
+// partially overlap.
+template <class T>
+void Add(MatrixView<T> a, ConstViewOf<T> b);
+template <class T>
+void Sub(MatrixView<T> a, ConstViewOf<T> b);
+template <class T>
+void Scale(MatrixView<T> a, NonDeduced<T> value);
+// dst = src. Copying from src.Transposed() transposes (see Transpose).
+template <class T>
+void Copy(ConstViewOf<T> src, MatrixView<T> dst);
+// dst = src transposed. With contiguous rows on both sides the work is
+// split recursively along the longer side until a block fits in L1 and
+// moved in kTransposeTile squares by the active transpose kernel; panels
+// of the split run on the thread pool. Other strides use a plain loop.
+template <class T>
+void Transpose(ConstViewOf<T> src, MatrixView<T> dst);
+// Transposes a square view with contiguous rows in place, swapping
+// mirrored blocks the same way (std::runtime_error if not square).
+template <class T>
+void TransposeInPlace(MatrixView<T> a);
+// True if the shapes match and every pair differs by at most tolerance.
+template <class T>
+bool Equal(ConstViewOf<T> a, ConstViewOf<T> b, RealOf<T> tolerance) noexcept;
+
+}  // namespace s21
+
+#endif
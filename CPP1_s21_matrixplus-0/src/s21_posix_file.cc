@@ -0,0 +1,76 @@
+#include "s21_posix_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+namespace s21 {
+
+void ThrowErrno(const std::string &what, const std::string &path) {
+  throw std::system_error(errno, std::generic_category(), what + " " + path);
+}
+
+FileDescriptor::~FileDescriptor() {
+  if (fd_ >= 0) ::close(fd_);
+}
+
+int FileDescriptor::Close() noexcept {
+  int result = ::close(fd_);
+  fd_ = -1;
+  return result;
+}
+
+void WriteAll(int fd, const void *data, std::size_t bytes,
+              std::int64_t offset, const std::string &path) {
+  const char *p = static_cast<const char *>(data);
+  while (bytes > 0) {
+    ssize_t written = ::pwrite(fd, p, bytes, static_cast<off_t>(offset));
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      ThrowErrno("write", path);
+    }
+    p += written;
+    bytes -= static_cast<std::size_t>(written);
+    offset += written;
+  }
+}
+
+MappedFile::MappedFile(const std::string &path) {
+  FileDescriptor file(::open(path.c_str(), O_RDONLY));
+  if (file.Get() < 0) ThrowErrno("open", path);
+  struct stat info;
+  if (::fstat(file.Get(), &info) != 0) ThrowErrno("stat", path);
+  if (info.st_size == 0) return;
+  void *map = ::mmap(nullptr, static_cast<std::size_t>(info.st_size),
+                     PROT_READ, MAP_PRIVATE, file.Get(), 0);
+  if (map == MAP_FAILED) ThrowErrno("mmap", path);
+  map_ = map;
+  size_ = static_cast<std::size_t>(info.st_size);
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : map_(std::exchange(other.map_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    std::swap(map_, other.map_);
+    std::swap(size_, other.size_);
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  if (map_ != nullptr) ::munmap(map_, size_);
+}
+
+void MappedFile::AdviseSequential() const noexcept {
+  if (map_ != nullptr) ::madvise(map_, size_, MADV_SEQUENTIAL);
+}
+
+}  // namespace s21
@@ -0,0 +1,59 @@
+#ifndef SRC_S21_POSIX_FILE_H_
+#define SRC_S21_POSIX_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace s21 {
+
+// Throws std::system_error for the current errno, naming the failed call
+// and the file.
+[[noreturn]] void ThrowErrno(const std::string &what, const std::string &path);
+
+// Owns a file descriptor and closes it on every path out of the scope.
+class FileDescriptor {
+ public:
+  explicit FileDescriptor(int fd) noexcept : fd_(fd) {}
+  FileDescriptor(const FileDescriptor &) = delete;
+  FileDescriptor &operator=(const FileDescriptor &) = delete;
+  ~FileDescriptor();
+
+  int Get() const noexcept { return fd_; }
+  // Closes now so that a failed close (a late write error) is reported.
+  int Close() noexcept;
+
+ private:
+  int fd_;
+};
+
+// pwrite of all bytes at offset, resumed after short writes and EINTR.
+void WriteAll(int fd, const void *data, std::size_t bytes,
+              std::int64_t offset, const std::string &path);
+
+// Read-only private mapping of a whole file; pages are read on first
+// touch. An empty file maps to Data() == nullptr.
+class MappedFile {
+ public:
+  MappedFile() noexcept = default;
+  // Throws std::system_error if the file cannot be opened or mapped.
+  explicit MappedFile(const std::string &path);
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+  ~MappedFile();
+
+  const char *Data() const noexcept { return static_cast<char *>(map_); }
+  std::size_t Size() const noexcept { return size_; }
+  // Hints the kernel to read ahead aggressively and drop pages behind.
+  void AdviseSequential() const noexcept;
+
+ private:
+  void *map_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace s21
+
+#endif
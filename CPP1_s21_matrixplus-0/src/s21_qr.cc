@@ -0,0 +1,305 @@
+#include "s21_qr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "s21_gemm.h"
+#include "s21_scratch_buffer.h"
+
+namespace s21 {
+
+namespace {
+
+// Width below which a panel is factored column by column.
+constexpr int kQrLeaf = 8;
+
+// sums[0] = sum x(i)^2 and sums[1 + c] = sum x(i) * a(i, j + 1 + c) over
+// the rows i > j, where x is column j: what the reflector of column j
+// needs from the rows below its pivot. x is row[j] unless given.
+template <class T>
+void AccumulateRow(const T *row, int j, int k1, T *sums, T x) {
+  sums[0] += x * x;
+  for (int c = j + 1; c < k1; ++c) sums[c - j] += x * row[c];
+}
+
+template <class T>
+void AccumulateRow(const T *row, int j, int k1, T *sums) {
+  AccumulateRow(row, j, k1, sums, row[j]);
+}
+
+// Whether sums came through unharmed: a sum of squares below this may
+// have lost its bits to underflow.
+template <class T>
+bool SumsAreSafe(const T *sums, int n) {
+  constexpr T kSafeMin =
+      std::numeric_limits<T>::min() / std::numeric_limits<T>::epsilon();
+  if (!(sums[0] >= kSafeMin)) return false;
+  for (int c = 0; c < n; ++c) {
+    if (!std::isfinite(sums[c])) return false;
+  }
+  return true;
+}
+
+// Recomputes the sums of column j with x divided by its largest |x|, as
+// LAPACK's nrm2 and larfg rescale, and returns that divisor (1 for a zero
+// column): the true sums are the new ones times it, sums[0] times its
+// square.
+template <class T>
+T RescaleSums(int m, int j, int k1, const T *a, std::ptrdiff_t lda,
+              T *sums) {
+  T largest = T(0);
+  for (int i = j + 1; i < m; ++i) {
+    largest = std::max(largest, std::abs(a[i * lda + j]));
+  }
+  std::fill(sums, sums + (k1 - j), T(0));
+  if (largest == T(0)) return T(1);
+  for (int i = j + 1; i < m; ++i) {
+    const T *row = a + i * lda;
+    AccumulateRow(row, j, k1, sums, row[j] / largest);
+  }
+  return largest;
+}
+
+// Unblocked QR of the columns [k0, k1) (LAPACK's geqr2 with larfg
+// reflectors). A tall panel does not fit in cache, so each column
+// makes a single pass over the rows: it applies its reflector to a row
+// and, while the row is at hand, accumulates the sums the next column's
+// reflector needs. The sums and the update live on the stack, so the
+// compiler can vectorize the row loops without alias checks. A column
+// whose squares overflow or underflow has its sums recomputed scaled.
+template <class T>
+void FactorPanel(int m, int k0, int k1, T *a, std::ptrdiff_t lda, T *tau) {
+  T sums[kQrBlock];
+  T d[kQrBlock];
+  std::fill(sums, sums + (k1 - k0), T(0));
+  for (int i = k0 + 1; i < m; ++i) AccumulateRow(a + i * lda, k0, k1, sums);
+  for (int j = k0; j < k1; ++j) {
+    T *row_j = a + j * lda;
+    const int nc = k1 - j - 1;
+    const T alpha = row_j[j];
+    const T unit = SumsAreSafe(sums, nc + 1)
+                       ? T(1)
+                       : RescaleSums(m, j, k1, a, lda, sums);
+    T tj = T(0);
+    T scale = T(0);
+    if (sums[0] != T(0)) {
+      // H = I - tau v v^T maps x to beta e1, with v = x / (alpha - beta)
+      // below the leading 1.
+      T beta = std::hypot(alpha, unit * std::sqrt(sums[0]));
+      if (alpha > T(0)) beta = -beta;
+      scale = T(1) / (alpha - beta);
+      tj = (beta - alpha) / beta;
+      row_j[j] = beta;
+    }
+    tau[j - k0] = tj;
+    // The panel columns right of j change by -v * d^T, d = tau * C^T v.
+    const T cross = scale * unit;
+    for (int c = 0; c < nc; ++c) {
+      d[c] = tj * (row_j[j + 1 + c] + cross * sums[1 + c]);
+      row_j[j + 1 + c] -= d[c];
+    }
+    std::fill(sums, sums + nc, T(0));
+    for (int i = j + 1; i < m; ++i) {
+      T *row = a + i * lda;
+      const T v = row[j] *= scale;
+      for (int c = 0; c < nc; ++c) row[j + 1 + c] -= v * d[c];
+      if (i > j + 1 && nc > 0) AccumulateRow(row, j + 1, k1, sums);
+    }
+  }
+}
+
+// T of the panel's reflectors (LAPACK's larft): T(j, j) = tau(j) and
+// T(0:j, j) = -tau(j) * T(0:j, 0:j) * V(:, 0:j)^T * v(j). The inner
+// products V^T * V come from one Gemm over the rows below the panel plus
+// the unit lower triangle on top of it.
+template <class T>
+void FormT(int m, int k0, int kb, const T *a, std::ptrdiff_t lda,
+           const T *tau, T *t, std::ptrdiff_t ldt) {
+  const int k1 = k0 + kb;
+  thread_local ScratchBuffer<T> gram_buffer;
+  T *gram = gram_buffer.Get(std::size_t(kb) * kb);
+  std::fill(gram, gram + kb * kb, T(0));
+  if (k1 < m) {
+    const T *v2 = a + k1 * lda + k0;
+    Gemm(kb, kb, m - k1, 1.0, v2, 1, lda, v2, lda, 1, 0.0, gram, kb);
+  }
+  for (int r = 0; r < kb; ++r) {
+    const T *row = a + (k0 + r) * lda + k0;
+    for (int i = 0; i < r; ++i) {
+      for (int j = i; j < r; ++j) gram[i * kb + j] += row[i] * row[j];
+      gram[i * kb + r] += row[i];
+    }
+    gram[r * kb + r] += T(1);
+  }
+  for (int j = 0; j < kb; ++j) {
+    for (int i = 0; i < kb; ++i) t[i * ldt + j] = T(0);
+    for (int i = 0; i < j; ++i) {
+      T sum = T(0);
+      for (int p = i; p < j; ++p) sum += t[i * ldt + p] * gram[p * kb + j];
+      t[i * ldt + j] = -tau[j] * sum;
+    }
+    t[j * ldt + j] = tau[j];
+  }
+}
+
+// C = (I - V * T * V^T) * C, or with T^T when transpose is set, for the
+// panel at k0 and the (m - k0) x nc block C (LAPACK's larfb). V is
+// [V1; V2], V1 the unit lower kb x kb triangle and V2 the rows below it,
+// which are read in place, so W = V^T * C and C -= V * W are each a small
+// triangular product plus a Gemm.
+template <class T>
+void ApplyBlock(int m, int k0, int kb, int nc, bool transpose, const T *a,
+                std::ptrdiff_t lda, const T *t, std::ptrdiff_t ldt, T *c,
+                std::ptrdiff_t ldc) {
+  if (nc == 0) return;
+  const int k1 = k0 + kb;
+  const T *v2 = a + k1 * lda + k0;
+  T *c2 = c + kb * ldc;
+  thread_local ScratchBuffer<T> w_buffer;
+  T *w = w_buffer.Get(std::size_t(kb) * nc);
+  for (int i = 0; i < kb; ++i) {
+    T *w_i = w + i * nc;
+    std::copy(c + i * ldc, c + i * ldc + nc, w_i);
+    for (int r = i + 1; r < kb; ++r) {
+      const T v = a[(k0 + r) * lda + k0 + i];
+      const T *c_r = c + r * ldc;
+      for (int q = 0; q < nc; ++q) w_i[q] += v * c_r[q];
+    }
+  }
+  if (k1 < m) Gemm(kb, nc, m - k1, 1.0, v2, 1, lda, c2, ldc, 1, 1.0, w, nc);
+  if (transpose) {
+    // W = T^T * W, bottom row first since row i reads rows 0..i.
+    for (int i = kb - 1; i >= 0; --i) {
+      T *w_i = w + i * nc;
+      const T d = t[i * ldt + i];
+      for (int q = 0; q < nc; ++q) w_i[q] *= d;
+      for (int p = 0; p < i; ++p) {
+        const T f = t[p * ldt + i];
+        const T *w_p = w + p * nc;
+        for (int q = 0; q < nc; ++q) w_i[q] += f * w_p[q];
+      }
+    }
+  } else {
+    // W = T * W, top row first since row i reads rows i..kb-1.
+    for (int i = 0; i < kb; ++i) {
+      T *w_i = w + i * nc;
+      const T d = t[i * ldt + i];
+      for (int q = 0; q < nc; ++q) w_i[q] *= d;
+      for (int p = i + 1; p < kb; ++p) {
+        const T f = t[i * ldt + p];
+        const T *w_p = w + p * nc;
+        for (int q = 0; q < nc; ++q) w_i[q] += f * w_p[q];
+      }
+    }
+  }
+  if (k1 < m) Gemm(m - k1, nc, kb, -1.0, v2, lda, w, nc, 1.0, c2, ldc);
+  for (int r = 0; r < kb; ++r) {
+    T *c_r = c + r * ldc;
+    const T *w_r = w + r * nc;
+    for (int q = 0; q < nc; ++q) c_r[q] -= w_r[q];
+    for (int i = 0; i < r; ++i) {
+      const T v = a[(k0 + r) * lda + k0 + i];
+      const T *w_i = w + i * nc;
+      for (int q = 0; q < nc; ++q) c_r[q] -= v * w_i[q];
+    }
+  }
+}
+
+// QR of the columns [k0, k1) split in halves (Elmroth and Gustavson,
+// "Applying recursion to serial and parallel QR factorization", 2000):
+// the left half is factored, applied to the right half in WY form and the
+// right half factored in turn. Only kQrLeaf-wide leaves are factored
+// column by column, so most of the panel's flops run in Gemm as well.
+template <class T>
+void FactorRecursive(int m, int k0, int k1, T *a, std::ptrdiff_t lda,
+                     T *tau) {
+  if (k1 - k0 <= kQrLeaf) {
+    FactorPanel(m, k0, k1, a, lda, tau);
+    return;
+  }
+  const int km = k0 + (k1 - k0) / 2;
+  FactorRecursive(m, k0, km, a, lda, tau);
+  // t is dead before the right half recurses, so one buffer serves every
+  // level.
+  thread_local ScratchBuffer<T> t_buffer;
+  T *t = t_buffer.Get(kQrBlock * kQrBlock);
+  FormT(m, k0, km - k0, a, lda, tau, t, kQrBlock);
+  ApplyBlock(m, k0, km - k0, k1 - km, true, a, lda, t, kQrBlock,
+             a + k0 * lda + km, lda);
+  FactorRecursive(m, km, k1, a, lda, tau + (km - k0));
+}
+
+}  // namespace
+
+template <class T>
+void QrFactor(int m, int n, T *a, std::ptrdiff_t lda, T *t,
+              std::ptrdiff_t ldt) {
+  thread_local ScratchBuffer<T> panel_buffer;
+  T *tau = panel_buffer.Get(kQrBlock);
+  for (int k0 = 0; k0 < n; k0 += kQrBlock) {
+    const int kb = std::min(kQrBlock, n - k0);
+    const int k1 = k0 + kb;
+    FactorRecursive(m, k0, k1, a, lda, tau);
+    FormT(m, k0, kb, a, lda, tau, t + k0, ldt);
+    ApplyBlock(m, k0, kb, n - k1, true, a, lda, t + k0, ldt,
+               a + k0 * lda + k1, lda);
+  }
+}
+
+template <class T>
+void QrApplyQt(int m, int n, int nrhs, const T *qr, std::ptrdiff_t lda,
+               const T *t, std::ptrdiff_t ldt, T *b, std::ptrdiff_t ldb) {
+  for (int k0 = 0; k0 < n; k0 += kQrBlock) {
+    const int kb = std::min(kQrBlock, n - k0);
+    ApplyBlock(m, k0, kb, nrhs, true, qr, lda, t + k0, ldt, b + k0 * ldb,
+               ldb);
+  }
+}
+
+template <class T>
+void QrApplyQ(int m, int n, int nrhs, const T *qr, std::ptrdiff_t lda,
+              const T *t, std::ptrdiff_t ldt, T *b, std::ptrdiff_t ldb) {
+  for (int k0 = (n - 1) / kQrBlock * kQrBlock; k0 >= 0; k0 -= kQrBlock) {
+    const int kb = std::min(kQrBlock, n - k0);
+    ApplyBlock(m, k0, kb, nrhs, false, qr, lda, t + k0, ldt, b + k0 * ldb,
+               ldb);
+  }
+}
+
+template <class T>
+void QrSolveR(int n, int nrhs, const T *qr, std::ptrdiff_t lda, T *b,
+              std::ptrdiff_t ldb) {
+  for (int i0 = (n - 1) / kQrBlock * kQrBlock; i0 >= 0; i0 -= kQrBlock) {
+    const int i1 = std::min(n, i0 + kQrBlock);
+    if (i1 < n) {
+      Gemm(i1 - i0, nrhs, n - i1, -1.0, qr + i0 * lda + i1, lda,
+           b + i1 * ldb, ldb, 1.0, b + i0 * ldb, ldb);
+    }
+    for (int i = i1 - 1; i >= i0; --i) {
+      T *row_i = b + i * ldb;
+      for (int p = i + 1; p < i1; ++p) {
+        const T u = qr[i * lda + p];
+        const T *row_p = b + p * ldb;
+        for (int j = 0; j < nrhs; ++j) row_i[j] -= u * row_p[j];
+      }
+      const T inv = T(1) / qr[i * lda + i];
+      for (int j = 0; j < nrhs; ++j) row_i[j] *= inv;
+    }
+  }
+}
+
+#define S21_INSTANTIATE_QR(T)                                                 \
+  template void QrFactor<T>(int, int, T *, std::ptrdiff_t, T *,               \
+                            std::ptrdiff_t);                                  \
+  template void QrApplyQt<T>(int, int, int, const T *, std::ptrdiff_t,        \
+                             const T *, std::ptrdiff_t, T *, std::ptrdiff_t); \
+  template void QrApplyQ<T>(int, int, int, const T *, std::ptrdiff_t,         \
+                            const T *, std::ptrdiff_t, T *, std::ptrdiff_t);  \
+  template void QrSolveR<T>(int, int, const T *, std::ptrdiff_t, T *,         \
+                            std::ptrdiff_t);
+
+S21_INSTANTIATE_QR(float)
+S21_INSTANTIATE_QR(double)
+
+}  // namespace s21
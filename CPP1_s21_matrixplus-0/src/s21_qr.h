@@ -0,0 +1,52 @@
+#ifndef SRC_S21_QR_H_
+#define SRC_S21_QR_H_
+
+#include <cstddef>
+
+#include "s21_scalar_traits.h"
+
+namespace s21 {
+
+// Panel width of the blocked factorization. Each panel of reflectors is
+// applied to the rest of the matrix in compact WY form, as two Gemm calls
+// and a kQrBlock x kQrBlock triangular product.
+constexpr int kQrBlock = 64;
+
+// The routines below are defined for float and double.
+//
+// Factors the m x n row-major matrix a (leading dimension lda, m >= n) in
+// place as A = Q * R with Householder reflectors H(j) = I - tau v v^T,
+// Q = H(0) * ... * H(n - 1). R overwrites the upper triangle; v(j), whose
+// leading 1 is implied, overwrites column j below the diagonal.
+//
+// The reflectors of the panel starting at column k0 combine into
+// I - V * T * V^T with T upper triangular (Schreiber and Van Loan, "A
+// storage-efficient WY representation for products of Householder
+// transformations", 1989). T is stored in t, which has kQrBlock rows and
+// n columns (leading dimension ldt): T(i, j) of that panel is
+// t[i * ldt + k0 + j]. The trailing columns are updated with Gemm, and
+// the panels themselves are split recursively down to 8-column leaves
+// with the same WY updates, so only those leaves are factored column by
+// column.
+template <class T>
+void QrFactor(int m, int n, T *a, std::ptrdiff_t lda, T *t,
+              std::ptrdiff_t ldt);
+
+// Overwrite the m x nrhs row-major matrix b with Q^T * b and Q * b, given
+// the factors produced by QrFactor.
+template <class T>
+void QrApplyQt(int m, int n, int nrhs, const T *qr, std::ptrdiff_t lda,
+               const T *t, std::ptrdiff_t ldt, T *b, std::ptrdiff_t ldb);
+template <class T>
+void QrApplyQ(int m, int n, int nrhs, const T *qr, std::ptrdiff_t lda,
+              const T *t, std::ptrdiff_t ldt, T *b, std::ptrdiff_t ldb);
+
+// Overwrites the first n rows of the n x nrhs row-major matrix b with
+// R^-1 * b, in kQrBlock row blocks whose updates go through Gemm.
+template <class T>
+void QrSolveR(int n, int nrhs, const T *qr, std::ptrdiff_t lda, T *b,
+              std::ptrdiff_t ldb);
+
+}  // namespace s21
+
+#endif
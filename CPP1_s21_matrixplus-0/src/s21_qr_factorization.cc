@@ -0,0 +1,103 @@
+#include "s21_qr_factorization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_qr.h"
+
+template <class T>
+S21BasicQrFactorization<T>::S21BasicQrFactorization(
+    const S21BasicMatrix<T> &a)
+    : S21BasicQrFactorization(a, a.GetResource()) {}
+
+template <class T>
+S21BasicQrFactorization<T>::S21BasicQrFactorization(
+    const S21BasicMatrix<T> &a, std::pmr::memory_resource *resource)
+    : qr_(a, resource), t_(resource) {
+  if (a.Data() == nullptr) throw std::runtime_error("Error: matrix is null");
+  if (a.GetRows() < a.GetCols()) {
+    throw std::invalid_argument("Error: matrix has more columns than rows");
+  }
+  t_ = S21BasicMatrix<T>(s21::kQrBlock, GetCols(), resource);
+  s21::QrFactor(GetRows(), GetCols(), qr_.Data(), qr_.Stride(), t_.Data(),
+                t_.Stride());
+}
+
+template <class T>
+int S21BasicQrFactorization<T>::GetRows() const noexcept {
+  return qr_.GetRows();
+}
+
+template <class T>
+int S21BasicQrFactorization<T>::GetCols() const noexcept {
+  return qr_.GetCols();
+}
+
+template <class T>
+bool S21BasicQrFactorization<T>::IsRankDeficient() const noexcept {
+  T largest = T(0);
+  T smallest = std::numeric_limits<T>::infinity();
+  for (int i = 0; i < GetCols(); i++) {
+    largest = std::max(largest, std::abs(qr_(i, i)));
+    smallest = std::min(smallest, std::abs(qr_(i, i)));
+  }
+  return smallest <= GetRows() * std::numeric_limits<T>::epsilon() * largest;
+}
+
+template <class T>
+void S21BasicQrFactorization<T>::CheckSolvable(int rows) const {
+  if (rows != GetRows()) throw std::runtime_error("Error: sizes are not equal");
+  if (IsRankDeficient()) {
+    throw std::logic_error("Error: matrix is rank deficient");
+  }
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicQrFactorization<T>::Solve(
+    const S21BasicMatrix<T> &b) const {
+  if (b.Data() == nullptr) throw std::runtime_error("Error: matrix is null");
+  CheckSolvable(b.GetRows());
+  S21BasicMatrix<T> y(b, b.GetResource());
+  s21::QrApplyQt(GetRows(), GetCols(), y.GetCols(), qr_.Data(), qr_.Stride(),
+                 t_.Data(), t_.Stride(), y.Data(), y.Stride());
+  s21::QrSolveR(GetCols(), y.GetCols(), qr_.Data(), qr_.Stride(), y.Data(),
+                y.Stride());
+  return S21BasicMatrix<T>(y.View().Block(0, 0, GetCols(), y.GetCols()),
+                           b.GetResource());
+}
+
+template <class T>
+std::vector<T> S21BasicQrFactorization<T>::Solve(
+    const std::vector<T> &b) const {
+  CheckSolvable(static_cast<int>(b.size()));
+  std::vector<T> x(b);
+  s21::QrApplyQt(GetRows(), GetCols(), 1, qr_.Data(), qr_.Stride(),
+                 t_.Data(), t_.Stride(), x.data(), 1);
+  s21::QrSolveR(GetCols(), 1, qr_.Data(), qr_.Stride(), x.data(), 1);
+  x.resize(GetCols());
+  return x;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicQrFactorization<T>::ThinQ() const {
+  S21BasicMatrix<T> q(GetRows(), GetCols(), qr_.GetResource());
+  for (int i = 0; i < GetCols(); i++) q(i, i) = T(1);
+  s21::QrApplyQ(GetRows(), GetCols(), GetCols(), qr_.Data(), qr_.Stride(),
+                t_.Data(), t_.Stride(), q.Data(), q.Stride());
+  return q;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicQrFactorization<T>::R() const {
+  S21BasicMatrix<T> r(GetCols(), GetCols(), qr_.GetResource());
+  for (int i = 0; i < GetCols(); i++) {
+    const T *row = qr_.Data() + i * qr_.Stride();
+    std::copy(row + i, row + GetCols(), r.Data() + i * r.Stride() + i);
+  }
+  return r;
+}
+
+template class S21BasicQrFactorization<float>;
+template class S21BasicQrFactorization<double>;
@@ -0,0 +1,61 @@
+#ifndef SRC_S21_QR_FACTORIZATION_H_
+#define SRC_S21_QR_FACTORIZATION_H_
+
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Householder QR factorization A = Q * R of an m x n matrix with m >= n,
+// for least-squares problems min ||A * x - b||. The blocked
+// factorization (see s21_qr.h) costs 2 m n^2 - 2 n^3 / 3 flops, mostly in
+// Gemm, and never forms A^T * A, whose condition number is the square of
+// A's. Instantiated for float and double.
+//
+// Q is kept as its reflectors and is only formed on request; Solve
+// applies Q^T to the right-hand sides directly. Construction behaves as in
+// S21BasicLuFactorization (s21_lu_factorization.h), except that A must
+// have at least as many rows as columns rather than be square
+// (std::invalid_argument otherwise).
+template <class T>
+class S21BasicQrFactorization {
+ public:
+  using Scalar = T;
+
+  explicit S21BasicQrFactorization(const S21BasicMatrix<T> &a);
+  S21BasicQrFactorization(const S21BasicMatrix<T> &a,
+                          std::pmr::memory_resource *resource);
+
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  // True if a diagonal entry of R is zero relative to the largest one
+  // (|R(k, k)| <= m * eps * max |R(i, i)|). Without column pivoting this
+  // detects exact and near rank deficiency only in the usual cases.
+  bool IsRankDeficient() const noexcept;
+
+  // The n x k least-squares solution X minimizing ||A * X - B|| column by
+  // column, for the m x k matrix B (std::runtime_error if the rows
+  // differ), in B's resource. Throws std::logic_error if A is rank
+  // deficient.
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &b) const;
+  // x minimizing ||A * x - b|| for a vector of m elements.
+  std::vector<T> Solve(const std::vector<T> &b) const;
+
+  // The m x n matrix of the first n columns of Q (orthonormal columns)
+  // and the n x n upper triangular R, with A = ThinQ() * R().
+  S21BasicMatrix<T> ThinQ() const;
+  S21BasicMatrix<T> R() const;
+
+ private:
+  S21BasicMatrix<T> qr_;
+  S21BasicMatrix<T> t_;
+  void CheckSolvable(int rows) const;
+};
+
+using S21QrFactorization = S21BasicQrFactorization<double>;
+using S21FloatQrFactorization = S21BasicQrFactorization<float>;
+
+extern template class S21BasicQrFactorization<float>;
+extern template class S21BasicQrFactorization<double>;
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef SRC_S21_SCALAR_TRAITS_H_
+#define SRC_S21_SCALAR_TRAITS_H_
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <type_traits>
+
+namespace s21 {
+
+// Element types S21BasicMatrix is instantiated for: float, double,
+// std::int32_t and std::complex<double>. Real is the type of magnitudes
+// and kTolerance the largest difference EqMatrix treats as equal.
+template <class T>
+struct ScalarTraits;
+
+template <>
+struct ScalarTraits<double> {
+  using Real = double;
+  static constexpr double kTolerance = 1e-07;
+};
+
+template <>
+struct ScalarTraits<float> {
+  using Real = float;
+  static constexpr float kTolerance = 1e-04f;
+};
+
+// Integers compare exactly.
+template <>
+struct ScalarTraits<std::int32_t> {
+  using Real = std::int32_t;
+  static constexpr std::int32_t kTolerance = 0;
+};
+
+template <class R>
+struct ScalarTraits<std::complex<R>> {
+  using Real = R;
+  static constexpr R kTolerance = ScalarTraits<R>::kTolerance;
+};
+
+template <class T>
+using RealOf = typename ScalarTraits<T>::Real;
+
+template <class T>
+struct IsComplex : std::false_type {};
+
+template <class R>
+struct IsComplex<std::complex<R>> : std::true_type {};
+
+// Keeps a parameter out of template argument deduction, so that e.g. a
+// double literal can be passed where a float is expected.
+template <class T>
+struct TypeIdentity {
+  using type = T;
+};
+
+template <class T>
+using NonDeduced = typename TypeIdentity<T>::type;
+
+// Magnitude used to choose pivots: |re| + |im| for complex values, as in
+// LAPACK, which orders pivots like the modulus without a square root.
+template <class T>
+RealOf<T> PivotMagnitude(T x) noexcept {
+  return std::abs(x);
+}
+
+template <class R>
+R PivotMagnitude(std::complex<R> x) noexcept {
+  return std::abs(x.real()) + std::abs(x.imag());
+}
+
+}  // namespace s21
+
+#endif
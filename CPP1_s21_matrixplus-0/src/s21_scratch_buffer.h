@@ -0,0 +1,47 @@
+#ifndef SRC_S21_SCRATCH_BUFFER_H_
+#define SRC_S21_SCRATCH_BUFFER_H_
+
+#include <cstddef>
+#include <new>
+
+namespace s21 {
+
+// Per-thread scratch for kernels, grown on demand and kept between calls
+// so steady-state operations do not allocate. Storage is 64-byte aligned
+// and its contents are not preserved when it grows.
+template <class T>
+class ScratchBuffer {
+ public:
+  static constexpr std::size_t kAlignment = 64;
+
+  ScratchBuffer() = default;
+  ScratchBuffer(const ScratchBuffer &) = delete;
+  ScratchBuffer &operator=(const ScratchBuffer &) = delete;
+  ~ScratchBuffer() { Release(); }
+
+  T *Get(std::size_t size) {
+    if (size > size_) {
+      Release();
+      data_ = static_cast<T *>(
+          ::operator new[](sizeof(T) * size, std::align_val_t(kAlignment)));
+      size_ = size;
+    }
+    return data_;
+  }
+
+ private:
+  void Release() noexcept {
+    if (data_ != nullptr) {
+      ::operator delete[](data_, std::align_val_t(kAlignment));
+      data_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+  T *data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,556 @@
+#include "s21_sparse_matrix.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+using s21::SparseFormat;
+
+// Output columns per task when a CSC product splits the dense result by
+// columns.
+constexpr int kColumnBlock = 64;
+
+// Outer indices per task so that a task does about kParallelMinElements
+// of the given work.
+long Grain(std::int64_t work, int outer) {
+  std::int64_t grain = s21::kParallelMinElements * std::int64_t(outer) /
+                       std::max<std::int64_t>(1, work);
+  return static_cast<long>(std::max<std::int64_t>(1, grain));
+}
+
+// Number of per-thread partial results worth the memory for the work.
+int Parts(std::int64_t work) {
+  std::int64_t parts = std::min<std::int64_t>(
+      s21::ThreadCount(), work / s21::kParallelMinElements);
+  return static_cast<int>(std::max<std::int64_t>(1, parts));
+}
+
+// Start of part p when [0, count) is cut into parts ranges.
+int Split(int count, int parts, long p) {
+  return static_cast<int>(std::int64_t(count) * p / parts);
+}
+
+}  // namespace
+
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix() noexcept
+    : rows_(0), cols_(0), format_(SparseFormat::kCsr) {}
+
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    int rows, int cols, SparseFormat format,
+    std::pmr::memory_resource *resource)
+    : rows_(rows),
+      cols_(cols),
+      format_(format),
+      offsets_(resource),
+      indices_(resource),
+      values_(resource) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument("Rows or columns is less or equal 0");
+  }
+  offsets_.assign(static_cast<std::size_t>(Outer()) + 1, 0);
+}
+
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    int rows, int cols, const std::vector<s21::Triplet<T>> &entries,
+    SparseFormat format, std::pmr::memory_resource *resource)
+    : S21BasicSparseMatrix(rows, cols, format, resource) {
+  const bool csr = format == SparseFormat::kCsr;
+  std::vector<s21::Triplet<T>> sorted(entries);
+  for (const s21::Triplet<T> &e : sorted) {
+    if (e.row < 0 || e.row >= rows || e.col < 0 || e.col >= cols) {
+      throw std::out_of_range("Incorrect input, index is out of range");
+    }
+  }
+  auto key = [csr](const s21::Triplet<T> &e) {
+    return csr ? std::make_pair(e.row, e.col) : std::make_pair(e.col, e.row);
+  };
+  std::sort(sorted.begin(), sorted.end(),
+            [&](const s21::Triplet<T> &l, const s21::Triplet<T> &r) {
+              return key(l) < key(r);
+            });
+  indices_.reserve(sorted.size());
+  values_.reserve(sorted.size());
+  for (std::size_t e = 0; e < sorted.size(); ++e) {
+    if (e > 0 && key(sorted[e]) == key(sorted[e - 1])) {
+      values_.back() += sorted[e].value;
+      continue;
+    }
+    indices_.push_back(key(sorted[e]).second);
+    values_.push_back(sorted[e].value);
+    ++offsets_[key(sorted[e]).first + 1];
+  }
+  std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+}
+
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    const S21BasicMatrix<T> &dense, SparseFormat format,
+    std::pmr::memory_resource *resource)
+    : S21BasicSparseMatrix(dense.GetRows(), dense.GetCols(), format,
+                           resource) {
+  const T *data = dense.Data();
+  const std::ptrdiff_t outer_stride =
+      format_ == SparseFormat::kCsr ? dense.Stride() : 1;
+  const std::ptrdiff_t inner_stride =
+      format_ == SparseFormat::kCsr ? 1 : dense.Stride();
+  const int outer = Outer(), inner = Inner();
+  const long grain = Grain(std::int64_t(rows_) * cols_, outer);
+  s21::ParallelFor(outer, grain, [&](long begin, long end) {
+    for (long o = begin; o < end; ++o) {
+      const T *line = data + o * outer_stride;
+      std::int64_t count = 0;
+      for (int q = 0; q < inner; ++q) count += line[q * inner_stride] != T(0);
+      offsets_[o + 1] = count;
+    }
+  });
+  std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+  indices_.resize(offsets_.back());
+  values_.resize(offsets_.back());
+  s21::ParallelFor(outer, grain, [&](long begin, long end) {
+    for (long o = begin; o < end; ++o) {
+      const T *line = data + o * outer_stride;
+      std::int64_t e = offsets_[o];
+      for (int q = 0; q < inner; ++q) {
+        if (line[q * inner_stride] != T(0)) {
+          indices_[e] = q;
+          values_[e++] = line[q * inner_stride];
+        }
+      }
+    }
+  });
+}
+
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    const S21BasicSparseMatrix &other)
+    : S21BasicSparseMatrix(other, std::pmr::get_default_resource()) {}
+
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    const S21BasicSparseMatrix &other, std::pmr::memory_resource *resource)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      format_(other.format_),
+      offsets_(other.offsets_, resource),
+      indices_(other.indices_, resource),
+      values_(other.values_, resource) {}
+
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    S21BasicSparseMatrix &&other) noexcept
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      format_(other.format_),
+      offsets_(std::move(other.offsets_)),
+      indices_(std::move(other.indices_)),
+      values_(std::move(other.values_)) {
+  other.rows_ = 0;
+  other.cols_ = 0;
+}
+
+template <class T>
+S21BasicSparseMatrix<T>::~S21BasicSparseMatrix() = default;
+
+template <class T>
+S21BasicSparseMatrix<T> &S21BasicSparseMatrix<T>::operator=(
+    const S21BasicSparseMatrix &other) {
+  if (this == &other) return *this;
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  format_ = other.format_;
+  offsets_ = other.offsets_;
+  indices_ = other.indices_;
+  values_ = other.values_;
+  return *this;
+}
+
+template <class T>
+S21BasicSparseMatrix<T> &S21BasicSparseMatrix<T>::operator=(
+    S21BasicSparseMatrix &&other) {
+  if (this == &other) return *this;
+  // The vectors take other's buffers when the resources are equal and
+  // copy otherwise; either way other ends up empty.
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  format_ = other.format_;
+  offsets_ = std::move(other.offsets_);
+  indices_ = std::move(other.indices_);
+  values_ = std::move(other.values_);
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.offsets_.clear();
+  other.indices_.clear();
+  other.values_.clear();
+  return *this;
+}
+
+template <class T>
+T S21BasicSparseMatrix<T>::operator()(int i, int j) const {
+  CheckNull();
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Incorrect input, index is out of range");
+  }
+  const bool csr = format_ == SparseFormat::kCsr;
+  const int o = csr ? i : j, q = csr ? j : i;
+  const int *first = indices_.data() + offsets_[o];
+  const int *last = indices_.data() + offsets_[o + 1];
+  const int *found = std::lower_bound(first, last, q);
+  if (found == last || *found != q) return T(0);
+  return values_[found - indices_.data()];
+}
+
+template <class T>
+int S21BasicSparseMatrix<T>::GetRows() const noexcept {
+  return rows_;
+}
+
+template <class T>
+int S21BasicSparseMatrix<T>::GetCols() const noexcept {
+  return cols_;
+}
+
+template <class T>
+std::int64_t S21BasicSparseMatrix<T>::NonZeros() const noexcept {
+  return static_cast<std::int64_t>(values_.size());
+}
+
+template <class T>
+SparseFormat S21BasicSparseMatrix<T>::Format() const noexcept {
+  return format_;
+}
+
+template <class T>
+std::pmr::memory_resource *S21BasicSparseMatrix<T>::GetResource()
+    const noexcept {
+  return values_.get_allocator().resource();
+}
+
+template <class T>
+const std::int64_t *S21BasicSparseMatrix<T>::Offsets() const noexcept {
+  return offsets_.data();
+}
+
+template <class T>
+const int *S21BasicSparseMatrix<T>::Indices() const noexcept {
+  return indices_.data();
+}
+
+template <class T>
+const T *S21BasicSparseMatrix<T>::Values() const noexcept {
+  return values_.data();
+}
+
+template <class T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Convert(
+    SparseFormat format) const {
+  if (format == format_) return S21BasicSparseMatrix(*this, GetResource());
+  return Regrouped();
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::ToDense() const {
+  CheckNull();
+  S21BasicMatrix<T> dense(rows_, cols_, GetResource());
+  AddTo(dense);
+  return dense;
+}
+
+template <class T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Transpose() const {
+  // The other format's arrays of A are this format's arrays of A^T.
+  S21BasicSparseMatrix result = Regrouped();
+  result.format_ = format_;
+  std::swap(result.rows_, result.cols_);
+  return result;
+}
+
+template <class T>
+std::vector<T> S21BasicSparseMatrix<T>::MulVector(
+    const std::vector<T> &x) const {
+  CheckNull();
+  if (x.size() != static_cast<std::size_t>(cols_)) {
+    throw std::runtime_error("Error: impossible to multiply");
+  }
+  S21BasicMatrix<T> y =
+      MulMatrix(s21::MatrixView<const T>(x.data(), cols_, 1, 1));
+  std::vector<T> result(rows_);
+  for (int i = 0; i < rows_; ++i) result[i] = y.Data()[i * y.Stride()];
+  return result;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::MulMatrix(
+    s21::MatrixView<const T> dense) const {
+  CheckNull();
+  if (dense.Empty()) throw std::runtime_error("Error: matrix is null");
+  if (dense.Rows() != cols_) {
+    throw std::runtime_error("Error: impossible to multiply");
+  }
+  const int n = dense.Cols();
+  S21BasicMatrix<T> result(rows_, n, GetResource());
+  T *c = result.Data();
+  const std::ptrdiff_t ldc = result.Stride();
+  // out[j0:j1] += value * dense(q, j0:j1).
+  auto axpy = [&dense](T value, int q, int j0, int j1, T *out) {
+    const T *b = dense.Data() + q * dense.RowStride();
+    const std::ptrdiff_t step = dense.ColStride();
+    for (int j = j0; j < j1; ++j) out[j] += value * b[j * step];
+  };
+  const std::int64_t work = NonZeros() * n;
+  if (format_ == SparseFormat::kCsr) {
+    s21::ParallelFor(rows_, Grain(work, rows_), [&](long begin, long end) {
+      for (long i = begin; i < end; ++i) {
+        for (std::int64_t e = offsets_[i]; e < offsets_[i + 1]; ++e) {
+          axpy(values_[e], indices_[e], 0, n, c + i * ldc);
+        }
+      }
+    });
+    return result;
+  }
+
+  // CSC scatters column q of this matrix into every row of the result, so
+  // tasks either own disjoint column blocks of the result or accumulate
+  // disjoint column ranges of this matrix into partial results.
+  const int parts = Parts(work);
+  const long blocks = (n + kColumnBlock - 1) / kColumnBlock;
+  if (parts > 1 && blocks >= s21::ThreadCount()) {
+    s21::ParallelFor(blocks, 1, [&](long begin, long end) {
+      for (long block = begin; block < end; ++block) {
+        const int j0 = static_cast<int>(block * kColumnBlock);
+        const int j1 = std::min(n, j0 + kColumnBlock);
+        for (int q = 0; q < cols_; ++q) {
+          for (std::int64_t e = offsets_[q]; e < offsets_[q + 1]; ++e) {
+            axpy(values_[e], q, j0, j1, c + indices_[e] * ldc);
+          }
+        }
+      }
+    });
+    return result;
+  }
+  const std::size_t part_size = static_cast<std::size_t>(rows_) * n;
+  std::pmr::vector<T> partial((parts - 1) * part_size, T(0), GetResource());
+  s21::ParallelFor(parts, 1, [&](long begin, long end) {
+    for (long p = begin; p < end; ++p) {
+      T *out = p == 0 ? c : partial.data() + (p - 1) * part_size;
+      const std::ptrdiff_t ld = p == 0 ? ldc : n;
+      for (int q = Split(cols_, parts, p); q < Split(cols_, parts, p + 1);
+           ++q) {
+        for (std::int64_t e = offsets_[q]; e < offsets_[q + 1]; ++e) {
+          axpy(values_[e], q, 0, n, out + indices_[e] * ld);
+        }
+      }
+    }
+  });
+  if (parts > 1) {
+    const long grain = Grain(std::int64_t(parts) * part_size, rows_);
+    s21::ParallelFor(rows_, grain, [&](long begin, long end) {
+      for (long i = begin; i < end; ++i) {
+        for (int p = 1; p < parts; ++p) {
+          const T *row = partial.data() + (p - 1) * part_size + i * n;
+          for (int j = 0; j < n; ++j) c[i * ldc + j] += row[j];
+        }
+      }
+    });
+  }
+  return result;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicMatrix<T> &dense) const {
+  return MulMatrix(dense.View());
+}
+
+template <class T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicSparseMatrix &other) const {
+  CheckNull();
+  other.CheckNull();
+  if (cols_ != other.rows_) {
+    throw std::runtime_error("Error: impossible to multiply");
+  }
+  const bool same = other.format_ == format_;
+  const S21BasicSparseMatrix converted =
+      same ? S21BasicSparseMatrix() : other.Regrouped();
+  const S21BasicSparseMatrix &right = same ? other : converted;
+  S21BasicSparseMatrix result(rows_, other.cols_, format_, GetResource());
+  if (format_ == SparseFormat::kCsr) {
+    RowProduct(*this, right, result);
+  } else {
+    RowProduct(right, *this, result);
+  }
+  return result;
+}
+
+template <class T>
+void S21BasicSparseMatrix<T>::AddTo(S21BasicMatrix<T> &dense,
+                                    T alpha) const {
+  CheckNull();
+  if (dense.GetRows() != rows_ || dense.GetCols() != cols_) {
+    throw std::runtime_error("Error: sizes are not equal");
+  }
+  T *data = dense.Data();
+  const bool csr = format_ == SparseFormat::kCsr;
+  const std::ptrdiff_t outer_stride = csr ? dense.Stride() : 1;
+  const std::ptrdiff_t inner_stride = csr ? 1 : dense.Stride();
+  const int outer = Outer();
+  s21::ParallelFor(outer, Grain(NonZeros(), outer), [&](long begin, long end) {
+    for (long o = begin; o < end; ++o) {
+      T *line = data + o * outer_stride;
+      for (std::int64_t e = offsets_[o]; e < offsets_[o + 1]; ++e) {
+        line[indices_[e] * inner_stride] += alpha * values_[e];
+      }
+    }
+  });
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::operator+(
+    const S21BasicMatrix<T> &dense) const {
+  S21BasicMatrix<T> result(dense, GetResource());
+  AddTo(result);
+  return result;
+}
+
+template <class T>
+int S21BasicSparseMatrix<T>::Outer() const noexcept {
+  return format_ == SparseFormat::kCsr ? rows_ : cols_;
+}
+
+template <class T>
+int S21BasicSparseMatrix<T>::Inner() const noexcept {
+  return format_ == SparseFormat::kCsr ? cols_ : rows_;
+}
+
+template <class T>
+void S21BasicSparseMatrix<T>::CheckNull() const {
+  if (offsets_.empty()) throw std::runtime_error("Error: matrix is null");
+}
+
+template <class T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Regrouped() const {
+  CheckNull();
+  S21BasicSparseMatrix result(
+      rows_, cols_,
+      format_ == SparseFormat::kCsr ? SparseFormat::kCsc : SparseFormat::kCsr,
+      GetResource());
+  const int outer = Outer(), inner = Inner();
+  const int parts = Parts(NonZeros());
+  // Counting sort by inner index. Each part counts the entries of its
+  // outer range, then scatters them behind those of the earlier parts, so
+  // the new inner lists come out sorted without a merge.
+  std::pmr::vector<std::int64_t> positions(
+      static_cast<std::size_t>(parts) * inner, 0, GetResource());
+  s21::ParallelFor(parts, 1, [&](long begin, long end) {
+    for (long p = begin; p < end; ++p) {
+      std::int64_t *count = positions.data() + p * inner;
+      for (int o = Split(outer, parts, p); o < Split(outer, parts, p + 1);
+           ++o) {
+        for (std::int64_t e = offsets_[o]; e < offsets_[o + 1]; ++e) {
+          ++count[indices_[e]];
+        }
+      }
+    }
+  });
+  std::int64_t total = 0;
+  for (int q = 0; q < inner; ++q) {
+    result.offsets_[q] = total;
+    for (int p = 0; p < parts; ++p) {
+      std::int64_t count = positions[std::size_t(p) * inner + q];
+      positions[std::size_t(p) * inner + q] = total;
+      total += count;
+    }
+  }
+  result.offsets_[inner] = total;
+  result.indices_.resize(total);
+  result.values_.resize(total);
+  s21::ParallelFor(parts, 1, [&](long begin, long end) {
+    for (long p = begin; p < end; ++p) {
+      std::int64_t *next = positions.data() + p * inner;
+      for (int o = Split(outer, parts, p); o < Split(outer, parts, p + 1);
+           ++o) {
+        for (std::int64_t e = offsets_[o]; e < offsets_[o + 1]; ++e) {
+          std::int64_t to = next[indices_[e]]++;
+          result.indices_[to] = o;
+          result.values_[to] = values_[e];
+        }
+      }
+    }
+  });
+  return result;
+}
+
+template <class T>
+void S21BasicSparseMatrix<T>::RowProduct(const S21BasicSparseMatrix &left,
+                                         const S21BasicSparseMatrix &right,
+                                         S21BasicSparseMatrix &result) {
+  // Gustavson's algorithm: row i of the product merges the rows of right
+  // picked by the entries of row i of left. A symbolic pass counts each
+  // row's entries so the numeric pass can write in place, in parallel.
+  const int outer = left.Outer(), width = right.Inner();
+  const std::int64_t per_row =
+      std::max<std::int64_t>(1, right.NonZeros() / right.Outer());
+  const long grain = Grain(left.NonZeros() * per_row, outer);
+  s21::ParallelFor(outer, grain, [&](long begin, long end) {
+    std::vector<long> seen(width, -1);
+    for (long i = begin; i < end; ++i) {
+      std::int64_t count = 0;
+      for (std::int64_t a = left.offsets_[i]; a < left.offsets_[i + 1]; ++a) {
+        const int q = left.indices_[a];
+        for (std::int64_t b = right.offsets_[q]; b < right.offsets_[q + 1];
+             ++b) {
+          const int j = right.indices_[b];
+          if (seen[j] != i) {
+            seen[j] = i;
+            ++count;
+          }
+        }
+      }
+      result.offsets_[i + 1] = count;
+    }
+  });
+  std::partial_sum(result.offsets_.begin(), result.offsets_.end(),
+                   result.offsets_.begin());
+  result.indices_.resize(result.offsets_.back());
+  result.values_.resize(result.offsets_.back());
+  s21::ParallelFor(outer, grain, [&](long begin, long end) {
+    std::vector<long> seen(width, -1);
+    std::vector<T> sum(width);
+    for (long i = begin; i < end; ++i) {
+      const std::int64_t start = result.offsets_[i];
+      std::int64_t next = start;
+      for (std::int64_t a = left.offsets_[i]; a < left.offsets_[i + 1]; ++a) {
+        const int q = left.indices_[a];
+        const T value = left.values_[a];
+        for (std::int64_t b = right.offsets_[q]; b < right.offsets_[q + 1];
+             ++b) {
+          const int j = right.indices_[b];
+          if (seen[j] != i) {
+            seen[j] = i;
+            sum[j] = value * right.values_[b];
+            result.indices_[next++] = j;
+          } else {
+            sum[j] += value * right.values_[b];
+          }
+        }
+      }
+      std::sort(result.indices_.begin() + start,
+                result.indices_.begin() + next);
+      for (std::int64_t e = start; e < next; ++e) {
+        result.values_[e] = sum[result.indices_[e]];
+      }
+    }
+  });
+}
+
+template class S21BasicSparseMatrix<float>;
+template class S21BasicSparseMatrix<double>;
+template class S21BasicSparseMatrix<std::int32_t>;
+template class S21BasicSparseMatrix<std::complex<double>>;
@@ -0,0 +1,135 @@
+#ifndef SRC_S21_SPARSE_MATRIX_H_
+#define SRC_S21_SPARSE_MATRIX_H_
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Compressed sparse row or column storage.
+enum class SparseFormat { kCsr, kCsc };
+
+// One entry of a sparse matrix in coordinate form.
+template <class T>
+struct Triplet {
+  int row;
+  int col;
+  T value;
+};
+
+}  // namespace s21
+
+// Sparse matrix of T in compressed sparse row (CSR) or column (CSC) form,
+// instantiated for the same element types as S21BasicMatrix. Only the
+// nonzeros are stored: for CSR, Offsets()[i] .. Offsets()[i + 1] index the
+// column indices and values of row i, sorted by column; CSC is the same
+// with rows and columns swapped. Storage is one index and one value per
+// nonzero plus one offset per row (CSR) or column (CSC).
+//
+// Products, sums, transposes and conversions are split over the thread
+// pool by outer index (rows for CSR, columns for CSC). CSR suits
+// products with a dense or sparse right-hand side; CSC multiplies as the
+// left operand too but needs per-thread partial results to do it.
+//
+// Storage comes from a std::pmr::memory_resource with the same rules as
+// S21BasicMatrix.
+template <class T>
+class S21BasicSparseMatrix {
+ public:
+  using Scalar = T;
+
+  S21BasicSparseMatrix() noexcept;
+  // All-zero rows x cols matrix.
+  S21BasicSparseMatrix(
+      int rows, int cols, s21::SparseFormat format = s21::SparseFormat::kCsr,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+  // Entries in any order; duplicates are summed. Throws std::out_of_range
+  // for an entry outside rows x cols.
+  S21BasicSparseMatrix(
+      int rows, int cols, const std::vector<s21::Triplet<T>> &entries,
+      s21::SparseFormat format = s21::SparseFormat::kCsr,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+  // Keeps the nonzero elements of dense.
+  explicit S21BasicSparseMatrix(
+      const S21BasicMatrix<T> &dense,
+      s21::SparseFormat format = s21::SparseFormat::kCsr,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+  S21BasicSparseMatrix(const S21BasicSparseMatrix &other);
+  S21BasicSparseMatrix(const S21BasicSparseMatrix &other,
+                       std::pmr::memory_resource *resource);
+  S21BasicSparseMatrix(S21BasicSparseMatrix &&other) noexcept;
+  ~S21BasicSparseMatrix();
+
+  S21BasicSparseMatrix &operator=(const S21BasicSparseMatrix &other);
+  S21BasicSparseMatrix &operator=(S21BasicSparseMatrix &&other);
+  // Element (i, j), zero when not stored; a binary search in row i (CSR)
+  // or column j (CSC).
+  T operator()(int i, int j) const;
+
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  std::int64_t NonZeros() const noexcept;
+  s21::SparseFormat Format() const noexcept;
+  std::pmr::memory_resource *GetResource() const noexcept;
+  // Outer() + 1 offsets into Indices() and Values().
+  const std::int64_t *Offsets() const noexcept;
+  const int *Indices() const noexcept;
+  const T *Values() const noexcept;
+
+  // The same matrix in the other format, or a copy in the same one.
+  S21BasicSparseMatrix Convert(s21::SparseFormat format) const;
+  S21BasicMatrix<T> ToDense() const;
+  // Keeps the format.
+  S21BasicSparseMatrix Transpose() const;
+
+  // this * x for a vector of GetCols() elements (SpMV).
+  std::vector<T> MulVector(const std::vector<T> &x) const;
+  // this * dense (SpMM); throws std::runtime_error on mismatched sizes.
+  S21BasicMatrix<T> MulMatrix(s21::MatrixView<const T> dense) const;
+  S21BasicMatrix<T> operator*(const S21BasicMatrix<T> &dense) const;
+  // Sparse product in this matrix's format; other is converted first if
+  // its format differs. Entries that cancel to zero stay stored.
+  S21BasicSparseMatrix operator*(const S21BasicSparseMatrix &other) const;
+  // dense += alpha * this.
+  void AddTo(S21BasicMatrix<T> &dense, T alpha = T(1)) const;
+  S21BasicMatrix<T> operator+(const S21BasicMatrix<T> &dense) const;
+
+ private:
+  int rows_;
+  int cols_;
+  s21::SparseFormat format_;
+  std::pmr::vector<std::int64_t> offsets_;
+  std::pmr::vector<int> indices_;
+  std::pmr::vector<T> values_;
+  int Outer() const noexcept;
+  int Inner() const noexcept;
+  void CheckNull() const;
+  // The same matrix in the other format, by a parallel counting sort.
+  S21BasicSparseMatrix Regrouped() const;
+  // Product of the compressed arrays as if both were CSR: left * right in
+  // the CSR case and (right^T left^T)^T stored as CSC in the other.
+  static void RowProduct(const S21BasicSparseMatrix &left,
+                         const S21BasicSparseMatrix &right,
+                         S21BasicSparseMatrix &result);
+};
+
+template <class T>
+S21BasicMatrix<T> operator+(const S21BasicMatrix<T> &dense,
+                            const S21BasicSparseMatrix<T> &sparse) {
+  return sparse + dense;
+}
+
+using S21SparseMatrix = S21BasicSparseMatrix<double>;
+using S21FloatSparseMatrix = S21BasicSparseMatrix<float>;
+using S21IntSparseMatrix = S21BasicSparseMatrix<std::int32_t>;
+using S21ComplexSparseMatrix = S21BasicSparseMatrix<std::complex<double>>;
+
+extern template class S21BasicSparseMatrix<float>;
+extern template class S21BasicSparseMatrix<double>;
+extern template class S21BasicSparseMatrix<std::int32_t>;
+extern template class S21BasicSparseMatrix<std::complex<double>>;
+
+#endif
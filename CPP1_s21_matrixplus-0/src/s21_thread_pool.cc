@@ -0,0 +1,172 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+thread_local bool in_pool_task = false;
+
+// Chunks per participant, so stealing has something to balance.
+constexpr long kChunksPerThread = 4;
+
+std::unique_ptr<ThreadPool> &DefaultPoolSlot() {
+  static std::unique_ptr<ThreadPool> pool = std::make_unique<ThreadPool>(
+      static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+  return pool;
+}
+
+bool pinning_requested = false;
+
+}  // namespace
+
+ThreadPool::ThreadPool(int threads) {
+  threads = std::max(1, threads);
+  for (int i = 0; i < threads; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (int i = 1; i < threads; ++i) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto &worker : workers_) worker.join();
+}
+
+int ThreadPool::Size() const noexcept {
+  return static_cast<int>(queues_.size());
+}
+
+void ThreadPool::SetPinning(bool enabled) {
+#if defined(__linux__)
+  const int cpus =
+      static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  for (std::size_t i = 0; i < workers_.size(); ++i) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (enabled) {
+      CPU_SET(static_cast<int>(i + 1) % cpus, &set);
+    } else {
+      for (int cpu = 0; cpu < cpus; ++cpu) CPU_SET(cpu, &set);
+    }
+    pthread_setaffinity_np(workers_[i].native_handle(), sizeof(set), &set);
+  }
+#else
+  (void)enabled;
+#endif
+}
+
+void ThreadPool::ParallelFor(long count, long grain,
+                             const std::function<void(long, long)> &body) {
+  if (count <= 0) return;
+  grain = std::max(1L, grain);
+  long chunks = std::min(count / grain, Size() * kChunksPerThread);
+  if (chunks <= 1 || in_pool_task) {
+    body(0, count);
+    return;
+  }
+
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  body_ = &body;
+  error_ = nullptr;
+  pending_.store(chunks);
+  for (long c = 0; c < chunks; ++c) {
+    Queue &queue = *queues_[c % Size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back({count * c / chunks, count * (c + 1) / chunks});
+  }
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    ++generation_;
+  }
+  wake_.notify_all();
+
+  Work(0);
+  std::unique_lock<std::mutex> lock(state_mutex_);
+  done_.wait(lock, [this] { return pending_.load() == 0; });
+  body_ = nullptr;
+  if (error_) std::rethrow_exception(error_);
+}
+
+void ThreadPool::WorkerLoop(int index) {
+  unsigned long seen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(state_mutex_);
+      wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_) return;
+      seen = generation_;
+    }
+    Work(index);
+  }
+}
+
+void ThreadPool::Work(int index) {
+  Range range;
+  while (Pop(index, range) || Steal(index, range)) {
+    in_pool_task = true;
+    try {
+      (*body_)(range.begin, range.end);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(state_mutex_);
+      if (!error_) error_ = std::current_exception();
+    }
+    in_pool_task = false;
+    if (pending_.fetch_sub(1) == 1) {
+      std::lock_guard<std::mutex> lock(state_mutex_);
+      done_.notify_all();
+    }
+  }
+}
+
+bool ThreadPool::Pop(int index, Range &range) {
+  Queue &queue = *queues_[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) return false;
+  range = queue.tasks.back();
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool ThreadPool::Steal(int index, Range &range) {
+  for (int offset = 1; offset < Size(); ++offset) {
+    Queue &queue = *queues_[(index + offset) % Size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      range = queue.tasks.front();
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+ThreadPool &DefaultThreadPool() { return *DefaultPoolSlot(); }
+
+void SetThreadCount(int threads) {
+  auto &pool = DefaultPoolSlot();
+  pool.reset();
+  pool = std::make_unique<ThreadPool>(threads);
+  if (pinning_requested) pool->SetPinning(true);
+}
+
+int ThreadCount() { return DefaultThreadPool().Size(); }
+
+void SetThreadPinning(bool enabled) {
+  pinning_requested = enabled;
+  DefaultThreadPool().SetPinning(enabled);
+}
+
+}  // namespace s21
@@ -0,0 +1,96 @@
+#ifndef SRC_S21_THREAD_POOL_H_
+#define SRC_S21_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+// Element-wise loops below this many elements stay on the calling thread.
+constexpr long kParallelMinElements = 1L << 15;
+// Products with fewer multiply-adds than this stay on the calling thread.
+constexpr long kParallelMinFlops = 1L << 21;
+
+// Fixed set of workers with one task deque each. A worker pops its own
+// deque from the back and, once empty, steals from the front of the others,
+// so uneven chunks even out without a central queue. The thread that calls
+// ParallelFor takes part as participant 0.
+class ThreadPool {
+ public:
+  // Starts threads - 1 workers; threads <= 1 runs everything inline.
+  explicit ThreadPool(int threads);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool();
+
+  int Size() const noexcept;
+
+  // Pins worker i to logical CPU (i + 1) % cpus, leaving CPU 0 to the
+  // calling thread, which works through chunks too; the caller's own
+  // affinity is not changed. Disabling lets the workers run on any CPU
+  // again. No-op where thread affinity is not supported.
+  void SetPinning(bool enabled);
+
+  // Calls body(begin, end) on disjoint chunks covering [0, count), each at
+  // least grain long, and returns once all of them ran. Runs inline when
+  // the range is a single chunk or when called from inside a task. The
+  // first exception thrown by body is rethrown here.
+  void ParallelFor(long count, long grain,
+                   const std::function<void(long, long)> &body);
+
+ private:
+  struct Range {
+    long begin;
+    long end;
+  };
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Range> tasks;
+  };
+
+  void WorkerLoop(int index);
+  void Work(int index);
+  bool Pop(int index, Range &range);
+  bool Steal(int index, Range &range);
+
+  std::vector<std::thread> workers_;
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::mutex run_mutex_;
+  std::mutex state_mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const std::function<void(long, long)> *body_ = nullptr;
+  std::atomic<long> pending_{0};
+  unsigned long generation_ = 0;
+  bool stop_ = false;
+  std::exception_ptr error_;
+};
+
+// Process-wide pool used by the matrix kernels, sized to the hardware
+// concurrency on first use.
+ThreadPool &DefaultThreadPool();
+
+// Replaces the default pool with one of the given size (1 disables
+// threading). Must not be called while matrix operations are running.
+void SetThreadCount(int threads);
+int ThreadCount();
+void SetThreadPinning(bool enabled);
+
+// ParallelFor on the default pool. The body is passed by reference, so
+// wrapping it in std::function never allocates.
+template <class Body>
+void ParallelFor(long count, long grain, const Body &body) {
+  DefaultThreadPool().ParallelFor(
+      count, grain, std::function<void(long, long)>(std::cref(body)));
+}
+
+}  // namespace s21
+
+#endif
@@ -1,91 +1,222 @@
 #include <gtest/gtest.h>
-
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "s21_arena.h"
+#include "s21_cholesky_factorization.h"
+#include "s21_fixed_matrix.h"
+#include "s21_gemm.h"
+#include "s21_kernels.h"
+#include "s21_lu_factorization.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_file.h"
 #include "s21_matrix_oop.h"
-
-TEST(S21Matrix, ConstructorDefault) {
-  S21Matrix m;
+#include "s21_matrix_text.h"
+#include "s21_qr_factorization.h"
+#include "s21_sparse_matrix.h"
+#include "s21_thread_pool.h"
+
+static S21Matrix FillPattern(int rows, int cols, int seed) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      m(i, j) = ((i * 7 + j * 13 + seed) % 17) / 8.0 - 1.0;
+    }
+  }
+  return m;
+}
+
+template <class T>
+static S21BasicMatrix<T> NaiveProduct(const S21BasicMatrix<T> &a,
+                                      const S21BasicMatrix<T> &b) {
+  S21BasicMatrix<T> res(a.GetRows(), b.GetCols());
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < b.GetCols(); j++) {
+      T sum = 0;
+      for (int k = 0; k < a.GetCols(); k++) sum += a(i, k) * b(k, j);
+      res(i, j) = sum;
+    }
+  }
+  return res;
+}
+
+// Typed suites run once per element type.
+template <class T>
+class S21BasicMatrixTest : public ::testing::Test {
+ protected:
+  // Small integers, so every type represents them and their products
+  // exactly.
+  static S21BasicMatrix<T> Pattern(int rows, int cols, int seed) {
+    S21BasicMatrix<T> m(rows, cols);
+    for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < cols; j++) {
+        m(i, j) = static_cast<T>((i * 7 + j * 13 + seed) % 9 - 4);
+      }
+    }
+    return m;
+  }
+
+  // L * U with unit diagonals: determinant 1 and an integer inverse.
+  static S21BasicMatrix<T> Unimodular(int n) {
+    S21BasicMatrix<T> l(n, n), u(n, n);
+    for (int i = 0; i < n; i++) {
+      l(i, i) = u(i, i) = 1;
+      for (int j = 0; j < i; j++) {
+        l(i, j) = static_cast<T>((i + 2 * j) % 3 - 1);
+        u(j, i) = static_cast<T>((2 * i + j) % 3 - 1);
+      }
+    }
+    return l * u;
+  }
+
+  static S21BasicMatrix<T> Identity(int n) {
+    S21BasicMatrix<T> m(n, n);
+    for (int i = 0; i < n; i++) m(i, i) = 1;
+    return m;
+  }
+
+  // Exact for integers. Floating types may differ by a rounding error
+  // relative to |expected| or to scale, whichever is larger.
+  static bool Near(T actual, T expected, double scale = 1) {
+    if constexpr (std::is_integral_v<T>) {
+      return actual == expected;
+    } else {
+      return std::abs(actual - expected) <=
+             1e-4 * std::max<double>(scale, std::abs(expected));
+    }
+  }
+
+  // Same for every element, relative to the largest expected one.
+  static bool Near(const S21BasicMatrix<T> &actual,
+                   const S21BasicMatrix<T> &expected, double scale = 1) {
+    if (actual.GetRows() != expected.GetRows() ||
+        actual.GetCols() != expected.GetCols()) {
+      return false;
+    }
+    for (int i = 0; i < expected.GetRows(); i++) {
+      for (int j = 0; j < expected.GetCols(); j++) {
+        scale = std::max<double>(scale, std::abs(expected(i, j)));
+      }
+    }
+    for (int i = 0; i < expected.GetRows(); i++) {
+      for (int j = 0; j < expected.GetCols(); j++) {
+        if (!Near(actual(i, j), expected(i, j), scale)) return false;
+      }
+    }
+    return true;
+  }
+};
+
+using ElementTypes =
+    ::testing::Types<float, double, std::int32_t, std::complex<double>>;
+TYPED_TEST_SUITE(S21BasicMatrixTest, ElementTypes);
+
+TYPED_TEST(S21BasicMatrixTest, ConstructorDefault) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m;
   EXPECT_EQ(m.GetRows(), 0);
   EXPECT_EQ(m.GetCols(), 0);
-  EXPECT_EQ(m.GetMatrix(), nullptr);
+  EXPECT_EQ(m.Data(), nullptr);
 }
 
-TEST(S21Matrix, ConstructorRowsCols) {
-  S21Matrix m(2, 3);
+TYPED_TEST(S21BasicMatrixTest, ConstructorRowsCols) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
   EXPECT_EQ(m.GetRows(), 2);
   EXPECT_EQ(m.GetCols(), 3);
-  EXPECT_NE(m.GetMatrix(), nullptr);
+  EXPECT_NE(m.Data(), nullptr);
 }
 
-TEST(S21Matrix, ConstructorCopy) {
-  S21Matrix m1(2, 3);
-  m1.SetValue(0, 0, 1.0);
-  S21Matrix m2(m1);
+TYPED_TEST(S21BasicMatrixTest, ConstructorCopy) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m1(2, 3);
+  m1.SetValue(0, 0, 1);
+  Matrix m2(m1);
   EXPECT_EQ(m2.GetRows(), 2);
   EXPECT_EQ(m2.GetCols(), 3);
-  EXPECT_NE(m2.GetMatrix(), nullptr);
-  EXPECT_EQ(m2.GetValue(0, 0), 1.0);
+  EXPECT_NE(m2.Data(), nullptr);
+  EXPECT_EQ(m2.GetValue(0, 0), TypeParam(1));
 }
 
-TEST(S21Matrix, ConstructorMove) {
-  S21Matrix m1(2, 3);
-  m1.SetValue(0, 0, 1.0);
-  S21Matrix m2(std::move(m1));
+TYPED_TEST(S21BasicMatrixTest, ConstructorMove) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m1(2, 3);
+  m1.SetValue(0, 0, 1);
+  Matrix m2(std::move(m1));
   EXPECT_EQ(m2.GetRows(), 2);
   EXPECT_EQ(m2.GetCols(), 3);
-  EXPECT_NE(m2.GetMatrix(), nullptr);
-  EXPECT_EQ(m2.GetValue(0, 0), 1.0);
+  EXPECT_NE(m2.Data(), nullptr);
+  EXPECT_EQ(m2.GetValue(0, 0), TypeParam(1));
   EXPECT_EQ(m1.GetRows(), 0);
   EXPECT_EQ(m1.GetCols(), 0);
-  EXPECT_EQ(m1.GetMatrix(), nullptr);
+  EXPECT_EQ(m1.Data(), nullptr);
 }
 
-TEST(S21MatrixTest, DefaultConstructorTest) {
-  S21Matrix matrix;
+TYPED_TEST(S21BasicMatrixTest, DefaultConstructorTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix matrix;
   EXPECT_EQ(matrix.GetRows(), 0);
   EXPECT_EQ(matrix.GetCols(), 0);
-  EXPECT_EQ(matrix.GetMatrix(), nullptr);
+  EXPECT_EQ(matrix.Data(), nullptr);
 }
 
-TEST(MatrixConstructorTest, CreateObjectWithValidParameters) {
-  S21Matrix matrix(3, 3);
+TYPED_TEST(S21BasicMatrixTest, CreateObjectWithValidParameters) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix matrix(3, 3);
   EXPECT_EQ(matrix.GetRows(), 3);
   EXPECT_EQ(matrix.GetCols(), 3);
 }
 
-TEST(MatrixConstructorTest, CreateObjectWithNegativeRows) {
-  ASSERT_ANY_THROW(S21Matrix matrix(-1, 3));
+TYPED_TEST(S21BasicMatrixTest, CreateObjectWithNegativeRows) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  ASSERT_ANY_THROW(Matrix matrix(-1, 3));
 }
 
-TEST(MatrixConstructorTest, CreateObjectWithNegativeCols) {
-  ASSERT_ANY_THROW(S21Matrix matrix(3, -1));
+TYPED_TEST(S21BasicMatrixTest, CreateObjectWithNegativeCols) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  ASSERT_ANY_THROW(Matrix matrix(3, -1));
 }
 
-TEST(MatrixConstructorTest, CreateObjectWithZeroRows) {
-  ASSERT_ANY_THROW(S21Matrix matrix(0, 3));
+TYPED_TEST(S21BasicMatrixTest, CreateObjectWithZeroRows) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  ASSERT_ANY_THROW(Matrix matrix(0, 3));
 }
 
-TEST(MatrixConstructorTest, CreateObjectWithZeroCols) {
-  ASSERT_ANY_THROW(S21Matrix matrix(3, 0));
+TYPED_TEST(S21BasicMatrixTest, CreateObjectWithZeroCols) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  ASSERT_ANY_THROW(Matrix matrix(3, 0));
 }
 
-TEST(S21MatrixTest, MoveConstructorTest) {
-  S21Matrix mat1(2, 2);
+TYPED_TEST(S21BasicMatrixTest, MoveConstructorTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix mat1(2, 2);
   mat1(0, 0) = 1;
   mat1(0, 1) = 2;
   mat1(1, 0) = 3;
   mat1(1, 1) = 4;
-  S21Matrix mat2(std::move(mat1));
+  Matrix mat2(std::move(mat1));
   ASSERT_EQ(mat2.GetRows(), 2);
   ASSERT_EQ(mat2.GetCols(), 2);
-  ASSERT_EQ(mat2(0, 0), 1);
-  ASSERT_EQ(mat2(0, 1), 2);
-  ASSERT_EQ(mat2(1, 0), 3);
-  ASSERT_EQ(mat2(1, 1), 4);
+  ASSERT_EQ(mat2(0, 0), TypeParam(1));
+  ASSERT_EQ(mat2(0, 1), TypeParam(2));
+  ASSERT_EQ(mat2(1, 0), TypeParam(3));
+  ASSERT_EQ(mat2(1, 1), TypeParam(4));
   ASSERT_EQ(mat1.GetRows(), 0);
   ASSERT_EQ(mat1.GetCols(), 0);
-  ASSERT_EQ(mat1.GetMatrix(), nullptr);
+  ASSERT_EQ(mat1.Data(), nullptr);
 
-  S21Matrix mat3(3, 3);
+  Matrix mat3(3, 3);
   mat3(0, 0) = 1;
   mat3(0, 1) = 0;
   mat3(0, 2) = 2;
@@ -95,113 +226,158 @@ TEST(S21MatrixTest, MoveConstructorTest) {
   mat3(2, 0) = 2;
   mat3(2, 1) = -1;
   mat3(2, 2) = 0;
-  S21Matrix mat4(std::move(mat3));
+  Matrix mat4(std::move(mat3));
   ASSERT_EQ(mat4.GetRows(), 3);
   ASSERT_EQ(mat4.GetCols(), 3);
-  ASSERT_EQ(mat4(0, 0), 1);
-  ASSERT_EQ(mat4(0, 1), 0);
-  ASSERT_EQ(mat4(0, 2), 2);
-  ASSERT_EQ(mat4(1, 0), -1);
-  ASSERT_EQ(mat4(1, 1), 3);
-  ASSERT_EQ(mat4(1, 2), 1);
-  ASSERT_EQ(mat4(2, 0), 2);
-  ASSERT_EQ(mat4(2, 1), -1);
-  ASSERT_EQ(mat4(2, 2), 0);
+  ASSERT_EQ(mat4(0, 0), TypeParam(1));
+  ASSERT_EQ(mat4(0, 1), TypeParam(0));
+  ASSERT_EQ(mat4(0, 2), TypeParam(2));
+  ASSERT_EQ(mat4(1, 0), TypeParam(-1));
+  ASSERT_EQ(mat4(1, 1), TypeParam(3));
+  ASSERT_EQ(mat4(1, 2), TypeParam(1));
+  ASSERT_EQ(mat4(2, 0), TypeParam(2));
+  ASSERT_EQ(mat4(2, 1), TypeParam(-1));
+  ASSERT_EQ(mat4(2, 2), TypeParam(0));
   ASSERT_EQ(mat3.GetRows(), 0);
   ASSERT_EQ(mat3.GetCols(), 0);
-  ASSERT_EQ(mat3.GetMatrix(), nullptr);
+  ASSERT_EQ(mat3.Data(), nullptr);
 }
 
-TEST(S21MatrixTest, CopyConstructorTest) {
-  S21Matrix mat1(2, 2);
-  mat1.GetMatrix()[0][0] = 1;
-  mat1.GetMatrix()[0][1] = 2;
-  mat1.GetMatrix()[1][0] = 3;
-  mat1.GetMatrix()[1][1] = 4;
-  S21Matrix mat2(mat1);
+TYPED_TEST(S21BasicMatrixTest, CopyConstructorTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix mat1(2, 2);
+  mat1(0, 0) = 1;
+  mat1(0, 1) = 2;
+  mat1(1, 0) = 3;
+  mat1(1, 1) = 4;
+  Matrix mat2(mat1);
   ASSERT_EQ(mat2.GetRows(), 2);
   ASSERT_EQ(mat2.GetCols(), 2);
-  ASSERT_EQ(mat2.GetMatrix()[0][0], 1);
-  ASSERT_EQ(mat2.GetMatrix()[0][1], 2);
-  ASSERT_EQ(mat2.GetMatrix()[1][0], 3);
-  ASSERT_EQ(mat2.GetMatrix()[1][1], 4);
-  ASSERT_NE(mat1.GetMatrix(), mat2.GetMatrix());
-
-  S21Matrix mat3(3, 3);
-  mat3.GetMatrix()[0][0] = 1;
-  mat3.GetMatrix()[0][1] = 0;
-  mat3.GetMatrix()[0][2] = 2;
-  mat3.GetMatrix()[1][0] = -1;
-  mat3.GetMatrix()[1][1] = 3;
-  mat3.GetMatrix()[1][2] = 1;
-  mat3.GetMatrix()[2][0] = 2;
-  mat3.GetMatrix()[2][1] = -1;
-  mat3.GetMatrix()[2][2] = 0;
-  S21Matrix mat4(mat3);
+  ASSERT_EQ(mat2(0, 0), TypeParam(1));
+  ASSERT_EQ(mat2(0, 1), TypeParam(2));
+  ASSERT_EQ(mat2(1, 0), TypeParam(3));
+  ASSERT_EQ(mat2(1, 1), TypeParam(4));
+  ASSERT_NE(mat1.Data(), mat2.Data());
+
+  Matrix mat3(3, 3);
+  mat3(0, 0) = 1;
+  mat3(0, 1) = 0;
+  mat3(0, 2) = 2;
+  mat3(1, 0) = -1;
+  mat3(1, 1) = 3;
+  mat3(1, 2) = 1;
+  mat3(2, 0) = 2;
+  mat3(2, 1) = -1;
+  mat3(2, 2) = 0;
+  Matrix mat4(mat3);
   ASSERT_EQ(mat4.GetRows(), 3);
   ASSERT_EQ(mat4.GetCols(), 3);
-  ASSERT_EQ(mat4.GetMatrix()[0][0], 1);
-  ASSERT_EQ(mat4.GetMatrix()[0][1], 0);
-  ASSERT_EQ(mat4.GetMatrix()[0][2], 2);
-  ASSERT_EQ(mat4.GetMatrix()[1][0], -1);
-  ASSERT_EQ(mat4.GetMatrix()[1][1], 3);
-  ASSERT_EQ(mat4.GetMatrix()[1][2], 1);
-  ASSERT_EQ(mat4.GetMatrix()[2][0], 2);
-  ASSERT_EQ(mat4.GetMatrix()[2][1], -1);
-  ASSERT_EQ(mat4.GetMatrix()[2][2], 0);
-  ASSERT_NE(mat3.GetMatrix(), mat4.GetMatrix());
-}
-
-TEST(S21MatrixTest, GetRowsTest) {
-  S21Matrix mat1(2, 2);
+  ASSERT_EQ(mat4(0, 0), TypeParam(1));
+  ASSERT_EQ(mat4(0, 1), TypeParam(0));
+  ASSERT_EQ(mat4(0, 2), TypeParam(2));
+  ASSERT_EQ(mat4(1, 0), TypeParam(-1));
+  ASSERT_EQ(mat4(1, 1), TypeParam(3));
+  ASSERT_EQ(mat4(1, 2), TypeParam(1));
+  ASSERT_EQ(mat4(2, 0), TypeParam(2));
+  ASSERT_EQ(mat4(2, 1), TypeParam(-1));
+  ASSERT_EQ(mat4(2, 2), TypeParam(0));
+  ASSERT_NE(mat3.Data(), mat4.Data());
+}
+
+TYPED_TEST(S21BasicMatrixTest, MoveAssignmentTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix a = this->Pattern(3, 4, 1);
+  const TypeParam *buffer = a.Data();
+  Matrix b(7, 7);
+  b = std::move(a);
+  EXPECT_EQ(b.Data(), buffer);
+  EXPECT_EQ(b.GetRows(), 3);
+  EXPECT_EQ(b.GetCols(), 4);
+  EXPECT_EQ(a.Data(), nullptr);
+  EXPECT_EQ(a.GetRows(), 0);
+  EXPECT_TRUE(b == this->Pattern(3, 4, 1));
+}
+
+TYPED_TEST(S21BasicMatrixTest, CopyAssignmentReusesSameShape) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix a = this->Pattern(5, 9, 1);
+  Matrix b(5, 9);
+  const TypeParam *buffer = b.Data();
+  b = a;
+  EXPECT_EQ(b.Data(), buffer);
+  EXPECT_TRUE(b == a);
+  b = this->Pattern(2, 2, 0);
+  EXPECT_EQ(b.GetRows(), 2);
+}
+
+TYPED_TEST(S21BasicMatrixTest, RvalueOperatorsReuseStorage) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix a = this->Pattern(40, 30, 1);
+  Matrix b = this->Pattern(40, 30, 2);
+  Matrix t(a);
+  const TypeParam *buffer = t.Data();
+  Matrix r = ((std::move(t) + b) - a) * TypeParam(3);
+  EXPECT_EQ(r.Data(), buffer);
+  EXPECT_TRUE(r == b * TypeParam(3));
+
+  Matrix u(b);
+  buffer = u.Data();
+  Matrix s = a - std::move(u);
+  EXPECT_EQ(s.Data(), buffer);
+  EXPECT_TRUE(s == a - b);
+
+  Matrix v(b);
+  buffer = v.Data();
+  Matrix w = (a + a) - std::move(v);
+  EXPECT_EQ(w.Data(), buffer);
+  EXPECT_TRUE(w == a * TypeParam(2) - b);
+  EXPECT_THROW(std::move(w) + Matrix(3, 3), std::runtime_error);
+}
+
+TYPED_TEST(S21BasicMatrixTest, GetRowsTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix mat1(2, 2);
   ASSERT_EQ(mat1.GetRows(), 2);
 
-  S21Matrix mat2(3, 4);
+  Matrix mat2(3, 4);
   ASSERT_EQ(mat2.GetRows(), 3);
 }
 
-TEST(S21MatrixTest, GetColsTest) {
-  S21Matrix mat1(2, 2);
+TYPED_TEST(S21BasicMatrixTest, GetColsTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix mat1(2, 2);
   ASSERT_EQ(mat1.GetCols(), 2);
 
-  S21Matrix mat2(3, 4);
+  Matrix mat2(3, 4);
   ASSERT_EQ(mat2.GetCols(), 4);
 }
 
-TEST(S21MatrixTest, GetMatrixTest) {
-  S21Matrix mat1(2, 2);
-  mat1.GetMatrix()[0][0] = 1;
-  mat1.GetMatrix()[0][1] = 2;
-  mat1.GetMatrix()[1][0] = 3;
-  mat1.GetMatrix()[1][1] = 4;
-  ASSERT_EQ(mat1.GetMatrix()[0][0], 1);
-  ASSERT_EQ(mat1.GetMatrix()[0][1], 2);
-  ASSERT_EQ(mat1.GetMatrix()[1][0], 3);
-  ASSERT_EQ(mat1.GetMatrix()[1][1], 4);
-
-  S21Matrix mat2(3, 3);
-  mat2.GetMatrix()[0][0] = 1;
-  mat2.GetMatrix()[0][1] = 0;
-  mat2.GetMatrix()[0][2] = 2;
-  mat2.GetMatrix()[1][0] = -1;
-  mat2.GetMatrix()[1][1] = 3;
-  mat2.GetMatrix()[1][2] = 1;
-  mat2.GetMatrix()[2][0] = 2;
-  mat2.GetMatrix()[2][1] = -1;
-  mat2.GetMatrix()[2][2] = 0;
-  ASSERT_EQ(mat2.GetMatrix()[0][0], 1);
-  ASSERT_EQ(mat2.GetMatrix()[0][1], 0);
-  ASSERT_EQ(mat2.GetMatrix()[0][2], 2);
-  ASSERT_EQ(mat2.GetMatrix()[1][0], -1);
-  ASSERT_EQ(mat2.GetMatrix()[1][1], 3);
-  ASSERT_EQ(mat2.GetMatrix()[1][2], 1);
-  ASSERT_EQ(mat2.GetMatrix()[2][0], 2);
-  ASSERT_EQ(mat2.GetMatrix()[2][1], -1);
-  ASSERT_EQ(mat2.GetMatrix()[2][2], 0);
-}
-
-TEST(S21MatrixTest, SetColsLarger) {
-  S21Matrix m(2, 3);
+TYPED_TEST(S21BasicMatrixTest, DataStrideTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix mat1(2, 2);
+  TypeParam *data = mat1.Data();
+  int stride = mat1.Stride();
+  data[0 * stride + 0] = 1;
+  data[0 * stride + 1] = 2;
+  data[1 * stride + 0] = 3;
+  data[1 * stride + 1] = 4;
+  ASSERT_EQ(mat1(0, 0), TypeParam(1));
+  ASSERT_EQ(mat1(0, 1), TypeParam(2));
+  ASSERT_EQ(mat1(1, 0), TypeParam(3));
+  ASSERT_EQ(mat1(1, 1), TypeParam(4));
+
+  Matrix mat2(3, 13);
+  ASSERT_GE(mat2.Stride(), mat2.GetCols());
+  ASSERT_EQ(mat2.Stride() * sizeof(TypeParam) % 64, 0u);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(mat2.Data()) % 64, 0u);
+  mat2.Data()[2 * mat2.Stride() + 12] = -1;
+  ASSERT_EQ(mat2(2, 12), TypeParam(-1));
+  ASSERT_EQ(mat2(2, 11), TypeParam(0));
+}
+
+TYPED_TEST(S21BasicMatrixTest, SetColsLarger) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
   m.SetValue(0, 0, 1);
   m.SetValue(0, 1, 2);
   m.SetValue(0, 2, 3);
@@ -213,18 +389,19 @@ TEST(S21MatrixTest, SetColsLarger) {
 
   EXPECT_EQ(m.GetRows(), 2);
   EXPECT_EQ(m.GetCols(), 4);
-  EXPECT_EQ(m.GetValue(0, 0), 1);
-  EXPECT_EQ(m.GetValue(0, 1), 2);
-  EXPECT_EQ(m.GetValue(0, 2), 3);
-  EXPECT_EQ(m.GetValue(0, 3), 0);
-  EXPECT_EQ(m.GetValue(1, 0), 4);
-  EXPECT_EQ(m.GetValue(1, 1), 5);
-  EXPECT_EQ(m.GetValue(1, 2), 6);
-  EXPECT_EQ(m.GetValue(1, 3), 0);
-}
-
-TEST(S21MatrixTest, SetColsSmaller) {
-  S21Matrix m(2, 3);
+  EXPECT_EQ(m.GetValue(0, 0), TypeParam(1));
+  EXPECT_EQ(m.GetValue(0, 1), TypeParam(2));
+  EXPECT_EQ(m.GetValue(0, 2), TypeParam(3));
+  EXPECT_EQ(m.GetValue(0, 3), TypeParam(0));
+  EXPECT_EQ(m.GetValue(1, 0), TypeParam(4));
+  EXPECT_EQ(m.GetValue(1, 1), TypeParam(5));
+  EXPECT_EQ(m.GetValue(1, 2), TypeParam(6));
+  EXPECT_EQ(m.GetValue(1, 3), TypeParam(0));
+}
+
+TYPED_TEST(S21BasicMatrixTest, SetColsSmaller) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
   m.SetValue(0, 0, 1);
   m.SetValue(0, 1, 2);
   m.SetValue(0, 2, 3);
@@ -236,59 +413,428 @@ TEST(S21MatrixTest, SetColsSmaller) {
 
   EXPECT_EQ(m.GetRows(), 2);
   EXPECT_EQ(m.GetCols(), 2);
-  EXPECT_EQ(m.GetValue(0, 0), 1);
-  EXPECT_EQ(m.GetValue(0, 1), 2);
-  EXPECT_EQ(m.GetValue(1, 0), 4);
-  EXPECT_EQ(m.GetValue(1, 1), 5);
+  EXPECT_EQ(m.GetValue(0, 0), TypeParam(1));
+  EXPECT_EQ(m.GetValue(0, 1), TypeParam(2));
+  EXPECT_EQ(m.GetValue(1, 0), TypeParam(4));
+  EXPECT_EQ(m.GetValue(1, 1), TypeParam(5));
 }
 
-TEST(S21MatrixTest, MulMatrixThrowsException) {
-  S21Matrix m1(2, 3);
-  S21Matrix m2(4, 6);
+TYPED_TEST(S21BasicMatrixTest, MulMatrixThrowsException) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m1(2, 3);
+  Matrix m2(4, 6);
 
   ASSERT_ANY_THROW(m1.MulMatrix(m2));
 }
 
-TEST(Actions, Transpose) {
-  auto test1 = S21Matrix(2, 2);
+TYPED_TEST(S21BasicMatrixTest, MulMatrixNonSquareShapes) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  const int shapes[][3] = {{2, 3, 4},    {1, 300, 1},  {300, 1, 300},
+                           {301, 7, 5},  {5, 7, 301},  {130, 259, 97},
+                           {97, 513, 33}, {64, 64, 64}, {33, 2100, 9}};
+  for (const auto &shape : shapes) {
+    Matrix a = this->Pattern(shape[0], shape[1], 1);
+    Matrix b = this->Pattern(shape[1], shape[2], 2);
+    Matrix expected = NaiveProduct(a, b);
+    a.MulMatrix(b);
+    ASSERT_EQ(a.GetRows(), shape[0]);
+    ASSERT_EQ(a.GetCols(), shape[2]);
+    ASSERT_TRUE(a == expected);
+  }
+}
+
+TEST(S21MatrixTest, ViewsSliceWithoutCopying) {
+  S21Matrix m = FillPattern(6, 5, 3);
+  s21::ConstView block = m.View().Block(1, 2, 4, 3);
+  EXPECT_EQ(block.Data(), &m(1, 2));
+  EXPECT_EQ(block(3, 2), m(4, 4));
+  EXPECT_EQ(m.View().Row(2)(0, 4), m(2, 4));
+  EXPECT_EQ(m.View().Col(3)(5, 0), m(5, 3));
+  EXPECT_EQ(block.Transposed()(2, 3), m(4, 4));
+  EXPECT_THROW(m.View().Block(3, 0, 4, 1), std::out_of_range);
+  EXPECT_THROW(block(4, 0), std::out_of_range);
+
+  EXPECT_TRUE(S21Matrix(m.View().Transposed()) == m.Transpose());
+  EXPECT_TRUE(S21Matrix(block).EqMatrix(block));
+  EXPECT_FALSE(m.EqMatrix(block));
+
+  // Strided operands: a block of m plus the transpose of another matrix.
+  S21Matrix sum(block);
+  S21Matrix t = FillPattern(3, 4, 5);
+  sum.SumMatrix(t.View().Transposed());
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 3; j++) EXPECT_EQ(sum(i, j), m(i + 1, j + 2) + t(j, i));
+  }
+  sum.SubMatrix(t.View().Transposed());
+  EXPECT_TRUE(sum.EqMatrix(block));
+  EXPECT_THROW(sum.SumMatrix(t.View()), std::runtime_error);
+
+  // Writes through a view land in the viewed matrix.
+  s21::MutableView column = m.View().Col(0);
+  s21::Scale(column, 0);
+  for (int i = 0; i < 6; i++) EXPECT_EQ(m(i, 0), 0);
+  EXPECT_NE(m(0, 1), 0);
+}
+
+TEST(S21MatrixTest, GemmIntoSubBlock) {
+  S21Matrix a = FillPattern(70, 90, 1);
+  S21Matrix b = FillPattern(90, 50, 2);
+  S21Matrix expected = NaiveProduct(a, b);
+  S21Matrix big(100, 80);
+  s21::Gemm(1, a.View(), b.View(), 0, big.View().Block(10, 20, 70, 50));
+  EXPECT_TRUE(S21Matrix(big.View().Block(10, 20, 70, 50)) == expected);
+  EXPECT_EQ(big(9, 20), 0);
+  EXPECT_EQ(big(10, 19), 0);
+  EXPECT_EQ(big(80, 69), 0);
+  EXPECT_EQ(big(79, 70), 0);
+
+  // Transposed operands and a transposed destination.
+  S21Matrix at = a.Transpose();
+  S21Matrix bt = b.Transpose();
+  S21Matrix c(50, 70);
+  s21::Gemm(1, at.View().Transposed(), bt.View().Transposed(), 0,
+            c.View().Transposed());
+  EXPECT_TRUE(c == expected.Transpose());
+
+  // A product of small slices takes the direct path.
+  S21Matrix d = a;
+  d.MulMatrix(b.View().Block(0, 0, 90, 3));
+  EXPECT_TRUE(d == S21Matrix(expected.View().Block(0, 0, 70, 3)));
+  EXPECT_THROW(d.MulMatrix(b.View().Row(0)), std::runtime_error);
+}
+
+TEST(S21MatrixTest, LazyTransposedProducts) {
+  S21Matrix a = FillPattern(60, 45, 1);
+  S21Matrix b = FillPattern(60, 37, 2);
+  S21Matrix c = FillPattern(50, 37, 3);
+  EXPECT_TRUE(a.Transposed() * b == a.Transpose() * b);
+  EXPECT_TRUE(b * c.Transposed() == b * c.Transpose());
+  S21Matrix d = FillPattern(20, 50, 4);
+  EXPECT_TRUE(c.Transposed() * d.Transposed() == c.Transpose() * d.Transpose());
+  EXPECT_EQ(a.Transposed().GetRows(), 45);
+  EXPECT_TRUE(S21Matrix(a.Transposed().View()) == a.Transpose());
+
+  // A A^T in place, and the result on the borrowed matrix's resource.
+  S21Matrix gram = a;
+  gram *= a.Transposed();
+  EXPECT_TRUE(gram == a * a.Transpose());
+  std::pmr::monotonic_buffer_resource pool;
+  S21Matrix pooled(a, &pool);
+  EXPECT_EQ((pooled.Transposed() * b).GetResource(), &pool);
+
+  EXPECT_THROW(a.Transposed() * c, std::runtime_error);
+  EXPECT_THROW(a * c.Transposed(), std::runtime_error);
+  S21Matrix empty;
+  EXPECT_THROW(empty.Transposed() * a, std::runtime_error);
+  EXPECT_THROW(a * empty.Transposed(), std::runtime_error);
+}
+
+TEST(S21LuFactorizationTest, SolvesManyRightHandSides) {
+  // Diagonally dominant, with rows that need pivoting in the first panel.
+  S21Matrix a = FillPattern(150, 150, 1);
+  for (int i = 0; i < 150; i++) a(i, i) += i < 10 ? -1e-3 : 40;
+  a(0, 0) = 0;
+  S21Matrix b = FillPattern(150, 7, 2);
+  S21LuFactorization lu(a);
+  EXPECT_EQ(lu.Size(), 150);
+  EXPECT_FALSE(lu.IsSingular());
+  S21Matrix x = lu.Solve(b);
+  EXPECT_TRUE((a * x).EqMatrix(b));
+  S21Matrix in_place = b;
+  lu.SolveInPlace(in_place);
+  EXPECT_TRUE(in_place == x);
+  std::vector<double> column(150);
+  for (int i = 0; i < 150; i++) column[i] = b(i, 3);
+  std::vector<double> y = lu.Solve(column);
+  for (int i = 0; i < 150; i++) EXPECT_NEAR(y[i], x(i, 3), 1e-12);
+  EXPECT_NEAR(lu.Determinant() / a.Determinant(), 1, 1e-12);
+  S21Matrix identity(150, 150);
+  for (int i = 0; i < 150; i++) identity(i, i) = 1;
+  EXPECT_TRUE((a * lu.Inverse()).EqMatrix(identity));
+  EXPECT_TRUE(lu.Inverse().EqMatrix(a.InverseMatrix()));
+  EXPECT_NE(lu.Pivots()[0], 0);
+  EXPECT_EQ(lu.Factors().GetRows(), 150);
+
+  S21ComplexMatrix c(2, 2);
+  c(0, 1) = {0, 2};
+  c(1, 0) = {1, 0};
+  S21ComplexLuFactorization complex_lu(c);
+  EXPECT_EQ(complex_lu.Determinant(), std::complex<double>(0, -2.0));
+  S21FloatMatrix f(1, 1);
+  f(0, 0) = 4.0f;
+  EXPECT_EQ(S21FloatLuFactorization(f).Solve(std::vector<float>{2.0f})[0],
+            0.5f);
+
+  S21Matrix singular = FillPattern(6, 6, 1);
+  for (int j = 0; j < 6; j++) singular(5, j) = singular(0, j) + singular(1, j);
+  S21LuFactorization singular_lu(singular);
+  EXPECT_TRUE(singular_lu.IsSingular());
+  EXPECT_THROW(singular_lu.Solve(FillPattern(6, 1, 1)), std::logic_error);
+  EXPECT_THROW(singular_lu.Inverse(), std::logic_error);
+  EXPECT_EQ(singular_lu.Determinant(), 0.0);
+  // The last pivot here is rounding noise (6.66e-16), not an exact zero.
+  S21Matrix nine(3, 3);
+  for (int i = 0; i < 9; i++) nine(i / 3, i % 3) = i + 1;
+  S21LuFactorization nine_lu(nine);
+  EXPECT_TRUE(nine_lu.IsSingular());
+  EXPECT_EQ(nine_lu.Determinant(), 0.0);
+  EXPECT_EQ(nine_lu.Determinant(), nine.Determinant());
+  EXPECT_THROW(lu.Solve(FillPattern(149, 1, 1)), std::runtime_error);
+  EXPECT_THROW(lu.Solve(std::vector<double>(3)), std::runtime_error);
+  EXPECT_THROW(S21LuFactorization(FillPattern(3, 4, 1)),
+               std::invalid_argument);
+  EXPECT_THROW(S21LuFactorization{S21Matrix()}, std::runtime_error);
+}
+
+TEST(S21CholeskyFactorizationTest, SolvesSymmetricPositiveDefinite) {
+  // B * B^T + n * I is positive definite; 150 spans three panels.
+  S21Matrix b = FillPattern(150, 150, 2);
+  S21Matrix a = b * b.Transposed();
+  for (int i = 0; i < 150; i++) a(i, i) += 150;
+  S21CholeskyFactorization cholesky(a);
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  EXPECT_EQ(cholesky.NonPositivePivot(), -1);
+  const S21Matrix &l = cholesky.Factor();
+  EXPECT_EQ(l(0, 1), 0);
+  EXPECT_TRUE((l * l.Transposed()).EqMatrix(a));
+
+  S21Matrix rhs = FillPattern(150, 7, 3);
+  EXPECT_TRUE((a * cholesky.Solve(rhs)).EqMatrix(rhs));
+  std::vector<double> x = cholesky.Solve(std::vector<double>(150, 1));
+  for (int i = 0; i < 150; i++) {
+    double row = 0;
+    for (int j = 0; j < 150; j++) row += a(i, j) * x[j];
+    EXPECT_NEAR(row, 1, 1e-9);
+  }
+  int sign = 0;
+  EXPECT_NEAR(cholesky.LogDeterminant(), a.LogDeterminant(sign), 1e-8);
+  EXPECT_EQ(sign, 1);
+  EXPECT_TRUE(cholesky.Inverse().EqMatrix(a.InverseMatrix()));
+
+  // Only the lower triangle is read.
+  S21Matrix lower = a;
+  for (int i = 0; i < 150; i++) {
+    for (int j = i + 1; j < 150; j++) lower(i, j) = -1e300;
+  }
+  EXPECT_TRUE(S21CholeskyFactorization(lower).Factor().EqMatrix(l));
+
+  S21FloatMatrix f(2, 2);
+  f(0, 0) = 4.0f;
+  f(1, 0) = 2.0f;
+  f(1, 1) = 5.0f;
+  S21FloatCholeskyFactorization float_cholesky(f);
+  EXPECT_EQ(float_cholesky.Factor()(1, 1), 2.0f);
+  EXPECT_EQ(float_cholesky.Solve(std::vector<float>{4.0f, 2.0f})[0], 1.0f);
+
+  // Reported, not thrown, until the factor is used.
+  a(100, 100) = -1.0;
+  S21CholeskyFactorization indefinite(a);
+  EXPECT_FALSE(indefinite.IsPositiveDefinite());
+  EXPECT_EQ(indefinite.NonPositivePivot(), 100);
+  EXPECT_THROW(indefinite.Solve(rhs), std::logic_error);
+  EXPECT_THROW(indefinite.LogDeterminant(), std::logic_error);
+  EXPECT_THROW(indefinite.Inverse(), std::logic_error);
+  EXPECT_THROW(cholesky.Solve(std::vector<double>(3)), std::runtime_error);
+  EXPECT_THROW(S21CholeskyFactorization(FillPattern(3, 4, 1)),
+               std::invalid_argument);
+}
+
+TEST(S21QrFactorizationTest, SolvesLeastSquares) {
+  // 300 x 70 spans a full panel, split down to its leaves, and a partial
+  // one.
+  S21Matrix a = FillPattern(300, 70, 4);
+  for (int j = 0; j < 70; j++) a(j, j) += 20;
+  S21QrFactorization qr(a);
+  EXPECT_EQ(qr.GetRows(), 300);
+  EXPECT_EQ(qr.GetCols(), 70);
+  EXPECT_FALSE(qr.IsRankDeficient());
+  S21Matrix q = qr.ThinQ();
+  S21Matrix r = qr.R();
+  EXPECT_EQ(r(69, 0), 0);
+  EXPECT_TRUE((q * r).EqMatrix(a));
+  S21Matrix identity(70, 70);
+  for (int i = 0; i < 70; i++) identity(i, i) = 1;
+  EXPECT_TRUE((q.Transposed() * q).EqMatrix(identity));
+  // Squares of these overflow and underflow; R scales with A all the same.
+  for (double magnitude : {1e200, 1e-200}) {
+    S21QrFactorization scaled(a * magnitude);
+    EXPECT_FALSE(scaled.IsRankDeficient()) << magnitude;
+    EXPECT_TRUE((scaled.R() * (1 / magnitude)).EqMatrix(r)) << magnitude;
+  }
+
+  // The residual of a least-squares solution is orthogonal to A's columns.
+  S21Matrix b = FillPattern(300, 3, 5);
+  S21Matrix x = qr.Solve(b);
+  EXPECT_EQ(x.GetRows(), 70);
+  S21Matrix residual = b - a * x;
+  EXPECT_TRUE((a.Transposed() * residual).EqMatrix(S21Matrix(70, 3)));
+  // A consistent system is solved exactly.
+  std::vector<double> exact(70);
+  for (int j = 0; j < 70; j++) exact[j] = j % 5 - 2;
+  std::vector<double> rhs(300);
+  for (int i = 0; i < 300; i++) {
+    for (int j = 0; j < 70; j++) rhs[i] += a(i, j) * exact[j];
+  }
+  std::vector<double> solution = qr.Solve(rhs);
+  ASSERT_EQ(solution.size(), 70u);
+  for (int j = 0; j < 70; j++) EXPECT_NEAR(solution[j], exact[j], 1e-9);
+
+  S21FloatMatrix f(3, 1);
+  f(0, 0) = 1.0f;
+  f(1, 0) = 2.0f;
+  f(2, 0) = 2.0f;
+  S21FloatQrFactorization float_qr(f);
+  EXPECT_FLOAT_EQ(std::abs(float_qr.R()(0, 0)), 3.0f);
+  EXPECT_FLOAT_EQ(float_qr.Solve(std::vector<float>{3.0f, 3.0f, 3.0f})[0],
+                  5.0f / 3.0f);
+
+  S21Matrix deficient = FillPattern(10, 3, 1);
+  for (int i = 0; i < 10; i++) deficient(i, 2) = 2 * deficient(i, 0);
+  S21QrFactorization deficient_qr(deficient);
+  EXPECT_TRUE(deficient_qr.IsRankDeficient());
+  EXPECT_THROW(deficient_qr.Solve(FillPattern(10, 1, 1)), std::logic_error);
+  EXPECT_THROW(qr.Solve(FillPattern(70, 1, 1)), std::runtime_error);
+  EXPECT_THROW(S21QrFactorization(FillPattern(3, 4, 1)),
+               std::invalid_argument);
+  EXPECT_THROW(S21QrFactorization{S21Matrix()}, std::runtime_error);
+}
+
+TEST(S21MatrixTest, StrassenMatchesClassic) {
+  // Odd sizes recurse three levels at this cutoff and peel at each one.
+  S21Matrix a = FillPattern(101, 93, 1);
+  S21Matrix b = FillPattern(93, 77, 2);
+  S21Matrix c = FillPattern(101, 77, 3);
+  S21Matrix expected = c;
+  s21::Gemm(0.5, a.View(), b.View(), -2.0, expected.View());
+  S21Matrix bt = b.Transpose();
+  S21Matrix fast = c;
+  s21::SetStrassen(true, 16);
+  EXPECT_TRUE(s21::StrassenEnabled());
+  s21::Gemm(0.5, a.View(), bt.View().Transposed(), -2.0, fast.View());
+  S21Matrix product = a * b;
+  S21IntMatrix ints(40, 40);
+  for (int i = 0; i < 40; i++) {
+    for (int j = 0; j < 40; j++) ints(i, j) = (i * 7 + j * 3) % 11 - 5;
+  }
+  S21IntMatrix int_product = ints * ints;
+  s21::SetStrassen(false);
+  EXPECT_FALSE(s21::StrassenEnabled());
+
+  for (int i = 0; i < 101; i++) {
+    for (int j = 0; j < 77; j++) EXPECT_NEAR(fast(i, j), expected(i, j), 1e-9);
+  }
+  EXPECT_TRUE(product.EqMatrix(NaiveProduct(a, b)));
+  EXPECT_TRUE(int_product == ints * ints);
+}
+
+TEST(S21MatrixTest, KernelsAgreeAcrossIsaLevels) {
+  const s21::Isa levels[] = {s21::Isa::kScalar, s21::Isa::kSse2,
+                             s21::Isa::kAvx2, s21::Isa::kAvx512};
+  const s21::Isa detected = s21::DetectIsa();
+  S21Matrix a = FillPattern(37, 45, 3);
+  S21Matrix b = FillPattern(45, 29, 4);
+  S21Matrix c = FillPattern(37, 45, 5);
+  S21Matrix product = NaiveProduct(a, b);
+  for (s21::Isa isa : levels) {
+    if (!s21::SetIsa(isa)) continue;
+    S21Matrix p(a);
+    p.MulMatrix(b);
+    EXPECT_TRUE(p == product);
+    S21Matrix sum(a);
+    sum.SumMatrix(c);
+    sum.SubMatrix(c);
+    sum.MulNumber(-3);
+    for (int i = 0; i < a.GetRows(); i++) {
+      for (int j = 0; j < a.GetCols(); j++) {
+        EXPECT_DOUBLE_EQ(sum(i, j), -3 * a(i, j));
+      }
+    }
+  }
+  s21::SetIsa(detected);
+  EXPECT_EQ(s21::ActiveKernels().isa, detected);
+}
+
+TEST(S21MatrixTest, ThreadedKernelsMatchSingleThreaded) {
+  const int threads = s21::ThreadCount();
+  S21Matrix a = FillPattern(300, 410, 1);
+  S21Matrix b = FillPattern(410, 170, 2);
+  S21Matrix c = FillPattern(300, 410, 3);
+  s21::SetThreadCount(1);
+  S21Matrix product = a * b;
+  S21Matrix sum = a + c;
+  S21Matrix transposed = a.Transpose();
+  s21::SetThreadCount(4);
+  s21::SetThreadPinning(true);
+  EXPECT_EQ(s21::ThreadCount(), 4);
+  EXPECT_TRUE(a * b == product);
+  EXPECT_TRUE(a + c == sum);
+  EXPECT_TRUE(a.Transpose() == transposed);
+  S21Matrix wide = FillPattern(20, 200, 4) * FillPattern(200, 3000, 5);
+  s21::SetThreadPinning(false);
+  s21::SetThreadCount(1);
+  EXPECT_TRUE(wide == FillPattern(20, 200, 4) * FillPattern(200, 3000, 5));
+  s21::SetThreadCount(threads);
+}
+
+TEST(S21MatrixTest, ThreadPoolCoversRangeAndRethrows) {
+  s21::ThreadPool pool(3);
+  std::vector<int> hits(1000, 0);
+  pool.ParallelFor(1000, 10, [&](long begin, long end) {
+    pool.ParallelFor(end - begin, 1, [&](long b, long e) {
+      for (long i = begin + b; i < begin + e; i++) hits[i]++;
+    });
+  });
+  for (int h : hits) EXPECT_EQ(h, 1);
+  EXPECT_THROW(pool.ParallelFor(100, 1,
+                                [](long begin, long) {
+                                  if (begin > 50) throw std::runtime_error("");
+                                }),
+               std::runtime_error);
+}
+
+TYPED_TEST(S21BasicMatrixTest, Transpose) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  auto test1 = Matrix(2, 2);
   test1(0, 0) = 3;
   test1(0, 1) = 1;
   test1(1, 0) = 20;
   test1(1, 1) = -2;
   test1 = test1.Transpose();
-  EXPECT_EQ(test1(0, 0), 3);
-  EXPECT_EQ(test1(0, 1), 20);
-  EXPECT_EQ(test1(1, 0), 1);
-  EXPECT_EQ(test1(1, 1), -2);
+  EXPECT_EQ(test1(0, 0), TypeParam(3));
+  EXPECT_EQ(test1(0, 1), TypeParam(20));
+  EXPECT_EQ(test1(1, 0), TypeParam(1));
+  EXPECT_EQ(test1(1, 1), TypeParam(-2));
 }
 
-TEST(Actions, Determinant) {
-  auto test1 = S21Matrix(2, 2);
+TYPED_TEST(S21BasicMatrixTest, Determinant) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  auto test1 = Matrix(2, 2);
   test1(0, 0) = 73;
   test1(0, 1) = 16;
   test1(1, 0) = 0;
   test1(1, 1) = -4;
-  EXPECT_EQ(test1.Determinant(), -292);
+  EXPECT_EQ(test1.Determinant(), TypeParam(-292));
   test1(0, 0) = 3;
   test1(0, 1) = 5;
   test1(1, 0) = -8;
   test1(1, 1) = -4;
-  EXPECT_EQ(test1.Determinant(), 28);
+  EXPECT_EQ(test1.Determinant(), TypeParam(28));
   test1(0, 0) = 2;
   test1(0, 1) = -5;
   test1(1, 0) = 1;
   test1(1, 1) = -2;
-  EXPECT_EQ(test1.Determinant(), 1);
+  EXPECT_EQ(test1.Determinant(), TypeParam(1));
   test1(0, 0) = 13;
   test1(0, 1) = 5;
   test1(1, 0) = 13;
   test1(1, 1) = 0;
-  EXPECT_EQ(test1.Determinant(), -65);
+  EXPECT_EQ(test1.Determinant(), TypeParam(-65));
 }
 
-TEST(Actions, Determinant_5x5) {
+TYPED_TEST(S21BasicMatrixTest, Determinant_5x5) {
+  using Matrix = S21BasicMatrix<TypeParam>;
   int size = 5;
-  S21Matrix m(size, size);
+  Matrix m(size, size);
 
   m(0, 1) = 6;
   m(0, 2) = -2;
@@ -307,12 +853,70 @@ TEST(Actions, Determinant_5x5) {
   m(4, 2) = 3;
   m(4, 4) = -2;
 
-  double res = m.Determinant();
-  ASSERT_NEAR(res, 2480, 1e-6);
-}
-
-TEST(Actions, Determinant3x3) {
-  auto test1 = S21Matrix(3, 3);
+  ASSERT_TRUE(this->Near(m.Determinant(), TypeParam(2480)));
+}
+
+TYPED_TEST(S21BasicMatrixTest, DeterminantLarge) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  // Unit lower times upper triangular with rows reversed: the determinant is
+  // the product of the diagonal of U times the sign of the reversal.
+  const int n = 150;
+  Matrix l(n, n), u(n, n);
+  double expected = 1.0;
+  for (int i = 0; i < n; i++) {
+    l(i, i) = 1;
+    u(i, i) = 1.0 + (i % 3) * 0.5;
+    expected *= 1.0 + (i % 3) * 0.5;
+    for (int j = 0; j < i; j++) l(i, j) = ((i + 2 * j) % 5 - 2) * 0.1;
+    for (int j = i + 1; j < n; j++) u(i, j) = ((3 * i + j) % 7 - 3) * 0.1;
+  }
+  Matrix a = l * u;
+  Matrix reversed(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) reversed(i, j) = a(n - 1 - i, j);
+  }
+  if ((n / 2) % 2 != 0) expected = -expected;
+  if constexpr (std::is_integral_v<TypeParam>) {
+    // The tenths truncate to zero, leaving 2^50 on the diagonal.
+    EXPECT_THROW(reversed.Determinant(), std::overflow_error);
+  } else {
+    // Rounding L * U to float moves the determinant by about a percent.
+    const double tolerance = std::is_same_v<TypeParam, float> ? 5e-2 : 1e-9;
+    TypeParam ratio = reversed.Determinant() / TypeParam(expected);
+    EXPECT_NEAR(std::abs(ratio - TypeParam(1)), 0.0, tolerance);
+  }
+}
+
+TYPED_TEST(S21BasicMatrixTest, DeterminantSingular) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m = this->Pattern(6, 6, 7);
+  for (int j = 0; j < 6; j++) m(4, j) = m(1, j);
+  EXPECT_EQ(m.Determinant(), TypeParam(0));
+  int sign = 1;
+  EXPECT_EQ(m.LogDeterminant(sign), -HUGE_VAL);
+  EXPECT_EQ(sign, 0);
+}
+
+TYPED_TEST(S21BasicMatrixTest, LogDeterminantAvoidsOverflow) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  const int n = 100;
+  Matrix m(n, n);
+  for (int i = 0; i < n; i++) m(i, i) = (i == 7) ? -10000 : 10000;
+  int sign = 0;
+  EXPECT_NEAR(m.LogDeterminant(sign), n * log(1e4), 1e-3);
+  if constexpr (!s21::IsComplex<TypeParam>::value) {
+    EXPECT_EQ(sign, -1);
+  }
+  if constexpr (std::is_integral_v<TypeParam>) {
+    EXPECT_THROW(m.Determinant(), std::overflow_error);
+  } else {
+    EXPECT_TRUE(std::isinf(std::abs(m.Determinant())));
+  }
+}
+
+TYPED_TEST(S21BasicMatrixTest, Determinant3x3) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  auto test1 = Matrix(3, 3);
   test1(0, 0) = 5;
   test1(0, 1) = 2;
   test1(0, 2) = 1;
@@ -322,28 +926,34 @@ TEST(Actions, Determinant3x3) {
   test1(2, 0) = 3;
   test1(2, 1) = 4;
   test1(2, 2) = 5;
-  EXPECT_EQ(test1.Determinant(), 26);
+  EXPECT_EQ(test1.Determinant(), TypeParam(26));
 }
 
-TEST(Actions, Inverse) {
-  auto test1 = S21Matrix(2, 2);
+TYPED_TEST(S21BasicMatrixTest, Inverse) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  auto test1 = Matrix(2, 2);
   test1(0, 0) = 3;
   test1(0, 1) = 1;
   test1(1, 0) = 2;
   test1(1, 1) = -2;
-  test1 = test1.InverseMatrix();
-  EXPECT_EQ(test1(0, 0), 0.25);
-  EXPECT_EQ(test1(0, 1), 0.125);
-  EXPECT_EQ(test1(1, 0), 0.25);
-  EXPECT_EQ(test1(1, 1), -0.375);
-}
-
-TEST(Actions, CalcComplements3x3) {
+  if constexpr (std::is_integral_v<TypeParam>) {
+    EXPECT_THROW(test1.InverseMatrix(), std::logic_error);
+  } else {
+    test1 = test1.InverseMatrix();
+    EXPECT_EQ(test1(0, 0), TypeParam(0.25));
+    EXPECT_EQ(test1(0, 1), TypeParam(0.125));
+    EXPECT_EQ(test1(1, 0), TypeParam(0.25));
+    EXPECT_EQ(test1(1, 1), TypeParam(-0.375));
+  }
+}
+
+TYPED_TEST(S21BasicMatrixTest, CalcComplements3x3) {
+  using Matrix = S21BasicMatrix<TypeParam>;
   const int rows = 3;
   const int cols = 3;
 
-  S21Matrix given(rows, cols);
-  S21Matrix expected(rows, cols);
+  Matrix given(rows, cols);
+  Matrix expected(rows, cols);
 
   expected(0, 0) = 0;
   expected(0, 1) = 10;
@@ -365,54 +975,31 @@ TEST(Actions, CalcComplements3x3) {
   given(2, 1) = 2;
   given(2, 2) = 1;
 
-  S21Matrix res = given.CalcComplements();
+  Matrix res = given.CalcComplements();
   ASSERT_TRUE(res == expected);
 }
 
-TEST(Actions, CalcComplementsTest) {
-  S21Matrix matrix1(1, 1);
-  matrix1(0, 0) = 5;
-  S21Matrix expected1(1, 1);
-  expected1(0, 0) = 1;
-  EXPECT_EQ(matrix1.CalcComplements(), expected1);
-
-  S21Matrix matrix2(2, 2);
-  matrix2(0, 0) = 1;
-  matrix2(0, 1) = 2;
-  matrix2(1, 0) = 3;
-  matrix2(1, 1) = 4;
-  S21Matrix expected2(2, 2);
-  expected2(0, 0) = 4;
-  expected2(0, 1) = -3;
-  expected2(1, 0) = -2;
-  expected2(1, 1) = 1;
-
-  EXPECT_EQ(matrix2.CalcComplements(), expected2);
-
-  S21Matrix matrix3(2, 3);
-  ASSERT_ANY_THROW(matrix3.CalcComplements());
-}
-
-TEST(S21MatrixTest, CalcComplementsTest) {
-  S21Matrix matrix1(1, 1);
+TYPED_TEST(S21BasicMatrixTest, CalcComplementsTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix matrix1(1, 1);
   matrix1(0, 0) = 5;
-  S21Matrix expected1(1, 1);
+  Matrix expected1(1, 1);
   expected1(0, 0) = 1;
   EXPECT_EQ(matrix1.CalcComplements(), expected1);
 
-  S21Matrix matrix2(2, 2);
+  Matrix matrix2(2, 2);
   matrix2(0, 0) = 1;
   matrix2(0, 1) = 2;
   matrix2(1, 0) = 3;
   matrix2(1, 1) = 4;
-  S21Matrix expected2(2, 2);
+  Matrix expected2(2, 2);
   expected2(0, 0) = 4;
   expected2(0, 1) = -3;
   expected2(1, 0) = -2;
   expected2(1, 1) = 1;
   EXPECT_EQ(matrix2.CalcComplements(), expected2);
 
-  S21Matrix matrix3(3, 3);
+  Matrix matrix3(3, 3);
   matrix3(0, 0) = 6;
   matrix3(0, 1) = 1;
   matrix3(0, 2) = 1;
@@ -422,7 +1009,7 @@ TEST(S21MatrixTest, CalcComplementsTest) {
   matrix3(2, 0) = 2;
   matrix3(2, 1) = 8;
   matrix3(2, 2) = 7;
-  S21Matrix expected3(3, 3);
+  Matrix expected3(3, 3);
   expected3(0, 0) = -54;
   expected3(0, 1) = -18;
   expected3(0, 2) = 36;
@@ -433,36 +1020,87 @@ TEST(S21MatrixTest, CalcComplementsTest) {
   expected3(2, 1) = -26;
   expected3(2, 2) = -16;
   EXPECT_EQ(matrix3.CalcComplements(), expected3);
-}
 
-TEST(Actions, Complements) {
-  auto test1 = S21Matrix(2, 2);
+  Matrix matrix4(2, 3);
+  ASSERT_ANY_THROW(matrix4.CalcComplements());
+}
+
+template <class T>
+static S21BasicMatrix<T> CofactorsByMinors(const S21BasicMatrix<T> &m) {
+  int n = m.GetRows();
+  S21BasicMatrix<T> result(n, n), minor(n - 1, n - 1);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      m.Minor(m, minor, i, j, n);
+      result(i, j) = (i + j) % 2 ? -minor.Determinant() : minor.Determinant();
+    }
+  }
+  return result;
+}
+
+TYPED_TEST(S21BasicMatrixTest, ComplementsNonsingular) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m = this->Pattern(7, 7, 11);
+  for (int i = 0; i < 7; i++) m(i, i) += 2;
+  EXPECT_TRUE(this->Near(m.CalcComplements(), CofactorsByMinors(m)));
+}
+
+TYPED_TEST(S21BasicMatrixTest, ComplementsRankDeficient) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m = this->Pattern(6, 6, 2);
+  for (int i = 0; i < 6; i++) m(i, i) += 2;
+  for (int j = 0; j < 6; j++) m(4, j) = m(1, j) - TypeParam(2) * m(3, j);
+  Matrix expected = CofactorsByMinors(m);
+  EXPECT_TRUE(this->Near(m.CalcComplements(), expected));
+  EXPECT_FALSE(expected == Matrix(6, 6));
+
+  // Rank 4: every cofactor vanishes, up to the rounding of the ones above.
+  double scale = 0;
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      scale = std::max<double>(scale, std::abs(expected(i, j)));
+    }
+  }
+  for (int j = 0; j < 6; j++) m(5, j) = m(0, j) + m(2, j);
+  EXPECT_TRUE(this->Near(m.CalcComplements(), Matrix(6, 6), scale));
+  EXPECT_TRUE(this->Near(CofactorsByMinors(m), Matrix(6, 6), scale));
+}
+
+TYPED_TEST(S21BasicMatrixTest, Complements) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  auto test1 = Matrix(2, 2);
   test1(0, 0) = 3;
   test1(0, 1) = 1;
   test1(1, 0) = 20;
   test1(1, 1) = -2;
   auto test2 = test1.CalcComplements();
-  EXPECT_EQ(test2(0, 0), -2);
-  EXPECT_EQ(test2(0, 1), -20);
-  EXPECT_EQ(test2(1, 0), -1);
-  EXPECT_EQ(test2(1, 1), 3);
+  EXPECT_EQ(test2(0, 0), TypeParam(-2));
+  EXPECT_EQ(test2(0, 1), TypeParam(-20));
+  EXPECT_EQ(test2(1, 0), TypeParam(-1));
+  EXPECT_EQ(test2(1, 1), TypeParam(3));
 }
 
-TEST(S21MatrixTest, InverseMatrixTest) {
-  S21Matrix mat1(2, 2);
+TYPED_TEST(S21BasicMatrixTest, InverseMatrixTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix mat1(2, 2);
   mat1(0, 0) = 1;
   mat1(0, 1) = 2;
   mat1(1, 0) = 3;
   mat1(1, 1) = 4;
-  S21Matrix inv_mat1 = mat1.InverseMatrix();
-  S21Matrix expected1(2, 2);
-  expected1(0, 0) = -2;
-  expected1(0, 1) = 1;
-  expected1(1, 0) = 1.5;
-  expected1(1, 1) = -0.5;
-  ASSERT_TRUE(inv_mat1 == expected1);
-
-  S21Matrix mat3(3, 3);
+  if constexpr (std::is_integral_v<TypeParam>) {
+    // The determinant is -2.
+    ASSERT_THROW(mat1.InverseMatrix(), std::logic_error);
+  } else {
+    Matrix inv_mat1 = mat1.InverseMatrix();
+    Matrix expected1(2, 2);
+    expected1(0, 0) = -2;
+    expected1(0, 1) = 1;
+    expected1(1, 0) = 1.5;
+    expected1(1, 1) = -0.5;
+    ASSERT_TRUE(inv_mat1 == expected1);
+  }
+
+  Matrix mat3(3, 3);
   mat3(0, 0) = 1;
   mat3(0, 1) = 2;
   mat3(0, 2) = 3;
@@ -475,195 +1113,251 @@ TEST(S21MatrixTest, InverseMatrixTest) {
   ASSERT_ANY_THROW(mat3.InverseMatrix());
 }
 
-TEST(S21MatrixTest, OperatorPlusEqualTest) {
-  S21Matrix mat1(2, 2);
-  mat1.GetMatrix()[0][0] = 1;
-  mat1.GetMatrix()[0][1] = 2;
-  mat1.GetMatrix()[1][0] = 3;
-  mat1.GetMatrix()[1][1] = 4;
-  S21Matrix mat2(2, 2);
-  mat2.GetMatrix()[0][0] = 2;
-  mat2.GetMatrix()[0][1] = 4;
-  mat2.GetMatrix()[1][0] = 6;
-  mat2.GetMatrix()[1][1] = 8;
+TYPED_TEST(S21BasicMatrixTest, InverseMatrixLarge) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  const int n = 203;
+  Matrix a = this->Pattern(n, n, 9);
+  for (int i = 0; i < n; i++) a(i, i) += 4;
+  if constexpr (std::is_integral_v<TypeParam>) {
+    EXPECT_THROW(a.InverseMatrix(), std::overflow_error);
+  } else {
+    const double tolerance = std::is_same_v<TypeParam, float> ? 1e-4 : 1e-10;
+    Matrix product = a * a.InverseMatrix();
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        EXPECT_NEAR(std::abs(product(i, j) - TypeParam(i == j)), 0,
+                    tolerance);
+      }
+    }
+  }
+  Matrix singular = this->Pattern(n, n, 9);
+  for (int j = 0; j < n; j++) {
+    singular(n - 1, j) = TypeParam(2) * singular(3, j);
+  }
+  EXPECT_THROW(singular.InverseMatrix(), std::logic_error);
+}
+
+TYPED_TEST(S21BasicMatrixTest, OperatorPlusEqualTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix mat1(2, 2);
+  mat1(0, 0) = 1;
+  mat1(0, 1) = 2;
+  mat1(1, 0) = 3;
+  mat1(1, 1) = 4;
+  Matrix mat2(2, 2);
+  mat2(0, 0) = 2;
+  mat2(0, 1) = 4;
+  mat2(1, 0) = 6;
+  mat2(1, 1) = 8;
   mat1 += mat2;
-  ASSERT_EQ(mat1.GetMatrix()[0][0], 3);
-  ASSERT_EQ(mat1.GetMatrix()[0][1], 6);
-  ASSERT_EQ(mat1.GetMatrix()[1][0], 9);
-  ASSERT_EQ(mat1.GetMatrix()[1][1], 12);
-
-  S21Matrix mat3(3, 3);
-  mat3.GetMatrix()[0][0] = 1;
-  mat3.GetMatrix()[0][1] = 0;
-  mat3.GetMatrix()[0][2] = 2;
-  mat3.GetMatrix()[1][0] = -1;
-  mat3.GetMatrix()[1][1] = 3;
-  mat3.GetMatrix()[1][2] = 1;
-  mat3.GetMatrix()[2][0] = 2;
-  mat3.GetMatrix()[2][1] = -1;
-  mat3.GetMatrix()[2][2] = 0;
-  S21Matrix mat4(3, 3);
-  mat4.GetMatrix()[0][0] = 1;
-  mat4.GetMatrix()[0][1] = -1;
-  mat4.GetMatrix()[0][2] = 0;
-  mat4.GetMatrix()[1][0] = 2;
-  mat4.GetMatrix()[1][1] = 1;
-  mat4.GetMatrix()[1][2] = -2;
-  mat4.GetMatrix()[2][0] = 0;
-  mat4.GetMatrix()[2][1] = -1;
-  mat4.GetMatrix()[2][2] = 1;
+  ASSERT_EQ(mat1(0, 0), TypeParam(3));
+  ASSERT_EQ(mat1(0, 1), TypeParam(6));
+  ASSERT_EQ(mat1(1, 0), TypeParam(9));
+  ASSERT_EQ(mat1(1, 1), TypeParam(12));
+
+  Matrix mat3(3, 3);
+  mat3(0, 0) = 1;
+  mat3(0, 1) = 0;
+  mat3(0, 2) = 2;
+  mat3(1, 0) = -1;
+  mat3(1, 1) = 3;
+  mat3(1, 2) = 1;
+  mat3(2, 0) = 2;
+  mat3(2, 1) = -1;
+  mat3(2, 2) = 0;
+  Matrix mat4(3, 3);
+  mat4(0, 0) = 1;
+  mat4(0, 1) = -1;
+  mat4(0, 2) = 0;
+  mat4(1, 0) = 2;
+  mat4(1, 1) = 1;
+  mat4(1, 2) = -2;
+  mat4(2, 0) = 0;
+  mat4(2, 1) = -1;
+  mat4(2, 2) = 1;
   mat3 += mat4;
-  ASSERT_EQ(mat3.GetMatrix()[0][0], 2);
-  ASSERT_EQ(mat3.GetMatrix()[0][1], -1);
-  ASSERT_EQ(mat3.GetMatrix()[0][2], 2);
-  ASSERT_EQ(mat3.GetMatrix()[1][0], 1);
-  ASSERT_EQ(mat3.GetMatrix()[1][1], 4);
-  ASSERT_EQ(mat3.GetMatrix()[1][2], -1);
-  ASSERT_EQ(mat3.GetMatrix()[2][0], 2);
-  ASSERT_EQ(mat3.GetMatrix()[2][1], -2);
-  ASSERT_EQ(mat3.GetMatrix()[2][2], 1);
-}
-
-TEST(S21MatrixTest, OperatorPlusTest) {
-  S21Matrix mat1(2, 2);
-  mat1.GetMatrix()[0][0] = 1;
-  mat1.GetMatrix()[0][1] = 2;
-  mat1.GetMatrix()[1][0] = 3;
-  mat1.GetMatrix()[1][1] = 4;
-  S21Matrix mat2(2, 2);
-  mat2.GetMatrix()[0][0] = 2;
-  mat2.GetMatrix()[0][1] = 4;
-  mat2.GetMatrix()[1][0] = 6;
-  mat2.GetMatrix()[1][1] = 8;
-  S21Matrix res = mat1 + mat2;
-  ASSERT_EQ(res.GetMatrix()[0][0], 3);
-  ASSERT_EQ(res.GetMatrix()[0][1], 6);
-  ASSERT_EQ(res.GetMatrix()[1][0], 9);
-  ASSERT_EQ(res.GetMatrix()[1][1], 12);
-
-  S21Matrix mat3(3, 3);
-  mat3.GetMatrix()[0][0] = 1;
-  mat3.GetMatrix()[0][1] = 0;
-  mat3.GetMatrix()[0][2] = 2;
-  mat3.GetMatrix()[1][0] = -1;
-  mat3.GetMatrix()[1][1] = 3;
-}
-
-TEST(S21MatrixTest, OperatorRoundBracketsTest) {
-  S21Matrix mat(2, 2);
+  ASSERT_EQ(mat3(0, 0), TypeParam(2));
+  ASSERT_EQ(mat3(0, 1), TypeParam(-1));
+  ASSERT_EQ(mat3(0, 2), TypeParam(2));
+  ASSERT_EQ(mat3(1, 0), TypeParam(1));
+  ASSERT_EQ(mat3(1, 1), TypeParam(4));
+  ASSERT_EQ(mat3(1, 2), TypeParam(-1));
+  ASSERT_EQ(mat3(2, 0), TypeParam(2));
+  ASSERT_EQ(mat3(2, 1), TypeParam(-2));
+  ASSERT_EQ(mat3(2, 2), TypeParam(1));
+}
+
+TYPED_TEST(S21BasicMatrixTest, OperatorPlusTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix mat1(2, 2);
+  mat1(0, 0) = 1;
+  mat1(0, 1) = 2;
+  mat1(1, 0) = 3;
+  mat1(1, 1) = 4;
+  Matrix mat2(2, 2);
+  mat2(0, 0) = 2;
+  mat2(0, 1) = 4;
+  mat2(1, 0) = 6;
+  mat2(1, 1) = 8;
+  Matrix res = mat1 + mat2;
+  ASSERT_EQ(res(0, 0), TypeParam(3));
+  ASSERT_EQ(res(0, 1), TypeParam(6));
+  ASSERT_EQ(res(1, 0), TypeParam(9));
+  ASSERT_EQ(res(1, 1), TypeParam(12));
+
+  Matrix mat3(3, 3);
+  mat3(0, 0) = 1;
+  mat3(0, 1) = 0;
+  mat3(0, 2) = 2;
+  mat3(1, 0) = -1;
+  mat3(1, 1) = 3;
+}
+
+TYPED_TEST(S21BasicMatrixTest, ExpressionChainEvaluatesInOnePass) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix a = this->Pattern(70, 90, 1);
+  Matrix b = this->Pattern(70, 90, 2);
+  Matrix c = this->Pattern(70, 90, 3);
+  Matrix c_before(c);
+  Matrix result = a + b - c * TypeParam(2);
+  EXPECT_TRUE(c == c_before);
+  for (int i = 0; i < 70; i++) {
+    for (int j = 0; j < 90; j++) {
+      EXPECT_EQ(result(i, j), a(i, j) + b(i, j) - TypeParam(2) * c(i, j));
+    }
+  }
+  auto lazy = TypeParam(3) * (a - this->Pattern(70, 90, 4));
+  result = lazy;
+  EXPECT_EQ(result(3, 5),
+            TypeParam(3) * (a(3, 5) - this->Pattern(70, 90, 4)(3, 5)));
+  a = a + a;
+  EXPECT_EQ(a(69, 89), TypeParam(2) * this->Pattern(70, 90, 1)(69, 89));
+  EXPECT_TRUE((a - b) * this->Pattern(90, 4, 5) ==
+              Matrix(a - b) * this->Pattern(90, 4, 5));
+  EXPECT_THROW(Matrix(a + Matrix(70, 91)), std::runtime_error);
+  EXPECT_THROW(Matrix(a + Matrix()), std::runtime_error);
+}
+
+TYPED_TEST(S21BasicMatrixTest, OperatorRoundBracketsTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix mat(2, 2);
   mat(0, 0) = 1;
   mat(0, 1) = 2;
   mat(1, 0) = 3;
   mat(1, 1) = 4;
-  ASSERT_EQ(mat(0, 0), 1);
-  ASSERT_EQ(mat(0, 1), 2);
-  ASSERT_EQ(mat(1, 0), 3);
-  ASSERT_EQ(mat(1, 1), 4);
-}
-
-TEST(S21MatrixTest, OperatorMultiply) {
-  S21Matrix matrix1(2, 2);
-  matrix1(0, 0) = 1.0;
-  matrix1(0, 1) = 2.0;
-  matrix1(1, 0) = 3.0;
-  matrix1(1, 1) = 4.0;
-
-  S21Matrix matrix2(2, 2);
-  matrix2(0, 0) = 5.0;
-  matrix2(0, 1) = 6.0;
-  matrix2(1, 0) = 7.0;
-  matrix2(1, 1) = 8.0;
-
-  S21Matrix result = matrix1 * matrix2;
-
-  EXPECT_EQ(result(0, 0), 19.0);
-  EXPECT_EQ(result(0, 1), 22.0);
-  EXPECT_EQ(result(1, 0), 43.0);
-  EXPECT_EQ(result(1, 1), 50.0);
-}
-
-TEST(S21MatrixTest, OperatorSubtract) {
-  S21Matrix matrix1(2, 2);
-  matrix1(0, 0) = 1.0;
-  matrix1(0, 1) = 2.0;
-  matrix1(1, 0) = 3.0;
-  matrix1(1, 1) = 4.0;
-
-  S21Matrix matrix2(2, 2);
-  matrix2(0, 0) = 5.0;
-  matrix2(0, 1) = 6.0;
-  matrix2(1, 0) = 7.0;
-  matrix2(1, 1) = 8.0;
-
-  S21Matrix result = matrix1 - matrix2;
-
-  EXPECT_EQ(result(0, 0), -4.0);
-  EXPECT_EQ(result(0, 1), -4.0);
-  EXPECT_EQ(result(1, 0), -4.0);
-  EXPECT_EQ(result(1, 1), -4.0);
-
-  S21Matrix matrix3(3, 2);
-  matrix3(0, 0) = 1.0;
-  matrix3(0, 1) = 2.0;
-  matrix3(1, 0) = 3.0;
-  matrix3(1, 1) = 4.0;
-  matrix3(2, 0) = 5.0;
-  matrix3(2, 1) = 6.0;
-
-  S21Matrix matrix4(3, 2);
-  matrix4(0, 0) = 7.0;
-  matrix4(0, 1) = 8.0;
-  matrix4(1, 0) = 9.0;
-  matrix4(1, 1) = 10.0;
-  matrix4(2, 0) = 11.0;
-  matrix4(2, 1) = 12.0;
-
-  S21Matrix result2 = matrix3 - matrix4;
-
-  EXPECT_EQ(result2(0, 0), -6.0);
-  EXPECT_EQ(result2(0, 1), -6.0);
-  EXPECT_EQ(result2(1, 0), -6.0);
-  EXPECT_EQ(result2(1, 1), -6.0);
-  EXPECT_EQ(result2(2, 0), -6.0);
-  EXPECT_EQ(result2(2, 1), -6.0);
-}
-
-TEST(S21MatrixTest, OperatorIndexing) {
-  S21Matrix matrix(2, 2);
-  matrix(0, 0) = 1.0;
-  matrix(0, 1) = 2.0;
-  matrix(1, 0) = 3.0;
-  matrix(1, 1) = 4.0;
-
-  EXPECT_EQ(matrix(0, 0), 1.0);
-  EXPECT_EQ(matrix(0, 1), 2.0);
-  EXPECT_EQ(matrix(1, 0), 3.0);
-  EXPECT_EQ(matrix(1, 1), 4.0);
-
-  S21Matrix matrix2(3, 3);
-  matrix2(0, 0) = 1.0;
-  matrix2(0, 1) = 2.0;
-  matrix2(0, 2) = 3.0;
-  matrix2(1, 0) = 4.0;
-  matrix2(1, 1) = 5.0;
-  matrix2(1, 2) = 6.0;
-  matrix2(2, 0) = 7.0;
-  matrix2(2, 1) = 8.0;
-  matrix2(2, 2) = 9.0;
-
-  EXPECT_EQ(matrix2(0, 0), 1.0);
-  EXPECT_EQ(matrix2(0, 1), 2.0);
-  EXPECT_EQ(matrix2(0, 2), 3.0);
-  EXPECT_EQ(matrix2(1, 0), 4.0);
-  EXPECT_EQ(matrix2(1, 1), 5.0);
-  EXPECT_EQ(matrix2(1, 2), 6.0);
-  EXPECT_EQ(matrix2(2, 0), 7.0);
-  EXPECT_EQ(matrix2(2, 1), 8.0);
-  EXPECT_EQ(matrix2(2, 2), 9.0);
-}
-
-TEST(S21MatrixTest, SetRowsLarger) {
-  S21Matrix m(2, 3);
+  ASSERT_EQ(mat(0, 0), TypeParam(1));
+  ASSERT_EQ(mat(0, 1), TypeParam(2));
+  ASSERT_EQ(mat(1, 0), TypeParam(3));
+  ASSERT_EQ(mat(1, 1), TypeParam(4));
+}
+
+TYPED_TEST(S21BasicMatrixTest, OperatorMultiply) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix matrix1(2, 2);
+  matrix1(0, 0) = 1;
+  matrix1(0, 1) = 2;
+  matrix1(1, 0) = 3;
+  matrix1(1, 1) = 4;
+
+  Matrix matrix2(2, 2);
+  matrix2(0, 0) = 5;
+  matrix2(0, 1) = 6;
+  matrix2(1, 0) = 7;
+  matrix2(1, 1) = 8;
+
+  Matrix result = matrix1 * matrix2;
+
+  EXPECT_EQ(result(0, 0), TypeParam(19));
+  EXPECT_EQ(result(0, 1), TypeParam(22));
+  EXPECT_EQ(result(1, 0), TypeParam(43));
+  EXPECT_EQ(result(1, 1), TypeParam(50));
+}
+
+TYPED_TEST(S21BasicMatrixTest, OperatorSubtract) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix matrix1(2, 2);
+  matrix1(0, 0) = 1;
+  matrix1(0, 1) = 2;
+  matrix1(1, 0) = 3;
+  matrix1(1, 1) = 4;
+
+  Matrix matrix2(2, 2);
+  matrix2(0, 0) = 5;
+  matrix2(0, 1) = 6;
+  matrix2(1, 0) = 7;
+  matrix2(1, 1) = 8;
+
+  Matrix result = matrix1 - matrix2;
+
+  EXPECT_EQ(result(0, 0), TypeParam(-4.0));
+  EXPECT_EQ(result(0, 1), TypeParam(-4.0));
+  EXPECT_EQ(result(1, 0), TypeParam(-4.0));
+  EXPECT_EQ(result(1, 1), TypeParam(-4.0));
+
+  Matrix matrix3(3, 2);
+  matrix3(0, 0) = 1;
+  matrix3(0, 1) = 2;
+  matrix3(1, 0) = 3;
+  matrix3(1, 1) = 4;
+  matrix3(2, 0) = 5;
+  matrix3(2, 1) = 6;
+
+  Matrix matrix4(3, 2);
+  matrix4(0, 0) = 7;
+  matrix4(0, 1) = 8;
+  matrix4(1, 0) = 9;
+  matrix4(1, 1) = 10;
+  matrix4(2, 0) = 11;
+  matrix4(2, 1) = 12;
+
+  Matrix result2 = matrix3 - matrix4;
+
+  EXPECT_EQ(result2(0, 0), TypeParam(-6.0));
+  EXPECT_EQ(result2(0, 1), TypeParam(-6.0));
+  EXPECT_EQ(result2(1, 0), TypeParam(-6.0));
+  EXPECT_EQ(result2(1, 1), TypeParam(-6.0));
+  EXPECT_EQ(result2(2, 0), TypeParam(-6.0));
+  EXPECT_EQ(result2(2, 1), TypeParam(-6.0));
+}
+
+TYPED_TEST(S21BasicMatrixTest, OperatorIndexing) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix matrix(2, 2);
+  matrix(0, 0) = 1;
+  matrix(0, 1) = 2;
+  matrix(1, 0) = 3;
+  matrix(1, 1) = 4;
+
+  EXPECT_EQ(matrix(0, 0), TypeParam(1));
+  EXPECT_EQ(matrix(0, 1), TypeParam(2));
+  EXPECT_EQ(matrix(1, 0), TypeParam(3));
+  EXPECT_EQ(matrix(1, 1), TypeParam(4));
+
+  Matrix matrix2(3, 3);
+  matrix2(0, 0) = 1;
+  matrix2(0, 1) = 2;
+  matrix2(0, 2) = 3;
+  matrix2(1, 0) = 4;
+  matrix2(1, 1) = 5;
+  matrix2(1, 2) = 6;
+  matrix2(2, 0) = 7;
+  matrix2(2, 1) = 8;
+  matrix2(2, 2) = 9;
+
+  EXPECT_EQ(matrix2(0, 0), TypeParam(1));
+  EXPECT_EQ(matrix2(0, 1), TypeParam(2));
+  EXPECT_EQ(matrix2(0, 2), TypeParam(3));
+  EXPECT_EQ(matrix2(1, 0), TypeParam(4));
+  EXPECT_EQ(matrix2(1, 1), TypeParam(5));
+  EXPECT_EQ(matrix2(1, 2), TypeParam(6));
+  EXPECT_EQ(matrix2(2, 0), TypeParam(7));
+  EXPECT_EQ(matrix2(2, 1), TypeParam(8));
+  EXPECT_EQ(matrix2(2, 2), TypeParam(9));
+}
+
+TYPED_TEST(S21BasicMatrixTest, SetRowsLarger) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
   m.SetValue(0, 0, 1);
   m.SetValue(0, 1, 2);
   m.SetValue(0, 2, 3);
@@ -675,22 +1369,23 @@ TEST(S21MatrixTest, SetRowsLarger) {
 
   EXPECT_EQ(m.GetRows(), 4);
   EXPECT_EQ(m.GetCols(), 3);
-  EXPECT_EQ(m.GetValue(0, 0), 1);
-  EXPECT_EQ(m.GetValue(0, 1), 2);
-  EXPECT_EQ(m.GetValue(0, 2), 3);
-  EXPECT_EQ(m.GetValue(1, 0), 4);
-  EXPECT_EQ(m.GetValue(1, 1), 5);
-  EXPECT_EQ(m.GetValue(1, 2), 6);
-  EXPECT_EQ(m.GetValue(2, 0), 0);
-  EXPECT_EQ(m.GetValue(2, 1), 0);
-  EXPECT_EQ(m.GetValue(2, 2), 0);
-  EXPECT_EQ(m.GetValue(3, 0), 0);
-  EXPECT_EQ(m.GetValue(3, 1), 0);
-  EXPECT_EQ(m.GetValue(3, 2), 0);
-}
-
-TEST(S21MatrixTest, SetRowsSmaller) {
-  S21Matrix m(2, 3);
+  EXPECT_EQ(m.GetValue(0, 0), TypeParam(1));
+  EXPECT_EQ(m.GetValue(0, 1), TypeParam(2));
+  EXPECT_EQ(m.GetValue(0, 2), TypeParam(3));
+  EXPECT_EQ(m.GetValue(1, 0), TypeParam(4));
+  EXPECT_EQ(m.GetValue(1, 1), TypeParam(5));
+  EXPECT_EQ(m.GetValue(1, 2), TypeParam(6));
+  EXPECT_EQ(m.GetValue(2, 0), TypeParam(0));
+  EXPECT_EQ(m.GetValue(2, 1), TypeParam(0));
+  EXPECT_EQ(m.GetValue(2, 2), TypeParam(0));
+  EXPECT_EQ(m.GetValue(3, 0), TypeParam(0));
+  EXPECT_EQ(m.GetValue(3, 1), TypeParam(0));
+  EXPECT_EQ(m.GetValue(3, 2), TypeParam(0));
+}
+
+TYPED_TEST(S21BasicMatrixTest, SetRowsSmaller) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
   m.SetValue(0, 0, 1);
   m.SetValue(0, 1, 2);
   m.SetValue(0, 2, 3);
@@ -702,41 +1397,44 @@ TEST(S21MatrixTest, SetRowsSmaller) {
 
   EXPECT_EQ(m.GetRows(), 1);
   EXPECT_EQ(m.GetCols(), 3);
-  EXPECT_EQ(m.GetValue(0, 0), 1);
-  EXPECT_EQ(m.GetValue(0, 1), 2);
-  EXPECT_EQ(m.GetValue(0, 2), 3);
+  EXPECT_EQ(m.GetValue(0, 0), TypeParam(1));
+  EXPECT_EQ(m.GetValue(0, 1), TypeParam(2));
+  EXPECT_EQ(m.GetValue(0, 2), TypeParam(3));
 }
 
-TEST(S21MatrixTest, OperatorRoundBracketsTestAssert) {
-  S21Matrix m(2, 3);
+TYPED_TEST(S21BasicMatrixTest, OperatorRoundBracketsTestAssert) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
   m.SetValue(0, 0, 1);
   m.SetValue(0, 1, 2);
   m.SetValue(0, 2, 3);
   m.SetValue(1, 0, 4);
   m.SetValue(1, 1, 5);
   m.SetValue(1, 2, 6);
-  ASSERT_EQ(m(0, 0), 1);
-  ASSERT_EQ(m(0, 1), 2);
+  ASSERT_EQ(m(0, 0), TypeParam(1));
+  ASSERT_EQ(m(0, 1), TypeParam(2));
 }
 
-TEST(S21MatrixTest, ConstIndexingAfterModification) {
-  S21Matrix m(2, 3);
+TYPED_TEST(S21BasicMatrixTest, ConstIndexingAfterModification) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
   m.SetValue(0, 0, 1);
   m.SetValue(1, 2, 6);
 
-  EXPECT_EQ(m(0, 0), 1);
-  EXPECT_EQ(m(1, 2), 6);
+  EXPECT_EQ(m(0, 0), TypeParam(1));
+  EXPECT_EQ(m(1, 2), TypeParam(6));
 }
 
-TEST(S21MatrixTest, OperatorThrowsExceptionWhenIndexIsOutOfRange) {
-  S21Matrix matrix(2, 2);
+TYPED_TEST(S21BasicMatrixTest, OperatorThrowsExceptionWhenIndexIsOutOfRange) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix matrix(2, 2);
   matrix.SetValue(0, 0, 1);
   matrix.SetValue(0, 1, 2);
   matrix.SetValue(1, 0, 3);
   matrix.SetValue(1, 1, 4);
-  const S21Matrix matrix2 = matrix;
-  EXPECT_EQ(matrix2(1, 1), 4);
-  EXPECT_EQ(matrix2(1, 0), 3);
+  const Matrix matrix2 = matrix;
+  EXPECT_EQ(matrix2(1, 1), TypeParam(4));
+  EXPECT_EQ(matrix2(1, 0), TypeParam(3));
   ASSERT_ANY_THROW(matrix(3, 1));
   ASSERT_ANY_THROW(matrix2(3, 1));
   ASSERT_ANY_THROW(matrix2(-1, 1));
@@ -744,100 +1442,113 @@ TEST(S21MatrixTest, OperatorThrowsExceptionWhenIndexIsOutOfRange) {
   ASSERT_ANY_THROW(matrix2(1, -1));
 }
 
-TEST(S21Matrix, GetRows) {
-  S21Matrix m(2, 3);
+TYPED_TEST(S21BasicMatrixTest, GetRows) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
   EXPECT_EQ(m.GetRows(), 2);
 }
 
-TEST(S21Matrix, GetCols) {
-  S21Matrix m(2, 3);
+TYPED_TEST(S21BasicMatrixTest, GetCols) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
   EXPECT_EQ(m.GetCols(), 3);
 }
 
-TEST(S21Matrix, GetValue) {
-  S21Matrix m(2, 3);
-  m.SetValue(0, 1, 1.0);
-  EXPECT_EQ(m.GetValue(0, 1), 1.0);
+TYPED_TEST(S21BasicMatrixTest, GetValue) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
+  m.SetValue(0, 1, 1);
+  EXPECT_EQ(m.GetValue(0, 1), TypeParam(1));
 }
 
-TEST(S21Matrix, GetMatrix) {
-  S21Matrix m(2, 3);
-  double **matrix = m.GetMatrix();
+TYPED_TEST(S21BasicMatrixTest, Data) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
+  TypeParam *matrix = m.Data();
   EXPECT_NE(matrix, nullptr);
-  matrix[0][1] = 1.0;
-  EXPECT_EQ(m.GetValue(0, 1), 1.0);
+  matrix[0 * m.Stride() + 1] = 1;
+  EXPECT_EQ(m.GetValue(0, 1), TypeParam(1));
 }
 
-TEST(S21Matrix, SetRows) {
-  S21Matrix m(2, 3);
+TYPED_TEST(S21BasicMatrixTest, SetRows) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
   m.SetRows(3);
   EXPECT_EQ(m.GetRows(), 3);
 }
 
-TEST(S21Matrix, SetCols) {
-  S21Matrix m(2, 3);
+TYPED_TEST(S21BasicMatrixTest, SetCols) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
   m.SetCols(4);
   EXPECT_EQ(m.GetCols(), 4);
 }
 
-TEST(S21Matrix, SetValue) {
-  S21Matrix m(2, 3);
-  m.SetValue(0, 1, 1.0);
-  EXPECT_EQ(m.GetValue(0, 1), 1.0);
+TYPED_TEST(S21BasicMatrixTest, SetValue) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 3);
+  m.SetValue(0, 1, 1);
+  EXPECT_EQ(m.GetValue(0, 1), TypeParam(1));
 }
 
-TEST(S21Matrix, EqMatrix) {
-  S21Matrix m1(2, 3);
-  m1.SetValue(0, 0, 1.0);
-  S21Matrix m2(2, 3);
-  m2.SetValue(0, 0, 1.0);
+TYPED_TEST(S21BasicMatrixTest, EqMatrix) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m1(2, 3);
+  m1.SetValue(0, 0, 1);
+  Matrix m2(2, 3);
+  m2.SetValue(0, 0, 1);
   EXPECT_TRUE(m1.EqMatrix(m2));
 }
 
-TEST(S21Matrix, EqMatrixFalse) {
-  S21Matrix m1(2, 3);
-  m1.SetValue(0, 0, 1.0);
-  S21Matrix m2(2, 3);
-  m2.SetValue(0, 0, 2.0);
+TYPED_TEST(S21BasicMatrixTest, EqMatrixFalse) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m1(2, 3);
+  m1.SetValue(0, 0, 1);
+  Matrix m2(2, 3);
+  m2.SetValue(0, 0, 2);
   EXPECT_FALSE(m1.EqMatrix(m2));
 }
 
-TEST(S21Matrix, EqMatrixFalse2) {
-  S21Matrix m1(2, 3);
-  m1.SetValue(0, 0, 1.0);
-  S21Matrix m2(2, 2);
-  m2.SetValue(0, 0, 1.0);
+TYPED_TEST(S21BasicMatrixTest, EqMatrixFalse2) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m1(2, 3);
+  m1.SetValue(0, 0, 1);
+  Matrix m2(2, 2);
+  m2.SetValue(0, 0, 1);
   EXPECT_FALSE(m1.EqMatrix(m2));
 }
 
-TEST(S21Matrix, SumMatrix) {
-  S21Matrix m1(2, 3);
-  m1.SetValue(0, 0, 1.0);
-  S21Matrix m2(2, 3);
-  m2.SetValue(0, 1, 2.0);
+TYPED_TEST(S21BasicMatrixTest, SumMatrix) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m1(2, 3);
+  m1.SetValue(0, 0, 1);
+  Matrix m2(2, 3);
+  m2.SetValue(0, 1, 2);
   m1.SumMatrix(m2);
-  EXPECT_EQ(m1.GetValue(0, 0), 1.0);
-  EXPECT_EQ(m1.GetValue(0, 1), 2.0);
+  EXPECT_EQ(m1.GetValue(0, 0), TypeParam(1));
+  EXPECT_EQ(m1.GetValue(0, 1), TypeParam(2));
 }
 
-TEST(S21Matrix, SubMatrix) {
-  S21Matrix m1(2, 3);
-  m1.SetValue(0, 0, 1.0);
-  S21Matrix m2(2, 3);
-  m2.SetValue(0, 1, 2.0);
+TYPED_TEST(S21BasicMatrixTest, SubMatrix) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m1(2, 3);
+  m1.SetValue(0, 0, 1);
+  Matrix m2(2, 3);
+  m2.SetValue(0, 1, 2);
   m1.SubMatrix(m2);
-  S21Matrix m3(4, 3);
-  S21Matrix m4;
-  EXPECT_EQ(m1.GetValue(0, 0), 1.0);
-  EXPECT_EQ(m1.GetValue(0, 1), -2.0);
+  Matrix m3(4, 3);
+  Matrix m4;
+  EXPECT_EQ(m1.GetValue(0, 0), TypeParam(1));
+  EXPECT_EQ(m1.GetValue(0, 1), TypeParam(-2.0));
   ASSERT_ANY_THROW(m1.SubMatrix(m3));
   ASSERT_ANY_THROW(m1.SubMatrix(m4));
   ASSERT_ANY_THROW(m1.GetValue(0, -1));
   ASSERT_ANY_THROW(m1.SetValue(0, -1, 1));
 }
 
-TEST(S21MatrixTest, MulNumberTest) {
-  S21Matrix matrix1(2, 3);
+TYPED_TEST(S21BasicMatrixTest, MulNumberTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix matrix1(2, 3);
   matrix1.SetValue(0, 0, 1);
   matrix1.SetValue(0, 1, 2);
   matrix1.SetValue(0, 2, 3);
@@ -845,28 +1556,29 @@ TEST(S21MatrixTest, MulNumberTest) {
   matrix1.SetValue(1, 1, 5);
   matrix1.SetValue(1, 2, 6);
   matrix1.MulNumber(2);
-  EXPECT_EQ(matrix1.GetValue(0, 0), 2);
-  EXPECT_EQ(matrix1.GetValue(0, 1), 4);
-  EXPECT_EQ(matrix1.GetValue(0, 2), 6);
-  EXPECT_EQ(matrix1.GetValue(1, 0), 8);
-  EXPECT_EQ(matrix1.GetValue(1, 1), 10);
-  EXPECT_EQ(matrix1.GetValue(1, 2), 12);
-
-  S21Matrix matrix2(2, 2);
+  EXPECT_EQ(matrix1.GetValue(0, 0), TypeParam(2));
+  EXPECT_EQ(matrix1.GetValue(0, 1), TypeParam(4));
+  EXPECT_EQ(matrix1.GetValue(0, 2), TypeParam(6));
+  EXPECT_EQ(matrix1.GetValue(1, 0), TypeParam(8));
+  EXPECT_EQ(matrix1.GetValue(1, 1), TypeParam(10));
+  EXPECT_EQ(matrix1.GetValue(1, 2), TypeParam(12));
+
+  Matrix matrix2(2, 2);
   matrix2.SetValue(0, 0, 1);
   matrix2.SetValue(0, 1, 2);
   matrix2.SetValue(1, 0, 3);
   matrix2.SetValue(1, 1, 4);
   matrix2.MulNumber(-2);
-  EXPECT_EQ(matrix2.GetValue(0, 0), -2);
-  EXPECT_EQ(matrix2.GetValue(0, 1), -4);
-  EXPECT_EQ(matrix2.GetValue(1, 0), -6);
-  EXPECT_EQ(matrix2.GetValue(1, 1), -8);
+  EXPECT_EQ(matrix2.GetValue(0, 0), TypeParam(-2));
+  EXPECT_EQ(matrix2.GetValue(0, 1), TypeParam(-4));
+  EXPECT_EQ(matrix2.GetValue(1, 0), TypeParam(-6));
+  EXPECT_EQ(matrix2.GetValue(1, 1), TypeParam(-8));
 }
 
-TEST(Test, operator_mulNumbereq) {
-  S21Matrix B(3, 4);
-  S21Matrix A(3, 4);
+TYPED_TEST(S21BasicMatrixTest, operator_mulNumbereq) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix B(3, 4);
+  Matrix A(3, 4);
   B(0, 0) = 1;
   B(0, 1) = 2;
   B(0, 2) = 3;
@@ -896,10 +1608,11 @@ TEST(Test, operator_mulNumbereq) {
   B *= 2;
   EXPECT_EQ(1, B == A);
 }
-TEST(Test, mulMatrixeq) {
-  S21Matrix B(2, 2);
-  S21Matrix A(2, 2);
-  S21Matrix expected(2, 2);
+TYPED_TEST(S21BasicMatrixTest, mulMatrixeq) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix B(2, 2);
+  Matrix A(2, 2);
+  Matrix expected(2, 2);
   B(0, 0) = 1;
   B(0, 1) = 2;
   B(1, 0) = 5;
@@ -918,10 +1631,11 @@ TEST(Test, mulMatrixeq) {
   B *= A;
   EXPECT_EQ(1, B == expected);
 }
-TEST(Test, operator_mulMatrix) {
-  S21Matrix B(2, 2);
-  S21Matrix A(2, 2);
-  S21Matrix expected(2, 2);
+TYPED_TEST(S21BasicMatrixTest, operator_mulMatrix) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix B(2, 2);
+  Matrix A(2, 2);
+  Matrix expected(2, 2);
   B(0, 0) = 1;
   B(0, 1) = 2;
   B(1, 0) = 5;
@@ -941,25 +1655,26 @@ TEST(Test, operator_mulMatrix) {
   EXPECT_EQ(1, B == expected);
 }
 
-TEST(S21MatrixTest, TransposeTest) {
-  S21Matrix matrix1(2, 3);
+TYPED_TEST(S21BasicMatrixTest, TransposeTest) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix matrix1(2, 3);
   matrix1.SetValue(0, 0, 1);
   matrix1.SetValue(0, 1, 2);
   matrix1.SetValue(0, 2, 3);
   matrix1.SetValue(1, 0, 4);
   matrix1.SetValue(1, 1, 5);
   matrix1.SetValue(1, 2, 6);
-  S21Matrix result1 = matrix1.Transpose();
+  Matrix result1 = matrix1.Transpose();
   EXPECT_EQ(result1.GetRows(), 3);
   EXPECT_EQ(result1.GetCols(), 2);
-  EXPECT_EQ(result1.GetValue(0, 0), 1);
-  EXPECT_EQ(result1.GetValue(0, 1), 4);
-  EXPECT_EQ(result1.GetValue(1, 0), 2);
-  EXPECT_EQ(result1.GetValue(1, 1), 5);
-  EXPECT_EQ(result1.GetValue(2, 0), 3);
-  EXPECT_EQ(result1.GetValue(2, 1), 6);
-
-  S21Matrix matrix2(3, 3);
+  EXPECT_EQ(result1.GetValue(0, 0), TypeParam(1));
+  EXPECT_EQ(result1.GetValue(0, 1), TypeParam(4));
+  EXPECT_EQ(result1.GetValue(1, 0), TypeParam(2));
+  EXPECT_EQ(result1.GetValue(1, 1), TypeParam(5));
+  EXPECT_EQ(result1.GetValue(2, 0), TypeParam(3));
+  EXPECT_EQ(result1.GetValue(2, 1), TypeParam(6));
+
+  Matrix matrix2(3, 3);
   matrix2.SetValue(0, 0, 1);
   matrix2.SetValue(0, 1, 2);
   matrix2.SetValue(0, 2, 3);
@@ -969,132 +1684,138 @@ TEST(S21MatrixTest, TransposeTest) {
   matrix2.SetValue(2, 0, 7);
   matrix2.SetValue(2, 1, 8);
   matrix2.SetValue(2, 2, 9);
-  S21Matrix result2 = matrix2.Transpose();
+  Matrix result2 = matrix2.Transpose();
   EXPECT_EQ(result2.GetRows(), 3);
   EXPECT_EQ(result2.GetCols(), 3);
-  EXPECT_EQ(result2.GetValue(0, 0), 1);
-  EXPECT_EQ(result2.GetValue(0, 1), 4);
-  EXPECT_EQ(result2.GetValue(0, 2), 7);
-  EXPECT_EQ(result2.GetValue(1, 0), 2);
-  EXPECT_EQ(result2.GetValue(1, 1), 5);
-  EXPECT_EQ(result2.GetValue(1, 2), 8);
-  EXPECT_EQ(result2.GetValue(2, 0), 3);
-  EXPECT_EQ(result2.GetValue(2, 1), 6);
-  EXPECT_EQ(result2.GetValue(2, 2), 9);
-}
-
-TEST(S21MatrixTest, DeterminantOneByOne) {
-  S21Matrix m(1, 1);
-  m.SetValue(0, 0, 2.0);
-  EXPECT_DOUBLE_EQ(m.Determinant(), 2.0);
+  EXPECT_EQ(result2.GetValue(0, 0), TypeParam(1));
+  EXPECT_EQ(result2.GetValue(0, 1), TypeParam(4));
+  EXPECT_EQ(result2.GetValue(0, 2), TypeParam(7));
+  EXPECT_EQ(result2.GetValue(1, 0), TypeParam(2));
+  EXPECT_EQ(result2.GetValue(1, 1), TypeParam(5));
+  EXPECT_EQ(result2.GetValue(1, 2), TypeParam(8));
+  EXPECT_EQ(result2.GetValue(2, 0), TypeParam(3));
+  EXPECT_EQ(result2.GetValue(2, 1), TypeParam(6));
+  EXPECT_EQ(result2.GetValue(2, 2), TypeParam(9));
+}
+
+TYPED_TEST(S21BasicMatrixTest, DeterminantOneByOne) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(1, 1);
+  m.SetValue(0, 0, 2);
+  EXPECT_EQ(m.Determinant(), TypeParam(2));
+}
+
+TYPED_TEST(S21BasicMatrixTest, DeterminantTwoByTwo) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 2);
+  m.SetValue(0, 0, 1);
+  m.SetValue(0, 1, 2);
+  m.SetValue(1, 0, 3);
+  m.SetValue(1, 1, 4);
+  EXPECT_EQ(m.Determinant(), TypeParam(-2.0));
 }
 
-TEST(S21MatrixTest, DeterminantTwoByTwo) {
-  S21Matrix m(2, 2);
-  m.SetValue(0, 0, 1.0);
-  m.SetValue(0, 1, 2.0);
-  m.SetValue(1, 0, 3.0);
-  m.SetValue(1, 1, 4.0);
-  EXPECT_DOUBLE_EQ(m.Determinant(), -2.0);
-}
-
-TEST(S21MatrixTest, DeterminantFourByFour) {
-  S21Matrix m(4, 4);
-  m.SetValue(0, 0, 1.0);
-  m.SetValue(0, 1, 2.0);
-  m.SetValue(0, 2, 3.0);
-  m.SetValue(0, 3, 4.0);
-  m.SetValue(1, 0, 0.0);
-  m.SetValue(1, 1, 1.0);
-  m.SetValue(1, 2, 2.0);
-  m.SetValue(1, 3, 3.0);
-  m.SetValue(2, 0, 0.0);
-  m.SetValue(2, 1, 0.0);
-  m.SetValue(2, 2, 1.0);
-  m.SetValue(2, 3, 2.0);
-  m.SetValue(3, 0, 0.0);
-  m.SetValue(3, 1, 0.0);
-  m.SetValue(3, 2, 0.0);
-  m.SetValue(3, 3, 1.0);
-  EXPECT_DOUBLE_EQ(m.Determinant(), 1.0);
-}
-
-TEST(S21MatrixTest, MinorTwoByTwo) {
-  S21Matrix m(2, 2);
-  m.SetValue(0, 0, 1.0);
-  m.SetValue(0, 1, 2.0);
-  m.SetValue(1, 0, 3.0);
-  m.SetValue(1, 1, 4.0);
+TYPED_TEST(S21BasicMatrixTest, DeterminantFourByFour) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(4, 4);
+  m.SetValue(0, 0, 1);
+  m.SetValue(0, 1, 2);
+  m.SetValue(0, 2, 3);
+  m.SetValue(0, 3, 4);
+  m.SetValue(1, 0, 0);
+  m.SetValue(1, 1, 1);
+  m.SetValue(1, 2, 2);
+  m.SetValue(1, 3, 3);
+  m.SetValue(2, 0, 0);
+  m.SetValue(2, 1, 0);
+  m.SetValue(2, 2, 1);
+  m.SetValue(2, 3, 2);
+  m.SetValue(3, 0, 0);
+  m.SetValue(3, 1, 0);
+  m.SetValue(3, 2, 0);
+  m.SetValue(3, 3, 1);
+  EXPECT_EQ(m.Determinant(), TypeParam(1));
+}
+
+TYPED_TEST(S21BasicMatrixTest, MinorTwoByTwo) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(2, 2);
+  m.SetValue(0, 0, 1);
+  m.SetValue(0, 1, 2);
+  m.SetValue(1, 0, 3);
+  m.SetValue(1, 1, 4);
 
-  S21Matrix temp(1, 1);
+  Matrix temp(1, 1);
   m.Minor(m, temp, 0, 1, 2);
 
   EXPECT_EQ(temp.GetRows(), 1);
   EXPECT_EQ(temp.GetCols(), 1);
-  EXPECT_DOUBLE_EQ(temp.GetValue(0, 0), 3.0);
+  EXPECT_EQ(temp.GetValue(0, 0), TypeParam(3));
 }
 
 // // Test the Minor function with a 3x3 matrix
 // TEST(S21MatrixTest, MinorThreeByThree) {
 //   S21Matrix m(3, 3);
-//   m.SetValue(0, 0, 1.0);
-//   m.SetValue(0, 1, 2.0);
-//   m.SetValue(0, 2, 3.0);
-//   m.SetValue(1, 0, 4.0);
-//   m.SetValue(1, 1, 5.0);
-//   m.SetValue(1, 2, 6.0);
-//   m.SetValue(2, 0, 7.0);
-//   m.SetValue(2, 1, 8.0);
-//   m.SetValue(2, 2, 9.0);
+//   m.SetValue(0, 0, 1);
+//   m.SetValue(0, 1, 2);
+//   m.SetValue(0, 2, 3);
+//   m.SetValue(1, 0, 4);
+//   m.SetValue(1, 1, 5);
+//   m.SetValue(1, 2, 6);
+//   m.SetValue(2, 0, 7);
+//   m.SetValue(2, 1, 8);
+//   m.SetValue(2, 2, 9);
 
 //   S21Matrix temp(2, 2);
 //   m.Minor(m, temp, 1, 2, 3);
 
 //   EXPECT_EQ(temp.GetRows(), 2);
 //   EXPECT_EQ(temp.GetCols(), 2);
-//   EXPECT_DOUBLE_EQ(temp.GetValue(0, 0), 1.0);
-//   EXPECT_DOUBLE_EQ(temp.GetValue(0, 1), 3.0);
-//   EXPECT_DOUBLE_EQ(temp.GetValue(1, 0), 7.0);
-//   EXPECT_DOUBLE_EQ(temp.GetValue(1, 1), 9.0);
+//   EXPECT_DOUBLE_EQ(temp.GetValue(0, 0), 1);
+//   EXPECT_DOUBLE_EQ(temp.GetValue(0, 1), 3);
+//   EXPECT_DOUBLE_EQ(temp.GetValue(1, 0), 7);
+//   EXPECT_DOUBLE_EQ(temp.GetValue(1, 1), 9);
 // }
 
-TEST(S21MatrixTest, MinorFourByFour) {
-  S21Matrix m(4, 4);
-  m.SetValue(0, 0, 1.0);
-  m.SetValue(0, 1, 2.0);
-  m.SetValue(0, 2, 3.0);
-  m.SetValue(0, 3, 4.0);
-  m.SetValue(1, 0, 5.0);
-  m.SetValue(1, 1, 6.0);
-  m.SetValue(1, 2, 7.0);
-  m.SetValue(1, 3, 8.0);
-  m.SetValue(2, 0, 9.0);
-  m.SetValue(2, 1, 10.0);
-  m.SetValue(2, 2, 11.0);
-  m.SetValue(2, 3, 12.0);
-  m.SetValue(3, 0, 13.0);
-  m.SetValue(3, 1, 14.0);
-  m.SetValue(3, 2, 15.0);
-  m.SetValue(3, 3, 16.0);
-
-  S21Matrix temp(3, 3);
+TYPED_TEST(S21BasicMatrixTest, MinorFourByFour) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix m(4, 4);
+  m.SetValue(0, 0, 1);
+  m.SetValue(0, 1, 2);
+  m.SetValue(0, 2, 3);
+  m.SetValue(0, 3, 4);
+  m.SetValue(1, 0, 5);
+  m.SetValue(1, 1, 6);
+  m.SetValue(1, 2, 7);
+  m.SetValue(1, 3, 8);
+  m.SetValue(2, 0, 9);
+  m.SetValue(2, 1, 10);
+  m.SetValue(2, 2, 11);
+  m.SetValue(2, 3, 12);
+  m.SetValue(3, 0, 13);
+  m.SetValue(3, 1, 14);
+  m.SetValue(3, 2, 15);
+  m.SetValue(3, 3, 16);
+
+  Matrix temp(3, 3);
   m.Minor(m, temp, 1, 1, 4);
 
   EXPECT_EQ(temp.GetRows(), 3);
   EXPECT_EQ(temp.GetCols(), 3);
-  EXPECT_DOUBLE_EQ(temp.GetValue(0, 0), 1.0);
-  EXPECT_DOUBLE_EQ(temp.GetValue(0, 1), 3.0);
-  EXPECT_DOUBLE_EQ(temp.GetValue(0, 2), 4.0);
-  EXPECT_DOUBLE_EQ(temp.GetValue(1, 0), 9.0);
-  EXPECT_DOUBLE_EQ(temp.GetValue(1, 1), 11.0);
-  EXPECT_DOUBLE_EQ(temp.GetValue(1, 2), 12.0);
-  EXPECT_DOUBLE_EQ(temp.GetValue(2, 0), 13.0);
-  EXPECT_DOUBLE_EQ(temp.GetValue(2, 1), 15.0);
-  EXPECT_DOUBLE_EQ(temp.GetValue(2, 2), 16.0);
-}
-
-TEST(Test, invers_test) {
-  S21Matrix result(3, 3);
+  EXPECT_EQ(temp.GetValue(0, 0), TypeParam(1));
+  EXPECT_EQ(temp.GetValue(0, 1), TypeParam(3));
+  EXPECT_EQ(temp.GetValue(0, 2), TypeParam(4));
+  EXPECT_EQ(temp.GetValue(1, 0), TypeParam(9));
+  EXPECT_EQ(temp.GetValue(1, 1), TypeParam(11));
+  EXPECT_EQ(temp.GetValue(1, 2), TypeParam(12));
+  EXPECT_EQ(temp.GetValue(2, 0), TypeParam(13));
+  EXPECT_EQ(temp.GetValue(2, 1), TypeParam(15));
+  EXPECT_EQ(temp.GetValue(2, 2), TypeParam(16));
+}
+
+TYPED_TEST(S21BasicMatrixTest, invers_test) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix result(3, 3);
   result(0, 0) = 0;
   result(0, 1) = 1;
   result(0, 2) = -0.75;
@@ -1105,7 +1826,7 @@ TEST(Test, invers_test) {
   result(2, 1) = -3.5;
   result(2, 2) = 2.5;
 
-  S21Matrix R(3, 3);
+  Matrix R(3, 3);
   R(0, 0) = 8;
   R(0, 1) = 2;
   R(0, 2) = 4;
@@ -1116,23 +1837,711 @@ TEST(Test, invers_test) {
   R(2, 1) = 8;
   R(2, 2) = 8;
 
-  S21Matrix result_inverse(3, 3);
-  result_inverse = R.InverseMatrix();
-  EXPECT_EQ(1, result == result_inverse);
-}
-
-TEST(S21MatrixTest, OperatorMulNumberLeft) {
-  S21Matrix mat(2, 3);
-  mat.SetValue(1, 2, 3.14);
-  S21Matrix result = 2.0 * mat;
-  EXPECT_EQ(result.GetValue(1, 2), 6.28);
-}
-
-TEST(S21MatrixTest, OperatorMulNumberRight) {
-  S21Matrix mat(2, 3);
-  mat.SetValue(1, 2, 3.14);
-  S21Matrix result = mat * 2.0;
-  EXPECT_EQ(result.GetValue(1, 2), 6.28);
+  if constexpr (std::is_integral_v<TypeParam>) {
+    // The determinant is 16.
+    EXPECT_THROW(R.InverseMatrix(), std::logic_error);
+  } else {
+    Matrix result_inverse(3, 3);
+    result_inverse = R.InverseMatrix();
+    EXPECT_EQ(1, result == result_inverse);
+  }
+}
+
+TYPED_TEST(S21BasicMatrixTest, OperatorMulNumberLeft) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix mat(2, 3);
+  mat.SetValue(1, 2, 7);
+  Matrix result = 2 * mat;
+  EXPECT_EQ(result.GetValue(1, 2), TypeParam(14));
+}
+
+TYPED_TEST(S21BasicMatrixTest, OperatorMulNumberRight) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix mat(2, 3);
+  mat.SetValue(1, 2, 7);
+  Matrix result = mat * 2;
+  EXPECT_EQ(result.GetValue(1, 2), TypeParam(14));
+}
+
+TYPED_TEST(S21BasicMatrixTest, ElementWiseOperations) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix a = this->Pattern(13, 21, 1);
+  Matrix b = this->Pattern(13, 21, 2);
+  EXPECT_EQ(a.Stride() * sizeof(TypeParam) % 64, 0u);
+  Matrix sum = a + b * TypeParam(2) - a;
+  Matrix twice(b);
+  twice.MulNumber(TypeParam(2));
+  EXPECT_TRUE(sum == twice);
+  sum.SubMatrix(b);
+  EXPECT_TRUE(sum.EqMatrix(b));
+  sum += b;
+  sum -= twice;
+  EXPECT_TRUE(sum == Matrix(13, 21));
+  Matrix t = a.Transpose();
+  EXPECT_EQ(t(20, 12), a(12, 20));
+  EXPECT_THROW(a.SumMatrix(t), std::runtime_error);
+}
+
+TYPED_TEST(S21BasicMatrixTest, ProductsMatchAcrossIsaLevels) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  Matrix a = this->Pattern(70, 90, 1);
+  Matrix b = this->Pattern(90, 50, 2);
+  Matrix expected(70, 50);
+  for (int i = 0; i < 70; i++) {
+    for (int j = 0; j < 50; j++) {
+      for (int k = 0; k < 90; k++) expected(i, j) += a(i, k) * b(k, j);
+    }
+  }
+  const s21::Isa detected = s21::DetectIsa();
+  for (s21::Isa isa : {s21::Isa::kScalar, s21::Isa::kSse2, s21::Isa::kAvx2,
+                       s21::Isa::kAvx512}) {
+    if (!s21::SetIsa(isa)) continue;
+    EXPECT_TRUE(a * b == expected);
+  }
+  s21::SetIsa(detected);
+}
+
+TYPED_TEST(S21BasicMatrixTest, TransposeAndTransposeInPlace) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  const s21::Isa detected = s21::DetectIsa();
+  for (s21::Isa isa : {s21::Isa::kScalar, s21::Isa::kSse2, s21::Isa::kAvx2,
+                       s21::Isa::kAvx512}) {
+    if (!s21::SetIsa(isa)) continue;
+    // Recursive splits, whole tiles only, edges, thin shapes, and shapes
+    // whose padded transpose does not fit the buffer (3 x 100).
+    for (auto [rows, cols] : {std::pair{131, 77}, std::pair{64, 64},
+                              std::pair{75, 75}, std::pair{1, 300},
+                              std::pair{100, 3}, std::pair{3, 100},
+                              std::pair{40, 16}, std::pair{17, 9}}) {
+      Matrix a = this->Pattern(rows, cols, rows + cols);
+      Matrix t = a.Transpose();
+      ASSERT_EQ(t.GetRows(), cols);
+      ASSERT_EQ(t.GetCols(), rows);
+      bool same = true;
+      for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) same = same && t(j, i) == a(i, j);
+      }
+      EXPECT_TRUE(same) << rows << " x " << cols;
+      Matrix in_place = a;
+      in_place.TransposeInPlace();
+      EXPECT_EQ(in_place.Stride(), t.Stride());
+      EXPECT_TRUE(in_place == t) << rows << " x " << cols;
+      in_place.TransposeInPlace();
+      EXPECT_TRUE(in_place == a) << rows << " x " << cols;
+    }
+  }
+  s21::SetIsa(detected);
+  // Blocks with an offset, and a strided source.
+  Matrix a = this->Pattern(50, 60, 3);
+  Matrix block(a.View().Block(5, 7, 33, 41).Transposed());
+  EXPECT_EQ(block(40, 32), a(37, 47));
+  Matrix back(33, 41);
+  s21::Transpose<TypeParam>(block.View(), back.View());
+  EXPECT_TRUE(back.EqMatrix(a.View().Block(5, 7, 33, 41)));
+  Matrix copy(50, 60);
+  s21::Transpose<TypeParam>(a.View().Transposed(), copy.View());
+  EXPECT_TRUE(copy == a);
+  Matrix square(a.View().Block(0, 0, 50, 50));
+  s21::TransposeInPlace<TypeParam>(square.View().Block(3, 3, 40, 40));
+  EXPECT_EQ(square(3, 42), a(42, 3));
+  EXPECT_EQ(square(2, 42), a(2, 42));
+  EXPECT_THROW(s21::TransposeInPlace<TypeParam>(a.View()), std::runtime_error);
+  EXPECT_THROW(s21::Transpose<TypeParam>(a.View(), a.View()),
+               std::runtime_error);
+  EXPECT_THROW(Matrix().TransposeInPlace(), std::runtime_error);
+}
+
+TYPED_TEST(S21BasicMatrixTest, DeterminantInverseComplements) {
+  using Matrix = S21BasicMatrix<TypeParam>;
+  for (int n : {2, 3, 6}) {
+    Matrix a = this->Unimodular(n);
+    EXPECT_EQ(a.Determinant(), TypeParam(1));
+    Matrix inverse = a.InverseMatrix();
+    EXPECT_TRUE(a * inverse == this->Identity(n));
+    EXPECT_TRUE(a.CalcComplements().Transpose() == inverse);
+    int sign = 0;
+    EXPECT_NEAR(a.LogDeterminant(sign), 0.0, 1e-4);
+    EXPECT_EQ(sign, 1);
+  }
+  Matrix singular = this->Pattern(5, 5, 3);
+  singular.SetRows(6);
+  singular.SetCols(6);
+  EXPECT_EQ(singular.Determinant(), TypeParam(0));
+  EXPECT_THROW(singular.InverseMatrix(), std::logic_error);
+}
+
+TEST(S21MatrixTest, EqMatrixUsesTypeTolerance) {
+  S21FloatMatrix f(1, 1), g(1, 1);
+  f(0, 0) = 1.0f;
+  g(0, 0) = 1.00005f;
+  EXPECT_TRUE(f == g);
+  g(0, 0) = 1.001f;
+  EXPECT_FALSE(f == g);
+
+  S21IntMatrix i(1, 1), j(1, 1);
+  j(0, 0) = 1;
+  EXPECT_FALSE(i == j);
+
+  S21ComplexMatrix c(1, 1), d(1, 1);
+  c(0, 0) = {1.0, 2.0};
+  d(0, 0) = {1.0, 2.0 + 1e-9};
+  EXPECT_TRUE(c == d);
+  d(0, 0) = {1.0, -2.0};
+  EXPECT_FALSE(c == d);
+}
+
+TEST(S21MatrixTest, IntegerDeterminantIsExact) {
+  // det = 46340^2 + 1, close to INT32_MAX and odd, mixed by a unimodular
+  // factor so the elimination has to work for it.
+  S21IntMatrix d(4, 4), u(4, 4);
+  d(0, 0) = d(1, 1) = 46340;
+  d(0, 1) = -1;
+  d(1, 0) = 1;
+  d(2, 2) = d(3, 3) = 1;
+  for (int i = 0; i < 4; i++) {
+    u(i, i) = 1;
+    if (i < 3) u(i, i + 1) = 1;
+  }
+  S21IntMatrix m = u * d;
+  m = m * u.Transpose();
+  EXPECT_EQ(m.Determinant(), 2147395601);
+  // Determinants beyond int32 throw at every size rather than wrap.
+  for (int n : {1, 2, 3, 4, 7}) {
+    S21IntMatrix big(n, n);
+    for (int i = 0; i < n; i++) big(i, i) = n == 1 ? 0 : 50000;
+    if (n == 1) {
+      EXPECT_EQ(big.Determinant(), 0);
+      continue;
+    }
+    EXPECT_THROW(big.Determinant(), std::overflow_error) << n;
+    if (n < 4) {
+      EXPECT_THROW(big.InverseMatrix(), std::logic_error) << n;
+    }
+  }
+  S21IntMatrix wide(2, 2);
+  wide(0, 0) = wide(1, 1) = 46341;
+  EXPECT_THROW(wide.Determinant(), std::overflow_error);
+  wide(0, 0) = -46341;
+  EXPECT_THROW(wide.Determinant(), std::overflow_error);
+  wide(1, 1) = 46340;
+  EXPECT_EQ(wide.Determinant(), -2147441940);
+  // 50000^7 overflows 64 bits inside the elimination.
+  S21IntMatrix huge(7, 7);
+  for (int i = 0; i < 7; i++) huge(i, i) = 50000;
+  EXPECT_THROW(huge.InverseMatrix(), std::overflow_error);
+  S21IntMatrix two(2, 2);
+  two(0, 0) = 2;
+  two(1, 1) = 1;
+  EXPECT_THROW(two.InverseMatrix(), std::logic_error);
+}
+
+TEST(S21MatrixTest, ComplexInverse) {
+  S21ComplexMatrix a(70, 70);
+  for (int i = 0; i < 70; i++) {
+    for (int j = 0; j < 70; j++) {
+      a(i, j) = {((i * 7 + j * 13) % 17) / 8.0 - 1.0,
+                 ((i * 5 + j * 3) % 11) / 5.0 - 1.0};
+    }
+    a(i, i) += std::complex<double>(0.0, 20.0);
+  }
+  S21ComplexMatrix identity(70, 70);
+  for (int i = 0; i < 70; i++) identity(i, i) = 1.0;
+  EXPECT_TRUE(a * a.InverseMatrix() == identity);
+  int sign = 0;
+  EXPECT_NEAR(a.LogDeterminant(sign), std::log(std::abs(a.Determinant())),
+              1e-9);
+  EXPECT_EQ(sign, 1);
+}
+
+TEST(S21FixedMatrixTest, ConstantExpressions) {
+  constexpr S21Matrix3 a{2, 1, 1, 1, 1, 1, 1, 1, 2};
+  static_assert(a.Determinant() == 1.0, "closed-form 3x3 determinant");
+  constexpr S21Matrix3 inverse = a.InverseMatrix();
+  static_assert(a * inverse == S21Matrix3::Identity(), "closed-form inverse");
+  constexpr S21FixedMatrix<std::int32_t, 2, 3> b{1, 2, 3, 4, 5, 6};
+  constexpr auto product = b * b.Transpose();
+  static_assert(product(0, 0) == 14 && product(0, 1) == 32 &&
+                    product(1, 1) == 77,
+                "fixed-size product");
+  static_assert((b + b - b * 2)(1, 2) == 0, "element-wise operators");
+  constexpr S21FixedMatrix<std::int32_t, 5, 5> c{2, 1, 0, 0, 0, 1, 2, 1, 0, 0,
+                                                 0, 1, 2, 1, 0, 0, 0, 1, 2, 1,
+                                                 0, 0, 0, 1, 2};
+  static_assert(c.Determinant() == 6, "exact integer elimination");
+}
+
+TEST(S21FixedMatrixTest, IntegerDeterminantIsExact) {
+  using Int2 = S21FixedMatrix<std::int32_t, 2, 2>;
+  using Int4 = S21FixedMatrix<std::int32_t, 4, 4>;
+  using Int5 = S21FixedMatrix<std::int32_t, 5, 5>;
+  static_assert(!noexcept(Int2{}.Determinant()), "integers can overflow");
+  static_assert(noexcept(S21Matrix2{}.Determinant()), "floats do not");
+  static_assert(Int2{46340, 0, 0, 46340}.Determinant() == 2147395600,
+                "largest square that fits");
+  EXPECT_THROW(Int2({50000, 0, 0, 50000}).Determinant(), std::overflow_error);
+  EXPECT_THROW(Int2({50000, 0, 0, 50000}).CalcComplements().Determinant(),
+               std::overflow_error);
+  EXPECT_EQ(Int2({2, 3, 5, 7}).Determinant(), -1);
+  Int5 diagonal;
+  for (int i = 0; i < 5; i++) diagonal(i, i) = 50000;
+  EXPECT_THROW(diagonal.Determinant(), std::overflow_error);
+  EXPECT_THROW(diagonal.CalcComplements(), std::overflow_error);
+  // Same results as the dynamic integer matrix.
+  Int4 a;
+  S21IntMatrix dynamic(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      a(i, j) = dynamic(i, j) = (i * 7 + j * 13) % 9 - 4 + (i == j) * 30;
+    }
+  }
+  EXPECT_EQ(a.Determinant(), dynamic.Determinant());
+  EXPECT_TRUE(static_cast<S21IntMatrix>(a.CalcComplements()) ==
+              dynamic.CalcComplements());
+}
+
+template <int N>
+static void ExpectFixedMatchesDynamic() {
+  S21Matrix dynamic = FillPattern(N, N, N);
+  for (int i = 0; i < N; i++) dynamic(i, i) += 3.0;
+  S21FixedSquare<N> fixed(dynamic);
+  EXPECT_NEAR(fixed.Determinant(), dynamic.Determinant(), 1e-9);
+  EXPECT_TRUE(static_cast<S21Matrix>(fixed.InverseMatrix()) ==
+              dynamic.InverseMatrix());
+  EXPECT_TRUE(static_cast<S21Matrix>(fixed.CalcComplements()) ==
+              dynamic.CalcComplements());
+  EXPECT_TRUE(static_cast<S21Matrix>(fixed * fixed) == dynamic * dynamic);
+}
+
+TEST(S21FixedMatrixTest, MatchesDynamicMatrix) {
+  ExpectFixedMatchesDynamic<2>();
+  ExpectFixedMatchesDynamic<3>();
+  ExpectFixedMatchesDynamic<4>();
+  ExpectFixedMatchesDynamic<5>();
+  ExpectFixedMatchesDynamic<8>();
+  EXPECT_THROW(S21Matrix3(S21Matrix(3, 4)), std::runtime_error);
+  EXPECT_THROW(S21Matrix2{}.InverseMatrix(), std::logic_error);
+  EXPECT_THROW(S21FixedSquare<6>{}.InverseMatrix(), std::logic_error);
+}
+
+// Forwards to new_delete_resource and counts the calls.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  int allocations = 0;
+  int deallocations = 0;
+
+ private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    allocations++;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override {
+    deallocations++;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+TEST(S21ArenaTest, SteadyStateLoopDoesNotAllocate) {
+  CountingResource upstream, fallback;
+  s21::Arena arena(1024, &upstream);
+  S21Matrix x = FillPattern(6, 6, 1), y = FillPattern(6, 6, 2);
+  for (int i = 0; i < 6; i++) x(i, i) = y(i, i) = 4.0;
+  S21Matrix expected = x * y;
+  std::pmr::memory_resource *previous =
+      std::pmr::set_default_resource(&fallback);
+  for (int request = 0; request < 5; request++) {
+    if (request == 2) upstream.allocations = fallback.allocations = 0;
+    S21Matrix a(x.View(), &arena);
+    S21Matrix b(y.View(), &arena);
+    S21Matrix c = a * b;
+    c = c + a - b;
+    c -= a - b;
+    EXPECT_EQ(c.GetResource(), &arena);
+    EXPECT_TRUE(c == expected);
+    EXPECT_TRUE(c.InverseMatrix().Transpose() * c.Transpose() ==
+                c.InverseMatrix() * c);
+    EXPECT_NE(c.Determinant(), 0.0);
+    arena.Reset();
+  }
+  std::pmr::set_default_resource(previous);
+  EXPECT_EQ(upstream.allocations, 0);
+  EXPECT_EQ(fallback.allocations, 0);
+  EXPECT_EQ(arena.Used(), 0u);
+  EXPECT_GT(arena.Capacity(), 1024u);
+}
+
+TEST(S21ArenaTest, ResourcesFollowPmrRules) {
+  s21::Arena arena;
+  S21Matrix a(3, 3, &arena);
+  a(1, 2) = 5;
+  S21Matrix copy = a;
+  EXPECT_EQ(copy.GetResource(), std::pmr::get_default_resource());
+  S21Matrix moved = std::move(a);
+  EXPECT_EQ(moved.GetResource(), &arena);
+  copy = std::move(moved);
+  EXPECT_EQ(copy.GetResource(), std::pmr::get_default_resource());
+  EXPECT_EQ(copy(1, 2), 5);
+  S21Matrix in_arena(&arena);
+  in_arena = copy;
+  EXPECT_EQ(in_arena.GetResource(), &arena);
+  EXPECT_TRUE(in_arena == copy);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(in_arena.Data()) % 64, 0u);
+}
+
+TEST(S21MatrixBatchTest, MatchesPerMatrixResults) {
+  const int count = 37;
+  for (int n : {3, 7, 16}) {
+    S21MatrixBatch a(count, n, n), b(count, n, n);
+    std::vector<S21Matrix> as, bs;
+    for (int m = 0; m < count; m++) {
+      as.push_back(FillPattern(n, n, m));
+      bs.push_back(FillPattern(n, n, m + 5));
+      for (int i = 0; i < n; i++) as.back()(i, i) += m % 3 ? 2.0 : -2.0;
+      a.Set(m, as.back());
+      b.Set(m, bs.back());
+    }
+    const s21::Isa detected = s21::DetectIsa();
+    for (s21::Isa isa : {s21::Isa::kScalar, s21::Isa::kAvx2,
+                         s21::Isa::kAvx512}) {
+      if (!s21::SetIsa(isa)) continue;
+      S21MatrixBatch product = a;
+      product.MulMatrix(b);
+      S21MatrixBatch transposed = a.Transpose();
+      S21MatrixBatch inverse = a.InverseMatrix();
+      std::vector<double> dets = a.Determinant();
+      ASSERT_EQ(dets.size(), static_cast<std::size_t>(count));
+      for (int m = 0; m < count; m++) {
+        EXPECT_TRUE(product.Get(m) == as[m] * bs[m]);
+        EXPECT_TRUE(transposed.Get(m) == as[m].Transpose());
+        EXPECT_TRUE(inverse.Get(m) == as[m].InverseMatrix());
+        EXPECT_NEAR(dets[m], as[m].Determinant(),
+                    1e-9 * std::max(1.0, std::abs(dets[m])));
+      }
+    }
+    s21::SetIsa(detected);
+  }
+}
+
+TEST(S21MatrixBatchTest, SingularMemberAndShapes) {
+  S21FloatMatrixBatch batch(20, 2, 2);
+  for (int m = 0; m < 20; m++) {
+    batch(m, 0, 0) = batch(m, 1, 1) = 1.0f + m;
+  }
+  EXPECT_FLOAT_EQ(batch.Determinant()[19], 400.0f);
+  batch(19, 1, 1) = 0.0f;
+  EXPECT_EQ(batch.Determinant()[19], 0.0f);
+  EXPECT_THROW(batch.InverseMatrix(), std::logic_error);
+  S21FloatMatrixBatch wide(20, 2, 3);
+  EXPECT_THROW(wide.Determinant(), std::invalid_argument);
+  EXPECT_THROW(wide.MulMatrix(wide), std::runtime_error);
+  EXPECT_THROW(batch(20, 0, 0), std::out_of_range);
+}
+
+// About a quarter of the elements nonzero, in an irregular pattern.
+static S21Matrix SparsePattern(int rows, int cols, int seed) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      if ((i * 31 + j * 17 + seed) % 4 == 0) m(i, j) = (i + j) % 5 + 1.0;
+    }
+  }
+  return m;
+}
+
+TEST(S21SparseMatrixTest, ConversionsAndAccess) {
+  S21Matrix dense = SparsePattern(9, 7, 1);
+  int nonzeros = 0;
+  for (int i = 0; i < 9; i++) {
+    for (int j = 0; j < 7; j++) nonzeros += dense(i, j) != 0.0;
+  }
+  for (s21::SparseFormat format :
+       {s21::SparseFormat::kCsr, s21::SparseFormat::kCsc}) {
+    S21SparseMatrix sparse(dense, format);
+    EXPECT_EQ(sparse.Format(), format);
+    EXPECT_EQ(sparse.NonZeros(), nonzeros);
+    EXPECT_EQ(sparse.Offsets()[format == s21::SparseFormat::kCsr ? 9 : 7],
+              nonzeros);
+    EXPECT_TRUE(sparse.ToDense() == dense);
+    for (int i = 0; i < 9; i++) {
+      for (int j = 0; j < 7; j++) EXPECT_EQ(sparse(i, j), dense(i, j));
+    }
+    S21SparseMatrix transposed = sparse.Transpose();
+    EXPECT_EQ(transposed.Format(), format);
+    EXPECT_TRUE(transposed.ToDense() == dense.Transpose());
+    S21SparseMatrix other = sparse.Convert(s21::SparseFormat::kCsc);
+    EXPECT_EQ(other.Format(), s21::SparseFormat::kCsc);
+    EXPECT_TRUE(other.ToDense() == dense);
+    EXPECT_THROW(sparse(9, 0), std::out_of_range);
+  }
+
+  S21SparseMatrix triplets(3, 4, {{2, 1, 1.5}, {0, 3, 2.0}, {2, 1, 0.5}},
+                           s21::SparseFormat::kCsc);
+  EXPECT_EQ(triplets.NonZeros(), 2);
+  EXPECT_EQ(triplets(2, 1), 2.0);
+  EXPECT_EQ(triplets(0, 3), 2.0);
+  EXPECT_EQ(triplets(1, 1), 0.0);
+  EXPECT_THROW(S21SparseMatrix(3, 4, {{3, 0, 1.0}}), std::out_of_range);
+  EXPECT_THROW(S21SparseMatrix(0, 4), std::invalid_argument);
+  S21SparseMatrix moved(std::move(triplets));
+  EXPECT_EQ(triplets.GetRows(), 0);
+  EXPECT_THROW(triplets.ToDense(), std::runtime_error);
+  EXPECT_EQ(moved(2, 1), 2.0);
+}
+
+TEST(S21SparseMatrixTest, ProductsAndSumsMatchDense) {
+  const int threads = s21::ThreadCount();
+  S21Matrix a = SparsePattern(600, 500, 1);
+  S21Matrix b = SparsePattern(500, 300, 2);
+  S21Matrix c = FillPattern(600, 500, 3);
+  S21Matrix sum = a + c;
+  // Four threads take the parallel counting sort, the column-blocked and
+  // partial-result CSC products; one thread the sequential paths.
+  for (int count : {1, 4}) {
+    s21::SetThreadCount(count);
+    for (s21::SparseFormat format :
+         {s21::SparseFormat::kCsr, s21::SparseFormat::kCsc}) {
+      S21SparseMatrix sa(a, format);
+      EXPECT_TRUE(sa.Transpose().ToDense() == a.Transpose());
+      for (int n : {1, 100, 300}) {
+        S21Matrix right(b.View().Block(0, 0, 500, n));
+        EXPECT_TRUE(sa * right == a * right);
+      }
+      std::vector<double> x(500);
+      for (int j = 0; j < 500; j++) x[j] = j % 7 - 3.0;
+      std::vector<double> y = sa.MulVector(x);
+      S21Matrix expected = a * S21Matrix(s21::ConstView(x.data(), 500, 1, 1));
+      for (int i = 0; i < 600; i++) EXPECT_EQ(y[i], expected(i, 0));
+
+      for (s21::SparseFormat other :
+           {s21::SparseFormat::kCsr, s21::SparseFormat::kCsc}) {
+        S21SparseMatrix product = sa * S21SparseMatrix(b, other);
+        EXPECT_EQ(product.Format(), format);
+        EXPECT_TRUE(product.ToDense() == a * b);
+      }
+      EXPECT_TRUE(sa + c == sum);
+      EXPECT_TRUE(c + sa == sum);
+      EXPECT_THROW(sa * a, std::runtime_error);
+      EXPECT_THROW(sa.AddTo(b), std::runtime_error);
+    }
+  }
+  s21::SetThreadCount(threads);
+}
+
+TEST(S21MatrixFileTest, WriteMapAndLoad) {
+  const std::string path = testing::TempDir() + "s21_matrix_test.bin";
+  S21Matrix m = FillPattern(37, 11, 4);
+  for (s21::WriteMode mode : {s21::WriteMode::kBuffered,
+                              s21::WriteMode::kDirect}) {
+    s21::WriteMatrix(path, m, mode);
+    s21::MappedMatrix<double> mapped(path, true);
+    EXPECT_EQ(mapped.GetRows(), 37);
+    EXPECT_EQ(mapped.GetCols(), 11);
+    EXPECT_EQ(mapped.Stride(), m.Stride());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.Data()) % 64, 0u);
+    EXPECT_TRUE(m.EqMatrix(mapped.View()));
+    s21::MappedMatrix<double> moved(std::move(mapped));
+    EXPECT_EQ(mapped.Data(), nullptr);
+    EXPECT_EQ(moved.View()(3, 5), m(3, 5));
+    EXPECT_TRUE(s21::LoadMatrix<double>(path) == m);
+  }
+
+  S21ComplexMatrix c(2, 3);
+  c(1, 2) = {1.5, -2.0};
+  s21::WriteMatrix(path, c, s21::WriteMode::kDirect);
+  EXPECT_EQ(s21::LoadMatrix<std::complex<double>>(path, true)(1, 2),
+            std::complex<double>(1.5, -2.0));
+  EXPECT_THROW(s21::MappedMatrix<double>{path}, std::runtime_error);
+  std::remove(path.c_str());
+  EXPECT_THROW(s21::MappedMatrix<double>{path}, std::system_error);
+  EXPECT_THROW(s21::WriteMatrix(path, S21Matrix()), std::runtime_error);
+}
+
+TEST(S21MatrixFileTest, DetectsCorruption) {
+  const std::string path = testing::TempDir() + "s21_matrix_corrupt.bin";
+  s21::WriteMatrix(path, FillPattern(8, 8, 1));
+  // Flip one payload byte: the header still checks out, the checksum not.
+  std::FILE *file = std::fopen(path.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  std::fseek(file, sizeof(s21::MatrixFileHeader) + 100, SEEK_SET);
+  std::fputc(0x5a, file);
+  std::fclose(file);
+  EXPECT_NO_THROW(s21::MappedMatrix<double>{path});
+  EXPECT_THROW(s21::MappedMatrix<double>(path, true), std::runtime_error);
+  // A shape whose byte count wraps to 64: 8 * rows * stride = 2^64 + 64.
+  s21::MatrixFileHeader header;
+  file = std::fopen(path.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  ASSERT_EQ(std::fread(&header, sizeof(header), 1, file), 1u);
+  const s21::MatrixFileHeader original = header;
+  header.rows = 2147352580;
+  header.cols = 1;
+  header.stride = 1073807362;
+  header.payload_bytes = 64;
+  std::rewind(file);
+  std::fwrite(&header, sizeof(header), 1, file);
+  std::fflush(file);
+  EXPECT_THROW(s21::MappedMatrix<double>{path}, std::runtime_error);
+  std::rewind(file);
+  std::fwrite(&original, sizeof(original), 1, file);
+  std::fclose(file);
+  // Truncated payload.
+  ASSERT_EQ(truncate(path.c_str(), 200), 0);
+  EXPECT_THROW(s21::MappedMatrix<double>{path}, std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(S21MatrixFileTest, OutOfCoreProduct) {
+  const std::string dir = testing::TempDir();
+  const std::string a_path = dir + "s21_ooc_a.bin";
+  const std::string b_path = dir + "s21_ooc_b.bin";
+  const std::string c_path = dir + "s21_ooc_c.bin";
+  S21Matrix a = FillPattern(70, 45, 1), b = FillPattern(45, 37, 2);
+  s21::WriteMatrix(a_path, a);
+  s21::WriteMatrix(b_path, b);
+  // 16 x 16 x 16 tiles: edge tiles on every side and three depth steps.
+  s21::MultiplyMatrixFiles<double>(a_path, b_path, c_path,
+                                   6 * 16 * 16 * sizeof(double));
+  EXPECT_TRUE(s21::LoadMatrix<double>(c_path, true).EqMatrix(a * b));
+  // One tile holding everything.
+  s21::MultiplyMatrixFiles<double>(a_path, b_path, c_path, 1 << 20);
+  EXPECT_TRUE(s21::LoadMatrix<double>(c_path, true).EqMatrix(a * b));
+  EXPECT_THROW(s21::MultiplyMatrixFiles<double>(a_path, b_path, c_path, 40),
+               std::invalid_argument);
+  EXPECT_THROW(s21::MultiplyMatrixFiles<double>(b_path, b_path, c_path, 4096),
+               std::runtime_error);
+  EXPECT_THROW(s21::MultiplyMatrixFiles<float>(a_path, b_path, c_path, 4096),
+               std::runtime_error);
+  for (const std::string &path : {a_path, b_path, c_path}) {
+    std::remove(path.c_str());
+  }
+}
+
+static void WriteTextFile(const std::string &path, const std::string &text) {
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  std::fwrite(text.data(), 1, text.size(), file);
+  std::fclose(file);
+}
+
+static std::string ParseError(const std::string &path) {
+  try {
+    s21::ReadCsv<double>(path);
+  } catch (const std::runtime_error &e) {
+    return e.what();
+  }
+  return "";
+}
+
+TEST(S21MatrixTextTest, CsvRoundTrip) {
+  const std::string path = testing::TempDir() + "s21_matrix_test.csv";
+  S21Matrix m = FillPattern(300, 23, 5);
+  m(7, 3) = 0.1;
+  m(8, 4) = -1e-300;
+  s21::WriteCsv(path, m);
+  EXPECT_TRUE(s21::ReadCsv<double>(path) == m);
+  s21::WriteCsv(path, m, ';');
+  EXPECT_TRUE(s21::ReadCsv<double>(path, ';') == m);
+
+  WriteTextFile(path, " 1,\t+2.5 ,-3\r\n4 , 5,6e1\r\n\r\n");
+  S21Matrix read = s21::ReadCsv<double>(path);
+  ASSERT_EQ(read.GetRows(), 2);
+  ASSERT_EQ(read.GetCols(), 3);
+  EXPECT_EQ(read(0, 1), 2.5);
+  EXPECT_EQ(read(1, 2), 60.0);
+  WriteTextFile(path, "1 2\n3 4\n");
+  EXPECT_EQ(s21::ReadCsv<std::int32_t>(path, ' ')(1, 0), 3);
+
+  WriteTextFile(path, "1,2\n3,x\n");
+  EXPECT_EQ(ParseError(path), path + ":2: expected a number");
+  WriteTextFile(path, "1,2\n3,4\n5\n");
+  EXPECT_EQ(ParseError(path), path + ":3: too few cells");
+  WriteTextFile(path, "1,2\n3,4,5\n");
+  EXPECT_EQ(ParseError(path), path + ":2: too many cells");
+  WriteTextFile(path, "\n");
+  EXPECT_THROW(s21::ReadCsv<double>(path), std::runtime_error);
+  std::remove(path.c_str());
+  EXPECT_THROW(s21::ReadCsv<double>(path), std::system_error);
+}
+
+TEST(S21MatrixTextTest, MatrixMarket) {
+  const std::string path = testing::TempDir() + "s21_matrix_test.mtx";
+  S21Matrix dense = SparsePattern(40, 30, 3);
+  s21::WriteMatrixMarket(path, dense);
+  EXPECT_TRUE(s21::ReadMatrixMarket<double>(path) == dense);
+  EXPECT_TRUE(s21::ReadMatrixMarketSparse<double>(path).ToDense() == dense);
+  for (s21::SparseFormat format :
+       {s21::SparseFormat::kCsr, s21::SparseFormat::kCsc}) {
+    s21::WriteMatrixMarket(path, S21SparseMatrix(dense, format));
+    S21SparseMatrix read = s21::ReadMatrixMarketSparse<double>(path);
+    EXPECT_EQ(read.NonZeros(), S21SparseMatrix(dense).NonZeros());
+    EXPECT_TRUE(read.ToDense() == dense);
+    EXPECT_TRUE(s21::ReadMatrixMarket<double>(path) == dense);
+  }
+
+  WriteTextFile(path,
+                "%%MatrixMarket matrix coordinate real symmetric\n"
+                "% comment\n"
+                "\n"
+                "3 3 3\n"
+                "1 1 2.0\n"
+                "3 1 -1\n"
+                "2 2 4\n");
+  S21Matrix symmetric = s21::ReadMatrixMarket<double>(path);
+  EXPECT_EQ(symmetric(0, 2), -1.0);
+  EXPECT_EQ(symmetric(2, 0), -1.0);
+  EXPECT_EQ(symmetric(1, 1), 4.0);
+  WriteTextFile(path,
+                "%%MatrixMarket matrix coordinate pattern general\n"
+                "2 3 2\n"
+                "1 3\n"
+                "2 1\n");
+  S21IntSparseMatrix pattern = s21::ReadMatrixMarketSparse<std::int32_t>(
+      path, s21::SparseFormat::kCsc);
+  EXPECT_EQ(pattern(0, 2), 1);
+  EXPECT_EQ(pattern(1, 0), 1);
+  EXPECT_EQ(pattern.NonZeros(), 2);
+  WriteTextFile(path,
+                "%%MatrixMarket matrix array real skew-symmetric\n"
+                "2 2\n"
+                "3\n");
+  S21Matrix skew = s21::ReadMatrixMarket<double>(path);
+  EXPECT_EQ(skew(1, 0), 3.0);
+  EXPECT_EQ(skew(0, 1), -3.0);
+
+  WriteTextFile(path,
+                "%%MatrixMarket matrix coordinate real general\n"
+                "2 2 2\n"
+                "1 1 1\n"
+                "3 1 1\n");
+  EXPECT_THROW(s21::ReadMatrixMarket<double>(path), std::runtime_error);
+  WriteTextFile(path,
+                "%%MatrixMarket matrix coordinate complex general\n"
+                "1 1 0\n");
+  EXPECT_THROW(s21::ReadMatrixMarket<double>(path), std::runtime_error);
+  WriteTextFile(path,
+                "%%MatrixMarket matrix array real general\n"
+                "2 2\n"
+                "1\n");
+  EXPECT_THROW(s21::ReadMatrixMarket<double>(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(S21MatrixTextTest, PrintMatrix) {
+  S21Matrix m(2, 2);
+  m(0, 0) = 0.1;
+  m(0, 1) = -2;
+  m(1, 1) = 1e300;
+  testing::internal::CaptureStdout();
+  m.PrintMatrix();
+  S21ComplexMatrix c(1, 1);
+  c(0, 0) = {1.5, -1};
+  c.PrintMatrix();
+  EXPECT_EQ(testing::internal::GetCapturedStdout(),
+            "0.1 -2\n0 1e+300\n(1.5,-1)\n");
 }
 
 int main() {